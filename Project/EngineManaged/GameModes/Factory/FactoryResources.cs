@@ -133,6 +133,9 @@ public static class FactoryResources
 
 
         TexTree01 = NativeMethods.Resources_LoadTexture("tree01", "Textures/Factory/Flora/tree01.png");
+
+        // Pack everything loaded above into shared atlas pages so the world batches into a few draws.
+        NativeMethods.Resources_BuildTextureAtlas();
     }
 
     public static IntPtr GetTerrainTexture(SlimeCore.GameModes.Factory.World.FactoryTerrain type)
@@ -1,4 +1,5 @@
 using EngineManaged.Numeric;
+using EngineManaged.Scene;
 using MessagePack;
 using SlimeCore.Source.Common;
 using SlimeCore.Source.World.Grid;
@@ -31,14 +32,70 @@ public class FactoryWorld : GridSystem<FactoryGame, FactoryTerrain, FactoryTileO
 		Zoom = zoom;
 	}
 
+	// Terrain is drawn natively: the tilemap keeps tile types and autotile masks on the GPU and draws
+	// one quad per visible 64x64 chunk, so the cost does not grow with the world size
+	[IgnoreMember]
+	private TilemapComponent? _tilemap;
+	[IgnoreMember]
+	private ulong _tilemapEntity;
+
+	private const float ImpostorPixelsPerTile = 4.0f;
+
 	public void Initialize(int viewWidth, int viewHeight)
 	{
-		// No initialization needed for batch rendering
+		if (_tilemapEntity != 0 && NativeMethods.Entity_IsAlive(_tilemapEntity)) return;
+
+		var entity = EngineManaged.Scene.Entity.Create();
+		entity.AddComponent<TransformComponent>();
+		_tilemapEntity = entity.Id;
+
+		_tilemap = entity.AddTilemap(Width(), Height());
+		foreach (var terrain in Enum.GetValues<FactoryTerrain>())
+		{
+			_tilemap.SetTileType((int)terrain, FactoryResources.GetTerrainTexture(terrain));
+		}
+
+		SyncAllTiles();
+
+		// Once tiles shrink to a few pixels the ground is drawn from cached per-chunk impostors,
+		// re-baked only when a chunk changes, so zooming out no longer costs a draw per tilemap chunk
+		// Trees and actors are dynamic sprites, so they still draw live over the impostors
+		NativeMethods.Scene_SetImpostorThreshold(ImpostorPixelsPerTile);
 	}
 
 	public void Destroy()
 	{
-		// No destruction needed
+		if (_tilemapEntity != 0)
+		{
+			NativeMethods.Entity_Destroy(_tilemapEntity);
+			_tilemapEntity = 0;
+			_tilemap = null;
+		}
+	}
+
+	private void SyncTile(FactoryTile? tile)
+	{
+		if (tile == null) return;
+		_tilemap?.SetTile(tile.PositionX, tile.PositionY, (int)tile.Type, tile.Bitmask);
+	}
+
+	// Pushes every tile in one interop call (after generation or loading)
+	private void SyncAllTiles()
+	{
+		if (_tilemap == null) return;
+
+		int w = Width();
+		int h = Height();
+		var types = new byte[w * h];
+		var masks = new byte[w * h];
+		foreach (var (pos, tile) in Grid)
+		{
+			if (pos.X < 0 || pos.Y < 0 || pos.X >= w || pos.Y >= h) continue;
+			types[pos.Y * w + pos.X] = (byte)tile.Type;
+			masks[pos.Y * w + pos.X] = (byte)tile.Bitmask;
+		}
+
+		_tilemap.SetTiles(0, 0, w, h, types, masks);
 	}
 
 
@@ -61,6 +118,8 @@ public class FactoryWorld : GridSystem<FactoryGame, FactoryTerrain, FactoryTileO
 				tile.Bitmask = mask;
 			}
 		}
+
+		SyncAllTiles();
 	}
 
 	public override FactoryTile? Set(Vec2i position, Action<FactoryTileOptions> config)
@@ -70,6 +129,7 @@ public class FactoryWorld : GridSystem<FactoryGame, FactoryTerrain, FactoryTileO
 		{
 			Register(changed);
 		}
+		SyncTile(changed);
 		return changed;
 	}
 
@@ -100,6 +160,7 @@ public class FactoryWorld : GridSystem<FactoryGame, FactoryTerrain, FactoryTileO
 		// if (IsSameTerrain(pos, Direction.North) && IsSameTerrain(pos, Direction.East) && IsSameTerrain(pos + new Vec2i(1, 1))) ...
 
 		tile.Bitmask = mask;
+		SyncTile(tile);
 
 		// Update Conveyor Logic if applicable
 		if (tile.BuildingId == "conveyor")
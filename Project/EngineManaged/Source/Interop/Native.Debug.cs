@@ -0,0 +1,38 @@
+using EngineManaged.Rendering;
+using System.Runtime.InteropServices;
+[System.Diagnostics.CodeAnalysis.SuppressMessage(
+    "Interoperability", "CA2101:Specify marshaling for P/Invoke string arguments",
+    Justification = "UTF-8 via MarshalAs(UnmanagedType.LPUTF8Str) is explicit")]
+internal static partial class NativeMethods
+{
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Line(float x0, float y0, float x1, float y1, float r, float g, float b, float a, float duration);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Arrow(float x0, float y0, float x1, float y1, float headSize, float r, float g, float b, float a, float duration);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Text(float x, float y, [MarshalAs(UnmanagedType.LPUTF8Str)] string text, float height, float r, float g, float b, float a, float duration);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Lines(in DebugLine lines, int count, float duration);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Arrows(in DebugLine arrows, int count, float headSize, float duration);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Rects(in DebugRect rects, int count, [MarshalAs(UnmanagedType.U1)] bool filled, float duration);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Circles(in DebugCircle circles, int count, [MarshalAs(UnmanagedType.U1)] bool filled, float duration);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_Clear();
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void DebugDraw_SetEnabled([MarshalAs(UnmanagedType.U1)] bool enabled);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    [return: MarshalAs(UnmanagedType.U1)]
+    internal static extern bool DebugDraw_IsEnabled();
+}
@@ -67,6 +67,15 @@ internal static partial class NativeMethods
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern bool Entity_GetRender(ulong id);
 
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Entity_SetStatic(ulong id, bool value);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern bool Entity_GetStatic(ulong id);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Entity_SetNineSlice(ulong id, float left, float top, float right, float bottom, float unitsPerTexel);
+
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern void Entity_SetFrame(ulong id, int frame);
 
@@ -179,6 +188,13 @@ internal static partial class NativeMethods
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern void Entity_RemoveComponent_AudioSource(ulong id);
 
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Entity_AddComponent_Tilemap(ulong id, int width, int height, float tileSize);
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern bool Entity_HasComponent_Tilemap(ulong id);
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Entity_RemoveComponent_Tilemap(ulong id);
+
     // -----------------------------
     // Physics Accessors
     // -----------------------------
@@ -12,6 +12,28 @@ internal static partial class NativeMethods
         public IntPtr TexturePtr;
     }
 
+    [StructLayout(LayoutKind.Sequential)]
+    public struct BatchRecord
+    {
+        public uint Reason;
+        public uint Pipeline;
+        public uint DrawCalls;
+        public uint QuadCount;
+        public uint TextureCount;
+    }
+
+    [StructLayout(LayoutKind.Sequential)]
+    public struct DynamicResolutionStats
+    {
+        public float Scale;
+        public uint Width;
+        public uint Height;
+        public float GpuTimeMs;
+        public float SmoothedGpuTimeMs;
+        [MarshalAs(UnmanagedType.U1)]
+        public bool TimingAvailable;
+    }
+
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern void Renderer_DrawBatch([In] BatchQuad[] quads, int count);
 
@@ -26,4 +48,26 @@ internal static partial class NativeMethods
 
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern void Renderer_DisableScissor();
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Renderer_PushClipRect(float x, float y, float w, float h);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Renderer_PopClipRect();
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern int Renderer_GetBatchReportCount();
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern int Renderer_GetBatchReport([Out] BatchRecord[] records, int maxCount);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    [return: MarshalAs(UnmanagedType.U1)]
+    internal static extern bool Renderer_DumpBatchReportJson([MarshalAs(UnmanagedType.LPUTF8Str)] string path);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Renderer_SetDynamicResolution([MarshalAs(UnmanagedType.U1)] bool enabled, float minScale, float maxScale, float targetGpuMs);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Renderer_GetDynamicResolutionStats(out DynamicResolutionStats stats);
 }
@@ -24,6 +24,14 @@ internal static partial class NativeMethods
     [DllImport(LibraryName, CallingConvention = CallConvention)]
     internal static extern IntPtr Resources_GetTexture([MarshalAs(UnmanagedType.LPUTF8Str)] string name);
 
+    /// <summary>
+    /// Packs every loaded texture into shared atlas pages. Existing texture handles stay valid.
+    /// Call after loading a set of sprites; textures loaded afterwards stay standalone until the next build.
+    /// Returns the number of textures placed in the atlas.
+    /// </summary>
+    [DllImport(LibraryName, CallingConvention = CallConvention)]
+    internal static extern uint Resources_BuildTextureAtlas();
+
     // -------------------------------------------------------------------------
     // FONTS
     // -------------------------------------------------------------------------
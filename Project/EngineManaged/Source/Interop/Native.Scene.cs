@@ -25,4 +25,7 @@ internal static partial class NativeMethods
 
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern void Scene_SetGravity(float x, float y);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Scene_SetImpostorThreshold(float pixelsPerUnit);
 }
@@ -0,0 +1,42 @@
+using EngineManaged.Rendering;
+using System;
+using System.Runtime.InteropServices;
+
+internal static partial class NativeMethods
+{
+    // -----------------------------
+    // Tilemap (entity must have a Tilemap component)
+    // -----------------------------
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_SetTileType(ulong id, int type, IntPtr texPtr, int frameCount, float frameRate);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_SetTile(ulong id, int x, int y, int type, int mask);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern int Tilemap_GetTile(ulong id, int x, int y);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_SetTiles(ulong id, int x, int y, int width, int height, byte[] types, byte[]? masks);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_Fill(ulong id, int type);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_RecalculateMasks(ulong id);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_SetVisible(ulong id, bool value);
+
+    // -----------------------------
+    // Minimap (one texel per tile, updated from tile edits)
+    // -----------------------------
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern IntPtr Tilemap_EnableMinimap(ulong id);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_SetMinimapColor(ulong id, int type, float r, float g, float b, float a);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void Tilemap_SetMinimapMarkers(ulong id, in MinimapMarker markers, int count);
+}
@@ -56,6 +56,18 @@ internal static partial class NativeMethods
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern void UI_SetClipRect(ulong id, float x, float y, float w, float h);
 
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void UI_SetMinimap(ulong id, ulong tilemapEntity);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void UI_SetNineSlice(ulong id, float left, float top, float right, float bottom);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void UI_SetCornerRadius(ulong id, float radius);
+
+    [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+    internal static extern void UI_SetBorder(ulong id, float width, float r, float g, float b, float a);
+
     [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
     internal static extern void UI_GetTextSize(ulong id, out float width, out float height);
 
@@ -0,0 +1,106 @@
+using System;
+
+namespace EngineManaged.Rendering;
+
+/// <summary>
+/// What closed a batch. Mirrors Renderer::BatchBreak.
+/// </summary>
+public enum BatchBreak : uint
+{
+    None,
+    TextureSlots,
+    PipelineSwitch,
+    VertexBufferFull,
+    EndScene,
+    StaticBatch,
+    Tilemap,
+    Mesh,
+    RenderTarget,
+    Particles
+}
+
+/// <summary>
+/// Which pipeline drew a batch. Mirrors Renderer::BatchPipeline.
+/// </summary>
+public enum BatchPipeline : uint
+{
+    Quad,
+    Text,
+    Static,
+    Tilemap,
+    Mesh,
+    Particles,
+    Opaque,
+    Translucent
+}
+
+/// <summary>
+/// One submitted batch of the last frame.
+/// </summary>
+public readonly struct BatchInfo
+{
+    public BatchBreak Reason { get; init; }
+    public BatchPipeline Pipeline { get; init; }
+    public int DrawCalls { get; init; }
+    public int QuadCount { get; init; }
+    public int TextureCount { get; init; }
+}
+
+public static class BatchReport
+{
+    private static NativeMethods.BatchRecord[] s_Buffer = Array.Empty<NativeMethods.BatchRecord>();
+
+    /// <summary>
+    /// Number of batches submitted in the last completed frame.
+    /// </summary>
+    public static int Count => NativeMethods.Renderer_GetBatchReportCount();
+
+    /// <summary>
+    /// Batches of the last completed frame in draw order, with the reason each one was closed.
+    /// </summary>
+    public static BatchInfo[] GetLastFrame()
+    {
+        int count = NativeMethods.Renderer_GetBatchReportCount();
+        if (s_Buffer.Length < count)
+            s_Buffer = new NativeMethods.BatchRecord[count];
+
+        count = NativeMethods.Renderer_GetBatchReport(s_Buffer, s_Buffer.Length);
+
+        var result = new BatchInfo[count];
+        for (int i = 0; i < count; i++)
+        {
+            var r = s_Buffer[i];
+            result[i] = new BatchInfo
+            {
+                Reason = (BatchBreak)r.Reason,
+                Pipeline = (BatchPipeline)r.Pipeline,
+                DrawCalls = (int)r.DrawCalls,
+                QuadCount = (int)r.QuadCount,
+                TextureCount = (int)r.TextureCount
+            };
+        }
+        return result;
+    }
+
+    /// <summary>
+    /// How many batches of the last frame were closed for 'reason'.
+    /// </summary>
+    public static int CountBreaks(BatchBreak reason)
+    {
+        int n = 0;
+        foreach (var batch in GetLastFrame())
+        {
+            if (batch.Reason == reason)
+                n++;
+        }
+        return n;
+    }
+
+    /// <summary>
+    /// Writes the last frame's report to 'path' as JSON. Returns false if the file couldn't be written.
+    /// </summary>
+    public static bool DumpJson(string path)
+    {
+        return NativeMethods.Renderer_DumpBatchReportJson(path);
+    }
+}
@@ -0,0 +1,129 @@
+using EngineManaged.Numeric;
+using System;
+using System.Runtime.InteropServices;
+
+namespace EngineManaged.Rendering;
+
+[StructLayout(LayoutKind.Sequential)]
+public struct DebugLine
+{
+    public float FromX, FromY;
+    public float ToX, ToY;
+    public float R, G, B, A;
+
+    public DebugLine(Vec2 from, Vec2 to, Color color)
+    {
+        FromX = from.X; FromY = from.Y;
+        ToX = to.X; ToY = to.Y;
+        R = color.R; G = color.G; B = color.B; A = color.A;
+    }
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct DebugRect
+{
+    public float X, Y; // Center
+    public float W, H;
+    public float R, G, B, A;
+
+    public DebugRect(Vec2 center, Vec2 size, Color color)
+    {
+        X = center.X; Y = center.Y;
+        W = size.X; H = size.Y;
+        R = color.R; G = color.G; B = color.B; A = color.A;
+    }
+}
+
+[StructLayout(LayoutKind.Sequential)]
+public struct DebugCircle
+{
+    public float X, Y;
+    public float Radius;
+    public float R, G, B, A;
+
+    public DebugCircle(Vec2 center, float radius, Color color)
+    {
+        X = center.X; Y = center.Y;
+        Radius = radius;
+        R = color.R; G = color.G; B = color.B; A = color.A;
+    }
+}
+
+/// <summary>
+/// Immediate-mode debug shapes in world space, drawn over the world in one or two draw calls per frame.
+/// Shapes last for the current frame unless given a duration in seconds. Compiled out of native release builds.
+/// </summary>
+public static class DebugDraw
+{
+    /// <summary>
+    /// Runtime toggle; while disabled, submissions are ignored.
+    /// </summary>
+    public static bool Enabled
+    {
+        get => NativeMethods.DebugDraw_IsEnabled();
+        set => NativeMethods.DebugDraw_SetEnabled(value);
+    }
+
+    public static void Line(Vec2 from, Vec2 to, Color color, float duration = 0f)
+    {
+        NativeMethods.DebugDraw_Line(from.X, from.Y, to.X, to.Y, color.R, color.G, color.B, color.A, duration);
+    }
+
+    public static void Arrow(Vec2 from, Vec2 to, Color color, float headSize = 0.25f, float duration = 0f)
+    {
+        NativeMethods.DebugDraw_Arrow(from.X, from.Y, to.X, to.Y, headSize, color.R, color.G, color.B, color.A, duration);
+    }
+
+    public static void Rect(Vec2 center, Vec2 size, Color color, bool filled = false, float duration = 0f)
+    {
+        var rect = new DebugRect(center, size, color);
+        NativeMethods.DebugDraw_Rects(in rect, 1, filled, duration);
+    }
+
+    public static void Circle(Vec2 center, float radius, Color color, bool filled = false, float duration = 0f)
+    {
+        var circle = new DebugCircle(center, radius, color);
+        NativeMethods.DebugDraw_Circles(in circle, 1, filled, duration);
+    }
+
+    /// <summary>
+    /// Text tag at 'position'; 'height' is in world units.
+    /// </summary>
+    public static void Text(Vec2 position, string text, Color color, float height = 0.5f, float duration = 0f)
+    {
+        NativeMethods.DebugDraw_Text(position.X, position.Y, text, height, color.R, color.G, color.B, color.A, duration);
+    }
+
+    // ---------------------------------------------------------------------
+    // Bulk submission: one native call per span
+    // ---------------------------------------------------------------------
+
+    public static void Lines(ReadOnlySpan<DebugLine> lines, float duration = 0f)
+    {
+        if (!lines.IsEmpty)
+            NativeMethods.DebugDraw_Lines(in MemoryMarshal.GetReference(lines), lines.Length, duration);
+    }
+
+    public static void Arrows(ReadOnlySpan<DebugLine> arrows, float headSize = 0.25f, float duration = 0f)
+    {
+        if (!arrows.IsEmpty)
+            NativeMethods.DebugDraw_Arrows(in MemoryMarshal.GetReference(arrows), arrows.Length, headSize, duration);
+    }
+
+    public static void Rects(ReadOnlySpan<DebugRect> rects, bool filled = false, float duration = 0f)
+    {
+        if (!rects.IsEmpty)
+            NativeMethods.DebugDraw_Rects(in MemoryMarshal.GetReference(rects), rects.Length, filled, duration);
+    }
+
+    public static void Circles(ReadOnlySpan<DebugCircle> circles, bool filled = false, float duration = 0f)
+    {
+        if (!circles.IsEmpty)
+            NativeMethods.DebugDraw_Circles(in MemoryMarshal.GetReference(circles), circles.Length, filled, duration);
+    }
+
+    /// <summary>
+    /// Drops every pending and timed shape.
+    /// </summary>
+    public static void Clear() => NativeMethods.DebugDraw_Clear();
+}
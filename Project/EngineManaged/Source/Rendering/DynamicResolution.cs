@@ -0,0 +1,53 @@
+namespace EngineManaged.Rendering;
+
+/// <summary>
+/// Scale and timings of the last world pass. Mirrors Renderer::DynamicResolutionStats.
+/// </summary>
+public readonly struct DynamicResolutionInfo
+{
+    /// <summary>Fraction of the window's resolution the world was drawn at.</summary>
+    public float Scale { get; init; }
+    public int Width { get; init; }
+    public int Height { get; init; }
+
+    /// <summary>Latest measured GPU time of the world pass, a few frames old.</summary>
+    public float GpuTimeMs { get; init; }
+
+    /// <summary>Smoothed GPU time the scale is steered by.</summary>
+    public float SmoothedGpuTimeMs { get; init; }
+
+    /// <summary>False when the device can't time the GPU; the scale then stays fixed.</summary>
+    public bool TimingAvailable { get; init; }
+}
+
+/// <summary>
+/// Renders the world below native resolution when the GPU falls behind. The UI stays native.
+/// </summary>
+public static class DynamicResolution
+{
+    /// <summary>
+    /// Lets the world pass scale between 'minScale' and 'maxScale' (at most 1) to keep its GPU time under
+    /// 'targetGpuMs'. Disabled, the world renders at 'maxScale'.
+    /// </summary>
+    public static void Configure(bool enabled, float minScale = 0.5f, float maxScale = 1.0f, float targetGpuMs = 12.0f)
+    {
+        NativeMethods.Renderer_SetDynamicResolution(enabled, minScale, maxScale, targetGpuMs);
+    }
+
+    /// <summary>
+    /// Scale and timings of the last completed frame.
+    /// </summary>
+    public static DynamicResolutionInfo GetStats()
+    {
+        NativeMethods.Renderer_GetDynamicResolutionStats(out var s);
+        return new DynamicResolutionInfo
+        {
+            Scale = s.Scale,
+            Width = (int)s.Width,
+            Height = (int)s.Height,
+            GpuTimeMs = s.GpuTimeMs,
+            SmoothedGpuTimeMs = s.SmoothedGpuTimeMs,
+            TimingAvailable = s.TimingAvailable
+        };
+    }
+}
@@ -0,0 +1,20 @@
+using EngineManaged.Numeric;
+using System.Runtime.InteropServices;
+
+namespace EngineManaged.Rendering;
+
+// A point drawn over a tilemap minimap, see TilemapComponent.SetMinimapMarkers
+[StructLayout(LayoutKind.Sequential)]
+public struct MinimapMarker
+{
+    public float X, Y; // In tiles
+    public float R, G, B, A;
+    public float Size; // In tiles
+
+    public MinimapMarker(Vec2 position, Color color, float size = 1f)
+    {
+        X = position.X; Y = position.Y;
+        R = color.R; G = color.G; B = color.B; A = color.A;
+        Size = size;
+    }
+}
@@ -27,6 +27,16 @@ namespace EngineManaged.Rendering
         public float LifeTime;
     }
 
+    /// <summary>
+    /// Where a particle system simulates. Gpu runs everything in compute shaders and
+    /// falls back to Cpu on devices without compute or indirect draws.
+    /// </summary>
+    public enum ParticleBackend
+    {
+        Cpu,
+        Gpu
+    }
+
     public class ParticleSystem : IDisposable
     {
         private bool _isDisposed;
@@ -38,6 +48,13 @@ namespace EngineManaged.Rendering
             [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
             internal static extern IntPtr ParticleSystem_Create(uint maxParticles);
 
+            [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+            internal static extern IntPtr ParticleSystem_CreateWithBackend(uint maxParticles, [MarshalAs(UnmanagedType.U1)] bool gpu);
+
+            [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
+            [return: MarshalAs(UnmanagedType.U1)]
+            internal static extern bool ParticleSystem_IsGpu(IntPtr system);
+
             [DllImport("SlimeCore2D.exe", CallingConvention = CallingConvention.Cdecl)]
             internal static extern void ParticleSystem_Destroy(IntPtr system);
 
@@ -57,15 +74,20 @@ namespace EngineManaged.Rendering
             internal static extern void Scene_UnregisterParticleSystem(IntPtr system);
         }
 
-        public ParticleSystem(uint maxParticles = 10000)
+        public ParticleSystem(uint maxParticles = 10000, ParticleBackend backend = ParticleBackend.Cpu)
         {
-            m_NativeInstance = NativeMethods.ParticleSystem_Create(maxParticles);
+            m_NativeInstance = NativeMethods.ParticleSystem_CreateWithBackend(maxParticles, backend == ParticleBackend.Gpu);
             if (m_NativeInstance != IntPtr.Zero)
             {
                 NativeMethods.Scene_RegisterParticleSystem(m_NativeInstance);
             }
         }
 
+        /// <summary>
+        /// True when the system actually runs on the GPU (false after a fallback).
+        /// </summary>
+        public bool IsGpu => m_NativeInstance != IntPtr.Zero && NativeMethods.ParticleSystem_IsGpu(m_NativeInstance);
+
         public void Dispose()
         {
             Dispose(true);
@@ -107,6 +129,9 @@ namespace EngineManaged.Rendering
             }
         }
 
+        /// <summary>
+        /// Adds the particles to the frame being recorded. Only takes effect from a Draw callback.
+        /// </summary>
         public void OnRender()
         {
             if (m_NativeInstance != IntPtr.Zero)
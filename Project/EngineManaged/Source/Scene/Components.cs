@@ -1,4 +1,7 @@
+using EngineManaged.Numeric;
+using EngineManaged.Rendering;
 using System;
+using System.Runtime.InteropServices;
 
 namespace EngineManaged.Scene;
 
@@ -64,7 +67,18 @@ public record SpriteComponent : IComponent
         set => NativeMethods.Entity_SetRender(EntityId, value);
     }
 
+    // Baked into cached chunk geometry beneath dynamic sprites; any change rebuilds the chunk
+    public bool IsStatic
+    {
+        get => NativeMethods.Entity_GetStatic(EntityId);
+        set => NativeMethods.Entity_SetStatic(EntityId, value);
+    }
+
     public void SetTexture(uint texId, int width, int height) => NativeMethods.Entity_SetTexture(EntityId, texId, width, height);
+
+    // Keeps the texture's borders (in texels) at a fixed size while the sprite is scaled; all zero stretches it
+    public void SetNineSlice(float left, float top, float right, float bottom, float unitsPerTexel = 0.0625f) =>
+        NativeMethods.Entity_SetNineSlice(EntityId, left, top, right, bottom, unitsPerTexel);
     public IntPtr TexturePtr
     {
         get => NativeMethods.Entity_GetTexturePtr(EntityId);
@@ -97,6 +111,37 @@ public record AnimationComponent : IComponent
     public void HasAnimation(bool val) => NativeMethods.Entity_SetHasAnimation(EntityId, val);
 }
 
+public record TilemapComponent : IComponent
+{
+    public ulong EntityId { get; set; }
+
+    public bool IsVisible
+    {
+        set => NativeMethods.Tilemap_SetVisible(EntityId, value);
+    }
+
+    // 'sheet' is a 3x3 autotile sheet; animated types place 'frameCount' sheets side by side
+    public void SetTileType(int type, IntPtr sheet, int frameCount = 1, float frameRate = 0f) => NativeMethods.Tilemap_SetTileType(EntityId, type, sheet, frameCount, frameRate);
+    public void SetTile(int x, int y, int type, int mask) => NativeMethods.Tilemap_SetTile(EntityId, x, y, type, mask);
+    public int GetTile(int x, int y) => NativeMethods.Tilemap_GetTile(EntityId, x, y);
+    public void SetTiles(int x, int y, int width, int height, byte[] types, byte[]? masks = null) => NativeMethods.Tilemap_SetTiles(EntityId, x, y, width, height, types, masks);
+    public void Fill(int type) => NativeMethods.Tilemap_Fill(EntityId, type);
+    public void RecalculateMasks() => NativeMethods.Tilemap_RecalculateMasks(EntityId);
+
+    // Minimap texture, one texel per tile; types without a colour stay transparent
+    public IntPtr EnableMinimap() => NativeMethods.Tilemap_EnableMinimap(EntityId);
+    public void SetMinimapColor(int type, Color color) => NativeMethods.Tilemap_SetMinimapColor(EntityId, type, color.R, color.G, color.B, color.A);
+
+    // Markers are drawn over the minimap for the next frame only
+    public void SetMinimapMarkers(ReadOnlySpan<MinimapMarker> markers)
+    {
+        if (markers.IsEmpty)
+            NativeMethods.Tilemap_SetMinimapMarkers(EntityId, default, 0);
+        else
+            NativeMethods.Tilemap_SetMinimapMarkers(EntityId, in MemoryMarshal.GetReference(markers), markers.Length);
+    }
+}
+
 public record RigidBodyComponent : IComponent
 {
     public ulong EntityId { get; set; }
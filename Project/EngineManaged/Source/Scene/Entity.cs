@@ -59,6 +59,15 @@ public record Entity
         else throw new ArgumentException($"Component type {type.Name} is not supported.");
     }
 
+    /// <summary>
+    /// Tilemaps need their size up front, so they are added here rather than through AddComponent.
+    /// </summary>
+    public TilemapComponent AddTilemap(int width, int height, float tileSize = 1.0f)
+    {
+        NativeMethods.Entity_AddComponent_Tilemap(Id, width, height, tileSize);
+        return new TilemapComponent { EntityId = Id };
+    }
+
     public bool HasComponent<T>() where T : IComponent
     {
         var type = typeof(T);
@@ -72,6 +81,7 @@ public record Entity
         else if (type == typeof(CircleColliderComponent)) return NativeMethods.Entity_HasComponent_CircleCollider(Id);
         else if (type == typeof(CameraComponent)) return NativeMethods.Entity_HasComponent_Camera(Id);
         else if (type == typeof(AudioSourceComponent)) return NativeMethods.Entity_HasComponent_AudioSource(Id);
+        else if (type == typeof(TilemapComponent)) return NativeMethods.Entity_HasComponent_Tilemap(Id);
         else throw new ArgumentException($"Component type {type.Name} is not supported.");
     }
 
@@ -88,6 +98,7 @@ public record Entity
         else if (type == typeof(CircleColliderComponent)) NativeMethods.Entity_RemoveComponent_CircleCollider(Id);
         else if (type == typeof(CameraComponent)) NativeMethods.Entity_RemoveComponent_Camera(Id);
         else if (type == typeof(AudioSourceComponent)) NativeMethods.Entity_RemoveComponent_AudioSource(Id);
+        else if (type == typeof(TilemapComponent)) NativeMethods.Entity_RemoveComponent_Tilemap(Id);
         else throw new ArgumentException($"Component type {type.Name} is not supported.");
     }
 }
\ No newline at end of file
@@ -44,4 +44,16 @@ public readonly struct UIImage
     public void UseScreenSpace(bool val) => NativeMethods.UI_SetUseScreenSpace(Id, val);
 
     public void SetClipRect(float x, float y, float w, float h) => NativeMethods.UI_SetClipRect(Id, x, y, w, h);
+
+    // Shows the tilemap entity's minimap (and its markers) instead of the texture; 0 detaches it
+    public void SetMinimap(ulong tilemapEntity) => NativeMethods.UI_SetMinimap(Id, tilemapEntity);
+
+    // Draws the texture as a nine-slice: the borders (in texels) keep their size while the middle stretches
+    public void SetNineSlice(float left, float top, float right, float bottom) => NativeMethods.UI_SetNineSlice(Id, left, top, right, bottom);
+
+    // Rounds the corners; same units as Size
+    public void SetCornerRadius(float radius) => NativeMethods.UI_SetCornerRadius(Id, radius);
+
+    // Outlines the inside of the edge, following the corner radius; same units as Size, 0 removes it
+    public void SetBorder(float width, float r, float g, float b, float a = 1.0f) => NativeMethods.UI_SetBorder(Id, width, r, g, b, a);
 }
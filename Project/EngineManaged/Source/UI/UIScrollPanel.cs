@@ -20,8 +20,6 @@ public class UIScrollPanel : UIElement
     // IsVisible is in base
     public bool IsHovered { get; private set; }
 
-    private UIImage? _border;
-
     private float _scrollTarget;
 
     private UIScrollPanel(UIImage bg, float x, float y, float w, float h, int layer, bool useScreenSpace)
@@ -78,11 +76,6 @@ public class UIScrollPanel : UIElement
     {
         // Update background position
         Background.Position = (WorldX, WorldY);
-        if (_border.HasValue)
-        {
-             var b = _border.Value;
-             b.Position = (WorldX, WorldY);
-        }
 
         // Handle Culling
         float topY = WorldY + Height / 2;
@@ -121,11 +114,6 @@ public class UIScrollPanel : UIElement
 
         // 2. Update our visuals
         Background.Position = (WorldX, WorldY);
-        if (_border.HasValue)
-        {
-             var b = _border.Value;
-             b.Position = (WorldX, WorldY);
-        }
 
         // 3. Update Children & Cull
         float topY = WorldY + Height / 2;
@@ -260,9 +248,8 @@ public class UIScrollPanel : UIElement
     // Add SetClipRect for nested scroll panels if needed, though they manage their own children
     public void SetClipRect(float x, float y, float w, float h)
     {
-         // UIScrollPanel itself doesn't render much except bg/border
+         // UIScrollPanel itself doesn't render much except its background (which draws the border)
          Background.SetClipRect(x, y, w, h);
-         if (_border.HasValue) _border.Value.SetClipRect(x, y, w, h);
     }
 
     public void EnableButtons(bool enabled)
@@ -276,11 +263,6 @@ public class UIScrollPanel : UIElement
     public void SetAlpha(float alpha)
     {
         Background.Alpha(alpha);
-        if (_border.HasValue)
-        {
-            var b = _border.Value;
-            b.Alpha(alpha);
-        }
         foreach (var child in _children)
         {
             // Try to set alpha on children if they support it
@@ -294,33 +276,16 @@ public class UIScrollPanel : UIElement
     
     // ... Border and other methods ...
 
+    // The background grows by the thickness and outlines itself, so the panel stays one element
     public void SetBorder(float thickness, float r, float g, float b)
     {
-        if (_border == null)
-        {
-            // Initial create at 0,0, updated in UpdateLayout
-            var newBorder = UIImage.Create(0, 0, Width + thickness * 2, Height + thickness * 2);
-            newBorder.Anchor(0.5f, 0.5f);
-            newBorder.Layer(Layer - 1); 
-            newBorder.UseScreenSpace(UseScreenSpace);
-            _border = newBorder;
-        }
-        else
-        {
-            var border = _border.Value;
-            border.Size = (Width + thickness * 2, Height + thickness * 2);
-        }
-        
-        var bVal = _border.Value;
-        bVal.Color(r, g, b);
-        bVal.IsVisible(IsVisible);
-        UpdateLayout();
+        Background.Size = (Width + thickness * 2, Height + thickness * 2);
+        Background.SetBorder(thickness, r, g, b);
     }
     
     public override void Destroy()
     {
         Background.Destroy();
-        if (_border.HasValue) _border.Value.Destroy();
         UISystem.Unregister(this);
         base.Destroy();
     }
@@ -381,7 +346,6 @@ public class UIScrollPanel : UIElement
     {
         base.SetVisible(visible);
         Background.IsVisible(visible);
-        if (_border.HasValue) _border.Value.IsVisible(visible);
         
         // base.SetVisible just calls UpdateLayout which handles children
     }
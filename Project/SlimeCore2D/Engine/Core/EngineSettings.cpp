@@ -1,3 +1,4 @@
 #include "EngineSettings.h"
 
 RendererType g_RendererType = RendererType::Vulkan;
+bool g_RenderThread = true;
@@ -7,3 +7,6 @@ enum class RendererType
 };
 
 extern RendererType g_RendererType;
+
+// Replay recorded frames on a dedicated render thread (see RenderThread). Off with --single-thread.
+extern bool g_RenderThread;
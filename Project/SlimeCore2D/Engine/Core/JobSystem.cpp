@@ -0,0 +1,151 @@
+#include "JobSystem.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Core/Logger.h"
+
+namespace
+{
+	std::vector<std::thread> s_Workers;
+	std::mutex s_CallMutex; // Held by the thread running ParallelFor, so the job state has one owner
+	std::mutex s_Mutex;
+	std::condition_variable s_WakeCV;
+	std::condition_variable s_DoneCV;
+
+	bool s_Quit = false;
+	uint64_t s_Generation = 0;
+	uint32_t s_Active = 0; // Workers currently inside a job
+
+	// Current job, written under s_Mutex before s_Generation is bumped
+	const std::function<void(size_t, size_t)>* s_Fn = nullptr;
+	size_t s_Count = 0;
+	size_t s_RangeSize = 0;
+	size_t s_RangeCount = 0;
+	std::atomic<size_t> s_NextRange { 0 };
+	std::atomic<size_t> s_RangesDone { 0 };
+
+	void RunRanges()
+	{
+		for (;;)
+		{
+			size_t range = s_NextRange.fetch_add(1);
+			if (range >= s_RangeCount)
+				break;
+
+			size_t begin = range * s_RangeSize;
+			size_t end = std::min(begin + s_RangeSize, s_Count);
+			(*s_Fn)(begin, end);
+
+			if (s_RangesDone.fetch_add(1) + 1 == s_RangeCount)
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				s_DoneCV.notify_all();
+			}
+		}
+	}
+
+	void WorkerLoop()
+	{
+		uint64_t seen = 0;
+		for (;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(s_Mutex);
+				s_WakeCV.wait(lock, [&] { return s_Quit || s_Generation != seen; });
+				if (s_Quit)
+					return;
+				seen = s_Generation;
+				s_Active++;
+			}
+
+			RunRanges();
+
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				s_Active--;
+			}
+			s_DoneCV.notify_all();
+		}
+	}
+} // namespace
+
+void JobSystem::Init(uint32_t workerCount)
+{
+	if (!s_Workers.empty())
+		return;
+
+	if (workerCount == 0)
+	{
+		uint32_t hw = std::thread::hardware_concurrency();
+		workerCount = hw > 1 ? hw - 1 : 0;
+	}
+
+	s_Quit = false;
+	s_Workers.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i)
+		s_Workers.emplace_back(WorkerLoop);
+
+	Logger::Info("JobSystem: Started " + std::to_string(workerCount) + " worker thread(s)");
+}
+
+void JobSystem::Shutdown()
+{
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Quit = true;
+	}
+	s_WakeCV.notify_all();
+
+	for (auto& t: s_Workers)
+		t.join();
+	s_Workers.clear();
+}
+
+uint32_t JobSystem::GetWorkerCount()
+{
+	return (uint32_t) s_Workers.size();
+}
+
+void JobSystem::ParallelFor(size_t count, size_t minRange, const std::function<void(size_t, size_t)>& fn)
+{
+	if (count == 0)
+		return;
+
+	size_t threads = s_Workers.size() + 1;
+	size_t rangeSize = std::max<size_t>(std::max<size_t>(minRange, 1), (count + threads - 1) / threads);
+
+	// Not worth waking anyone up
+	if (s_Workers.empty() || rangeSize >= count)
+	{
+		fn(0, count);
+		return;
+	}
+
+	std::lock_guard<std::mutex> callLock(s_CallMutex);
+	{
+		std::unique_lock<std::mutex> lock(s_Mutex);
+		// Stragglers from the previous job must be out before its state is replaced
+		s_DoneCV.wait(lock, [] { return s_Active == 0; });
+
+		s_Fn = &fn;
+		s_Count = count;
+		s_RangeSize = rangeSize;
+		s_RangeCount = (count + rangeSize - 1) / rangeSize;
+		s_NextRange = 0;
+		s_RangesDone = 0;
+		s_Generation++;
+	}
+	s_WakeCV.notify_all();
+
+	// The calling thread works too
+	RunRanges();
+
+	std::unique_lock<std::mutex> lock(s_Mutex);
+	s_DoneCV.wait(lock, [] { return s_RangesDone.load() == s_RangeCount && s_Active == 0; });
+	s_Fn = nullptr;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+// Small fixed pool of worker threads for data-parallel loops.
+// ParallelFor may be called from the main and render threads; concurrent calls run one after the other.
+class JobSystem
+{
+public:
+	// 'workerCount' of 0 picks hardware_concurrency - 1.
+	static void Init(uint32_t workerCount = 0);
+	static void Shutdown();
+
+	// Number of worker threads, not counting the calling thread.
+	static uint32_t GetWorkerCount();
+
+	// Splits [0, count) into contiguous ranges of at least 'minRange' items and runs fn(begin, end)
+	// across the workers and the calling thread. Blocks until every range has finished.
+	static void ParallelFor(size_t count, size_t minRange, const std::function<void(size_t, size_t)>& fn);
+};
@@ -0,0 +1,132 @@
+#include "RenderThread.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Core/Logger.h"
+
+namespace
+{
+	std::thread s_Thread;
+	std::thread::id s_ThreadId;
+	std::mutex s_Mutex;
+	std::condition_variable s_WakeCV;
+	std::condition_variable s_DoneCV;
+
+	std::function<void()> s_Frame;
+	bool s_Busy = false; // A frame was submitted and has not finished yet
+	bool s_Quit = false;
+
+	std::vector<std::function<void()>> s_Posted;
+
+	void ThreadLoop()
+	{
+		for (;;)
+		{
+			std::function<void()> frame;
+			{
+				std::unique_lock<std::mutex> lock(s_Mutex);
+				s_WakeCV.wait(lock, [] { return s_Quit || s_Frame; });
+				if (!s_Frame)
+					return;
+				frame = std::move(s_Frame);
+				s_Frame = nullptr;
+			}
+
+			frame();
+
+			{
+				std::lock_guard<std::mutex> lock(s_Mutex);
+				s_Busy = false;
+			}
+			s_DoneCV.notify_all();
+		}
+	}
+} // namespace
+
+void RenderThread::Init(bool threaded)
+{
+	if (!threaded || s_Thread.joinable())
+		return;
+
+	s_Quit = false;
+	s_Thread = std::thread(ThreadLoop);
+	s_ThreadId = s_Thread.get_id();
+
+	Logger::Info("RenderThread: Frames are submitted on a dedicated thread");
+}
+
+void RenderThread::Shutdown()
+{
+	if (!s_Thread.joinable())
+		return;
+
+	Wait();
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Quit = true;
+	}
+	s_WakeCV.notify_all();
+
+	s_Thread.join();
+	s_ThreadId = std::thread::id();
+}
+
+bool RenderThread::IsThreaded()
+{
+	return s_Thread.joinable();
+}
+
+void RenderThread::Wait()
+{
+	if (!s_Thread.joinable() || std::this_thread::get_id() == s_ThreadId)
+		return;
+
+	std::vector<std::function<void()>> posted;
+	for (;;)
+	{
+		{
+			std::unique_lock<std::mutex> lock(s_Mutex);
+			s_DoneCV.wait(lock, [] { return !s_Busy; });
+			posted.clear();
+			posted.swap(s_Posted);
+		}
+		if (posted.empty())
+			return;
+
+		// The render thread is idle, so the context is free here
+		for (auto& work: posted)
+			work();
+	}
+}
+
+void RenderThread::Post(std::function<void()> work)
+{
+	if (!s_Thread.joinable() || std::this_thread::get_id() == s_ThreadId)
+	{
+		work();
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(s_Mutex);
+	s_Posted.push_back(std::move(work));
+}
+
+void RenderThread::Submit(std::function<void()> frame)
+{
+	if (!s_Thread.joinable())
+	{
+		frame();
+		return;
+	}
+
+	Wait();
+	{
+		std::lock_guard<std::mutex> lock(s_Mutex);
+		s_Frame = std::move(frame);
+		s_Busy = true;
+	}
+	s_WakeCV.notify_all();
+}
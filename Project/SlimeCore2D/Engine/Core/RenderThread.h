@@ -0,0 +1,32 @@
+#pragma once
+
+#include <functional>
+
+// Runs frame submission on its own thread, so the main thread simulates and records frame N+1 while frame N is
+// drawn and presented. At most one frame is in flight. While it is, the device context and the Renderer belong to
+// the render thread: main-thread code that needs either calls Wait() first, or hands the work to Post(). Texture,
+// glyph and tilemap uploads are posted, so recording never stalls on them; resource creation and state requests
+// still wait, so scripts creating resources mid-update stay safe.
+// Without a thread Submit() runs the frame inline, Wait() returns at once and Post() runs its work at once.
+class RenderThread
+{
+public:
+	static void Init(bool threaded);
+
+	// Finishes the frame in flight, then joins the thread
+	static void Shutdown();
+
+	static bool IsThreaded();
+
+	// Blocks until the frame in flight has been presented, then runs any posted work. Returns at once on the
+	// render thread itself.
+	static void Wait();
+
+	// Queues device context work (uploads) that must not overlap the frame in flight. It runs, in posting order,
+	// at the next Wait(), which Submit() always calls, so it lands before the frame being recorded is replayed.
+	// Runs at once on the render thread or without a thread.
+	static void Post(std::function<void()> work);
+
+	// Hands 'frame' to the render thread after the previous one has finished
+	static void Submit(std::function<void()> frame);
+};
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace Timing
+{
+	// Time since 'start' formatted for load logs, e.g. "12.34 ms"
+	inline std::string ElapsedMs(std::chrono::steady_clock::time_point start)
+	{
+		char buf[32];
+		snprintf(buf, sizeof(buf), "%.2f ms", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+		return buf;
+	}
+} // namespace Timing
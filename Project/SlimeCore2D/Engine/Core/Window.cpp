@@ -8,6 +8,8 @@
 #include "EngineSettings.h"
 #include "Input.h"
 #include "Logger.h"
+#include "RenderThread.h"
+#include "Rendering/ResourceState.h"
 
 #if PLATFORM_WIN32
 #	include "Win32NativeWindow.h"
@@ -127,6 +129,7 @@ void Window::InitDiligent(HWND hwnd, int width, int height)
 			EngineD3D12CreateInfo EngineCI;
 			EngineCI.Features.SeparablePrograms = DEVICE_FEATURE_STATE_ENABLED;
 			EngineCI.Features.BindlessResources = DEVICE_FEATURE_STATE_ENABLED;
+			EngineCI.Features.DurationQueries = DEVICE_FEATURE_STATE_OPTIONAL; // Times the world pass for dynamic resolution
 
 			// Increase GPU descriptor heap size for D3D12 to handle large texture arrays
 			// We need a large dynamic heap because we are using DYNAMIC shader variables for texture arrays (1024 slots)
@@ -154,6 +157,7 @@ void Window::InitDiligent(HWND hwnd, int width, int height)
 			EngineVkCreateInfo EngineCI;
 			EngineCI.Features.SeparablePrograms = DEVICE_FEATURE_STATE_ENABLED;
 			EngineCI.Features.BindlessResources = DEVICE_FEATURE_STATE_ENABLED;
+			EngineCI.Features.DurationQueries = DEVICE_FEATURE_STATE_OPTIONAL; // Times the world pass for dynamic resolution
 			EngineCI.DynamicHeapSize = 256 * 1024 * 1024; // 256 MB
 
 			// Increase descriptor pool size to avoid frequent reallocations with many TileMap chunks
@@ -162,6 +166,9 @@ void Window::InitDiligent(HWND hwnd, int width, int height)
 			EngineCI.MainDescriptorPoolSize.NumSampledImageDescriptors = 32768 * 32; // 32 textures per chunk
 			EngineCI.MainDescriptorPoolSize.NumUniformBufferDescriptors = 32768;
 
+			// The renderer's bindless table commits 1024 images into a dynamic set per submission
+			EngineCI.DynamicDescriptorPoolSize.NumSampledImageDescriptors = 16384;
+
 			pFactoryVk->CreateDeviceAndContextsVk(EngineCI, &s_Device, &s_Context);
 			NativeWindow WindowAttribs(hwnd);
 			pFactoryVk->CreateSwapChainVk(s_Device, s_Context, SCDesc, WindowAttribs, &m_SwapChain);
@@ -174,9 +181,13 @@ void Window::InitDiligent(HWND hwnd, int width, int height)
 	}
 }
 
-void Window::Update_Window()
+void Window::Present()
 {
 	m_SwapChain->Present(1); // VSync
+}
+
+void Window::PollEvents()
+{
 	glfwPollEvents();
 
 	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
@@ -193,12 +204,12 @@ void Window::BeginFrame()
 	auto* pDSV = m_SwapChain->GetDepthBufferDSV();
 	if (!pRTV)
 		Logger::Error("Window::BeginFrame: RTV is null!");
+	// The one transition of the frame for the back buffer; the clears after it only check
 	s_Context->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
 	// Clear
-	float color[4] = { 0.06f, 0.06f, 0.06f, 1.0f };
-	s_Context->ClearRenderTarget(pRTV, color, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
-	s_Context->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG | CLEAR_STENCIL_FLAG, 1.0f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+	s_Context->ClearRenderTarget(pRTV, ClearColor, ResourceState::BindMode);
+	s_Context->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG | CLEAR_STENCIL_FLAG, 1.0f, 0, ResourceState::BindMode);
 }
 
 int Window::Window_shouldClose()
@@ -230,6 +241,9 @@ void Window::Resize(int width, int height)
 	if (width == 0 || height == 0)
 		return;
 
+	// The swap chain can't resize under a frame that is still drawing to it
+	RenderThread::Wait();
+
 	if (m_SwapChain)
 	{
 		m_SwapChain->Resize(width, height);
@@ -22,13 +22,17 @@ public:
 	// Window Functions
 	int Window_intit(int width, int height, char* name);
 	void BeginFrame();
-	void Update_Window();
+	void Present();    // Render thread
+	void PollEvents(); // Main thread; also advances the delta time
 	int Window_shouldClose();
 	void Window_destroy();
 	void Resize(int width, int height);
 
 	float GetDeltaTime();
 
+	// Background of every frame; offscreen world targets clear to it too
+	static constexpr float ClearColor[4] = { 0.06f, 0.06f, 0.06f, 1.0f };
+
 	static IRenderDevice* GetDevice()
 	{
 		return s_Device;
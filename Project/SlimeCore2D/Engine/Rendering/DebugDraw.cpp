@@ -0,0 +1,464 @@
+#include "DebugDraw.h"
+
+#if SLIME_DEBUG_DRAW
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "Core/Logger.h"
+#include "Core/Window.h"
+#include "DiligentCore/Graphics/GraphicsTools/interface/MapHelper.hpp"
+#include "Font.h"
+#include "PipelineCache.h"
+#include "Renderer.h"
+#include "ResourceState.h"
+#include "Resources/ResourceManager.h"
+#include "Shader.h"
+
+bool DebugDraw::s_Enabled = true;
+
+namespace
+{
+	constexpr uint32_t CircleSegments = 32;
+	constexpr uint32_t MinVertexCapacity = 4096;
+
+	using DebugVertex = DebugDraw::Frame::Vertex;
+
+	// Matches GlobalConstants in Structures.fxh
+	struct DebugConstants
+	{
+		glm::mat4 ViewProjection;
+		float Time;
+		float Padding[3];
+	};
+
+	// Primitives submitted with a duration: a fixed number of vertices each plus one expiry time
+	struct TimedStream
+	{
+		std::vector<DebugVertex> Vertices;
+		std::vector<double> Expiry;
+	};
+
+	struct TextTag
+	{
+		glm::vec2 Position;
+		std::string Text;
+		glm::vec4 Color;
+		float Height;
+		double Expiry;
+	};
+
+	struct DebugDrawData
+	{
+		RefCntAutoPtr<IPipelineState> LinePSO;
+		RefCntAutoPtr<IPipelineState> TrianglePSO;
+		RefCntAutoPtr<IShaderResourceBinding> LineSRB;
+		RefCntAutoPtr<IShaderResourceBinding> TriangleSRB;
+		RefCntAutoPtr<IBuffer> ConstantBuffer;
+		RefCntAutoPtr<IBuffer> VertexBuffer;
+		uint32_t VertexCapacity = 0;
+
+		// This frame's shapes
+		std::vector<DebugVertex> Lines;
+		std::vector<DebugVertex> Triangles;
+		std::vector<TextTag> Texts;
+
+		// Shapes submitted with a duration
+		TimedStream TimedLines;
+		TimedStream TimedTriangles;
+		std::vector<TextTag> TimedTexts;
+	};
+
+	DebugDrawData s_Data;
+
+	void AddPrimitive(std::vector<DebugVertex>& frame, TimedStream& timed, const DebugVertex* vertices, uint32_t count, float duration)
+	{
+		if (duration > 0.0f)
+		{
+			timed.Vertices.insert(timed.Vertices.end(), vertices, vertices + count);
+			timed.Expiry.push_back(glfwGetTime() + duration);
+		}
+		else
+		{
+			frame.insert(frame.end(), vertices, vertices + count);
+		}
+	}
+
+	void AddLine(const glm::vec2& a, const glm::vec2& b, const glm::vec4& color, float duration)
+	{
+		DebugVertex v[2] = { { a, color }, { b, color } };
+		AddPrimitive(s_Data.Lines, s_Data.TimedLines, v, 2, duration);
+	}
+
+	void AddTriangle(const glm::vec2& a, const glm::vec2& b, const glm::vec2& c, const glm::vec4& color, float duration)
+	{
+		DebugVertex v[3] = { { a, color }, { b, color }, { c, color } };
+		AddPrimitive(s_Data.Triangles, s_Data.TimedTriangles, v, 3, duration);
+	}
+
+	glm::vec2 CirclePoint(const glm::vec2& center, float radius, uint32_t segment)
+	{
+		float angle = (float) segment / (float) CircleSegments * 6.28318530718f;
+		return center + glm::vec2(std::cos(angle), std::sin(angle)) * radius;
+	}
+
+	// Drops expired primitives, keeping the survivors in order
+	void Expire(TimedStream& timed, uint32_t stride, double now)
+	{
+		size_t kept = 0;
+		for (size_t i = 0; i < timed.Expiry.size(); ++i)
+		{
+			if (timed.Expiry[i] <= now)
+				continue;
+
+			if (kept != i)
+			{
+				timed.Expiry[kept] = timed.Expiry[i];
+				std::memcpy(&timed.Vertices[kept * stride], &timed.Vertices[i * stride], stride * sizeof(DebugVertex));
+			}
+			kept++;
+		}
+
+		timed.Expiry.resize(kept);
+		timed.Vertices.resize(kept * stride);
+	}
+
+	bool EnsureVertexCapacity(uint32_t count)
+	{
+		if (count <= s_Data.VertexCapacity && s_Data.VertexBuffer)
+			return true;
+
+		uint32_t capacity = std::max(s_Data.VertexCapacity, MinVertexCapacity);
+		while (capacity < count)
+			capacity *= 2;
+
+		s_Data.VertexBuffer.Release();
+
+		BufferDesc VBDesc;
+		VBDesc.Name = "DebugDraw Vertex Buffer";
+		VBDesc.Usage = USAGE_DYNAMIC;
+		VBDesc.BindFlags = BIND_VERTEX_BUFFER;
+		VBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+		VBDesc.Size = (Uint64) capacity * sizeof(DebugVertex);
+		Window::GetDevice()->CreateBuffer(VBDesc, nullptr, &s_Data.VertexBuffer);
+
+		s_Data.VertexCapacity = s_Data.VertexBuffer ? capacity : 0;
+		return s_Data.VertexBuffer != nullptr;
+	}
+} // namespace
+
+void DebugDraw::Init()
+{
+	auto device = Window::GetDevice();
+	auto& ResMgr = ResourceManager::GetInstance();
+
+	Shader* debugShader = ResMgr.GetShader("debug");
+	if (!debugShader)
+	{
+		Logger::Warn("DebugDraw: 'debug' shader not found. Debug shapes will not be drawn.");
+		return;
+	}
+
+	BufferDesc CBDesc;
+	CBDesc.Name = "DebugDraw CB";
+	CBDesc.Size = sizeof(DebugConstants);
+	CBDesc.Usage = USAGE_DYNAMIC;
+	CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+	CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+	device->CreateBuffer(CBDesc, nullptr, &s_Data.ConstantBuffer);
+
+	GraphicsPipelineStateCreateInfo PSOCreateInfo;
+	PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
+	PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+	PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = TEX_FORMAT_RGBA8_UNORM;
+	PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_D24_UNORM_S8_UINT;
+
+	PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = true;
+	PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend = BLEND_FACTOR_SRC_ALPHA;
+	PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlend = BLEND_FACTOR_INV_SRC_ALPHA;
+
+	// Always on top of the world
+	PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
+	PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = false;
+
+	LayoutElement LayoutElems[] = {
+		LayoutElement{ 0, 0, 2, VT_FLOAT32, False }, // Position
+		LayoutElement{ 1, 0, 4, VT_FLOAT32, False }  // Color
+	};
+	PSOCreateInfo.GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
+	PSOCreateInfo.GraphicsPipeline.InputLayout.NumElements = _countof(LayoutElems);
+
+	PSOCreateInfo.pVS = debugShader->GetVertexShader();
+	PSOCreateInfo.pPS = debugShader->GetPixelShader();
+
+	ShaderResourceVariableDesc Vars[] = {
+		{ SHADER_TYPE_VERTEX, "GlobalConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC }
+	};
+	PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+	PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+	auto createPSO = [&](const char* name, PRIMITIVE_TOPOLOGY topology, RefCntAutoPtr<IPipelineState>& outPSO, RefCntAutoPtr<IShaderResourceBinding>& outSRB)
+	{
+		PSOCreateInfo.PSODesc.Name = name;
+		PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = topology;
+		PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &outPSO);
+		if (!outPSO)
+			return;
+
+		if (auto* pVar = outPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "GlobalConstants"))
+			pVar->Set(s_Data.ConstantBuffer);
+		outPSO->CreateShaderResourceBinding(&outSRB, true);
+	};
+
+	createPSO("DebugDraw Line PSO", PRIMITIVE_TOPOLOGY_LINE_LIST, s_Data.LinePSO, s_Data.LineSRB);
+	createPSO("DebugDraw Triangle PSO", PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, s_Data.TrianglePSO, s_Data.TriangleSRB);
+
+	EnsureVertexCapacity(MinVertexCapacity);
+}
+
+void DebugDraw::Shutdown()
+{
+	Clear();
+	s_Data.LinePSO.Release();
+	s_Data.TrianglePSO.Release();
+	s_Data.LineSRB.Release();
+	s_Data.TriangleSRB.Release();
+	s_Data.ConstantBuffer.Release();
+	s_Data.VertexBuffer.Release();
+	s_Data.VertexCapacity = 0;
+}
+
+void DebugDraw::Capture(Frame& out)
+{
+	double now = glfwGetTime();
+	Expire(s_Data.TimedLines, 2, now);
+	Expire(s_Data.TimedTriangles, 3, now);
+
+	size_t kept = 0;
+	for (size_t i = 0; i < s_Data.TimedTexts.size(); ++i)
+	{
+		if (s_Data.TimedTexts[i].Expiry <= now)
+			continue;
+		if (kept != i)
+			s_Data.TimedTexts[kept] = std::move(s_Data.TimedTexts[i]);
+		kept++;
+	}
+	s_Data.TimedTexts.resize(kept);
+
+	out.Triangles.clear();
+	out.Lines.clear();
+	out.Texts.clear();
+	out.Time = (float) now;
+
+	if (s_Enabled)
+	{
+		// Triangles first so outlines stay visible over fills
+		out.Triangles.insert(out.Triangles.end(), s_Data.Triangles.begin(), s_Data.Triangles.end());
+		out.Triangles.insert(out.Triangles.end(), s_Data.TimedTriangles.Vertices.begin(), s_Data.TimedTriangles.Vertices.end());
+		out.Lines.insert(out.Lines.end(), s_Data.Lines.begin(), s_Data.Lines.end());
+		out.Lines.insert(out.Lines.end(), s_Data.TimedLines.Vertices.begin(), s_Data.TimedLines.Vertices.end());
+	}
+
+	// Text tags are shaped here, where glyphs may still be rasterized
+	if (s_Enabled && (!s_Data.Texts.empty() || !s_Data.TimedTexts.empty()))
+	{
+		auto& ResMgr = ResourceManager::GetInstance();
+		Font* font = ResMgr.GetFont("DefaultFont");
+		if (!font)
+			font = ResMgr.LoadFont("DefaultFont", "Fonts/Overpass.ttf", 48);
+
+		if (font)
+		{
+			for (const auto* tags: { &s_Data.Texts, &s_Data.TimedTexts })
+			{
+				for (const TextTag& tag: *tags)
+				{
+					Frame::Tag& shaped = out.Texts.emplace_back();
+					shaped.Layout.Build(tag.Text, font, tag.Height / (float) font->GetFontSize());
+					shaped.Layout.PrepareDraw();
+					shaped.Position = glm::vec3(tag.Position, 0.0f);
+					shaped.Color = tag.Color;
+				}
+			}
+		}
+	}
+
+	s_Data.Lines.clear();
+	s_Data.Triangles.clear();
+	s_Data.Texts.clear();
+}
+
+void DebugDraw::Render(const glm::mat4& viewProj, const Frame& frame)
+{
+	uint32_t triangleCount = (uint32_t) frame.Triangles.size();
+	uint32_t lineCount = (uint32_t) frame.Lines.size();
+
+	// 1. Shapes: one upload, triangles first
+	if (s_Data.LinePSO && s_Data.TrianglePSO && triangleCount + lineCount > 0 && EnsureVertexCapacity(triangleCount + lineCount))
+	{
+		auto context = Window::GetContext();
+
+		{
+			MapHelper<DebugConstants> CBData(context, s_Data.ConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+			CBData->ViewProjection = viewProj;
+			CBData->Time = frame.Time;
+		}
+
+		{
+			MapHelper<DebugVertex> VBData(context, s_Data.VertexBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+			DebugVertex* dst = VBData;
+			if (triangleCount > 0)
+				std::memcpy(dst, frame.Triangles.data(), triangleCount * sizeof(DebugVertex));
+			if (lineCount > 0)
+				std::memcpy(dst + triangleCount, frame.Lines.data(), lineCount * sizeof(DebugVertex));
+		}
+
+		IBuffer* pVBs[] = { s_Data.VertexBuffer };
+		Uint64 offsets[] = { 0 };
+		context->SetVertexBuffers(0, 1, pVBs, offsets, ResourceState::BindMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+
+		if (triangleCount > 0)
+		{
+			context->SetPipelineState(s_Data.TrianglePSO);
+			context->CommitShaderResources(s_Data.TriangleSRB, ResourceState::BindMode);
+
+			DrawAttribs DrawAttrs;
+			DrawAttrs.NumVertices = triangleCount;
+			DrawAttrs.Flags = ResourceState::DrawFlags;
+			context->Draw(DrawAttrs);
+		}
+
+		if (lineCount > 0)
+		{
+			context->SetPipelineState(s_Data.LinePSO);
+			context->CommitShaderResources(s_Data.LineSRB, ResourceState::BindMode);
+
+			DrawAttribs DrawAttrs;
+			DrawAttrs.NumVertices = lineCount;
+			DrawAttrs.StartVertexLocation = triangleCount;
+			DrawAttrs.Flags = ResourceState::DrawFlags;
+			context->Draw(DrawAttrs);
+		}
+	}
+
+	// 2. Text tags through the regular text batcher
+	if (!frame.Texts.empty())
+	{
+		Renderer::BeginScene(viewProj);
+		for (const Frame::Tag& tag: frame.Texts)
+			Renderer::DrawTextLayout(tag.Layout, tag.Position, tag.Color);
+		Renderer::EndScene();
+	}
+}
+
+void DebugDraw::Line(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float duration)
+{
+	if (!s_Enabled)
+		return;
+
+	AddLine(from, to, color, duration);
+}
+
+void DebugDraw::Arrow(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float headSize, float duration)
+{
+	if (!s_Enabled)
+		return;
+
+	AddLine(from, to, color, duration);
+
+	glm::vec2 dir = to - from;
+	float length = glm::length(dir);
+	if (length <= 0.0f)
+		return;
+
+	dir /= length;
+	glm::vec2 side = glm::vec2(-dir.y, dir.x) * (headSize * 0.5f);
+	glm::vec2 back = to - dir * std::min(headSize, length);
+	AddLine(to, back + side, color, duration);
+	AddLine(to, back - side, color, duration);
+}
+
+void DebugDraw::Rect(const glm::vec2& center, const glm::vec2& size, const glm::vec4& color, float duration)
+{
+	if (!s_Enabled)
+		return;
+
+	glm::vec2 h = size * 0.5f;
+	glm::vec2 corners[4] = { center + glm::vec2(-h.x, -h.y), center + glm::vec2(h.x, -h.y), center + glm::vec2(h.x, h.y), center + glm::vec2(-h.x, h.y) };
+	for (int i = 0; i < 4; ++i)
+		AddLine(corners[i], corners[(i + 1) % 4], color, duration);
+}
+
+void DebugDraw::FilledRect(const glm::vec2& center, const glm::vec2& size, const glm::vec4& color, float duration)
+{
+	if (!s_Enabled)
+		return;
+
+	glm::vec2 h = size * 0.5f;
+	glm::vec2 bl = center + glm::vec2(-h.x, -h.y);
+	glm::vec2 br = center + glm::vec2(h.x, -h.y);
+	glm::vec2 tr = center + glm::vec2(h.x, h.y);
+	glm::vec2 tl = center + glm::vec2(-h.x, h.y);
+	AddTriangle(bl, br, tr, color, duration);
+	AddTriangle(tr, tl, bl, color, duration);
+}
+
+void DebugDraw::Circle(const glm::vec2& center, float radius, const glm::vec4& color, float duration)
+{
+	if (!s_Enabled)
+		return;
+
+	glm::vec2 prev = CirclePoint(center, radius, 0);
+	for (uint32_t i = 1; i <= CircleSegments; ++i)
+	{
+		glm::vec2 next = CirclePoint(center, radius, i);
+		AddLine(prev, next, color, duration);
+		prev = next;
+	}
+}
+
+void DebugDraw::FilledCircle(const glm::vec2& center, float radius, const glm::vec4& color, float duration)
+{
+	if (!s_Enabled)
+		return;
+
+	glm::vec2 prev = CirclePoint(center, radius, 0);
+	for (uint32_t i = 1; i <= CircleSegments; ++i)
+	{
+		glm::vec2 next = CirclePoint(center, radius, i);
+		AddTriangle(center, prev, next, color, duration);
+		prev = next;
+	}
+}
+
+void DebugDraw::Text(const glm::vec2& position, const std::string& text, const glm::vec4& color, float height, float duration)
+{
+	if (!s_Enabled || text.empty())
+		return;
+
+	if (duration > 0.0f)
+		s_Data.TimedTexts.push_back({ position, text, color, height, glfwGetTime() + duration });
+	else
+		s_Data.Texts.push_back({ position, text, color, height, 0.0 });
+}
+
+void DebugDraw::Clear()
+{
+	s_Data.Lines.clear();
+	s_Data.Triangles.clear();
+	s_Data.Texts.clear();
+	s_Data.TimedLines = {};
+	s_Data.TimedTriangles = {};
+	s_Data.TimedTexts.clear();
+}
+
+void DebugDraw::SetEnabled(bool enabled)
+{
+	s_Enabled = enabled;
+	if (!enabled)
+		Clear();
+}
+
+#endif
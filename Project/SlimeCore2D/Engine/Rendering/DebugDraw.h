@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm.hpp>
+
+#include "TextLayout.h"
+
+// Debug draw is compiled into debug builds only. Define SLIME_DEBUG_DRAW=1 to keep it in a release build.
+#ifndef SLIME_DEBUG_DRAW
+#	ifdef _DEBUG
+#		define SLIME_DEBUG_DRAW 1
+#	else
+#		define SLIME_DEBUG_DRAW 0
+#	endif
+#endif
+
+// With debug draw compiled out every function below is an empty inline body, so calls vanish entirely.
+#if SLIME_DEBUG_DRAW
+#	define SLIME_DEBUG_DRAW_BODY ;
+#else
+#	define SLIME_DEBUG_DRAW_BODY {}
+#endif
+
+// Immediate-mode debug shapes in world space, kept out of the sprite batcher.
+// Shapes go into one line stream and one triangle stream. Capture() copies them out on the main thread,
+// and Render() uploads a captured frame with a single map and draws it in two calls, on top of the world
+// and beneath the UI. Text tags are shaped at capture and go through the text batcher.
+// 'duration' keeps a shape for that many seconds; 0 draws it for the current frame only.
+class DebugDraw
+{
+public:
+	// One frame of shapes, handed from the main thread to the render thread
+	struct Frame
+	{
+#if SLIME_DEBUG_DRAW
+		struct Vertex
+		{
+			glm::vec2 Position;
+			glm::vec4 Color;
+		};
+
+		struct Tag
+		{
+			TextLayout Layout;
+			glm::vec3 Position;
+			glm::vec4 Color;
+		};
+
+		std::vector<Vertex> Triangles;
+		std::vector<Vertex> Lines;
+		std::vector<Tag> Texts;
+		float Time = 0.0f;
+#endif
+	};
+
+	static void Init() SLIME_DEBUG_DRAW_BODY
+	static void Shutdown() SLIME_DEBUG_DRAW_BODY
+
+	// Moves everything submitted for this frame into 'out', plus a copy of the timed shapes still alive.
+	static void Capture(Frame& out) SLIME_DEBUG_DRAW_BODY
+
+	// Draws a captured frame. Render thread.
+	static void Render(const glm::mat4& viewProj, const Frame& frame) SLIME_DEBUG_DRAW_BODY
+
+	static void Line(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float duration = 0.0f) SLIME_DEBUG_DRAW_BODY
+	static void Arrow(const glm::vec2& from, const glm::vec2& to, const glm::vec4& color, float headSize = 0.25f, float duration = 0.0f) SLIME_DEBUG_DRAW_BODY
+	static void Rect(const glm::vec2& center, const glm::vec2& size, const glm::vec4& color, float duration = 0.0f) SLIME_DEBUG_DRAW_BODY
+	static void FilledRect(const glm::vec2& center, const glm::vec2& size, const glm::vec4& color, float duration = 0.0f) SLIME_DEBUG_DRAW_BODY
+	static void Circle(const glm::vec2& center, float radius, const glm::vec4& color, float duration = 0.0f) SLIME_DEBUG_DRAW_BODY
+	static void FilledCircle(const glm::vec2& center, float radius, const glm::vec4& color, float duration = 0.0f) SLIME_DEBUG_DRAW_BODY
+
+	// 'height' is the text height in world units
+	static void Text(const glm::vec2& position, const std::string& text, const glm::vec4& color, float height = 0.5f, float duration = 0.0f) SLIME_DEBUG_DRAW_BODY
+
+	// Drops every pending and timed shape
+	static void Clear() SLIME_DEBUG_DRAW_BODY
+
+	// Runtime toggle; while disabled submissions are ignored
+	static void SetEnabled(bool enabled) SLIME_DEBUG_DRAW_BODY
+
+	static bool IsEnabled()
+	{
+#if SLIME_DEBUG_DRAW
+		return s_Enabled;
+#else
+		return false;
+#endif
+	}
+
+private:
+#if SLIME_DEBUG_DRAW
+	static bool s_Enabled;
+#endif
+};
+
+#undef SLIME_DEBUG_DRAW_BODY
@@ -1,9 +1,18 @@
 #include "Font.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iostream>
+#include <mutex>
 
+#include "Core/JobSystem.h"
 #include "Core/Logger.h"
+#include "Core/Timing.h"
+#include "TextLayout.h"
 
 using namespace Diligent;
 
@@ -11,265 +20,749 @@ using namespace Diligent;
 // If your FreeType is older, remove 'FT_RENDER_MODE_SDF' and standard aliasing will apply,
 // though the shader logic in Renderer will need to know it's not an SDF.
 
-Font::Font(const std::string& fontPath, unsigned int fontSize)
+uint64_t Font::s_FrameIndex = 1;
+
+namespace
+{
+	// Empty pixels kept around each glyph so linear filtering never bleeds into a neighbour
+	constexpr uint32_t GlyphPadding = 2;
+
+	// Prefer SDF if the FreeType build supports it, otherwise fall back to normal AA.
+#ifdef FT_RENDER_MODE_SDF
+	constexpr FT_Render_Mode GlyphRenderMode = FT_RENDER_MODE_SDF;
+#else
+	constexpr FT_Render_Mode GlyphRenderMode = FT_RENDER_MODE_NORMAL;
+#endif
+
+	// Glyphs rasterized (in parallel) when a font has no usable cache
+	constexpr uint32_t PrewarmFirst = 32;
+	constexpr uint32_t PrewarmLast = 126;
+
+	// Bump whenever the cache layout or anything baked into it (padding, render mode) changes
+	constexpr uint32_t CacheMagic = 0x43464C53; // "SLFC"
+	constexpr uint32_t CacheVersion = 3;
+
+	struct CacheHeader
+	{
+		uint32_t Magic;
+		uint32_t Version;
+		uint64_t FileKey;
+		uint32_t FontSize;
+		uint32_t PageSize;
+		uint32_t Padding;
+		uint32_t RenderMode;
+		uint32_t PageCount;
+		uint32_t GlyphCount;
+	};
+
+	struct CacheGlyph
+	{
+		uint32_t Codepoint;
+		uint32_t Missing;
+		float Size[2];
+		float Bearing[2];
+		uint32_t Advance;
+		float UVMin[2];
+		float UVMax[2];
+		uint32_t Page;
+	};
+
+	// How much of each end of the font file FileKey hashes
+	constexpr size_t FileKeySpan = 64 * 1024;
+
+	// Identifies the font file for the cache by its contents: its name, size, and its first and last 64 KiB, hashed
+	// with FNV-1a. An sfnt file opens with a table directory holding every table's checksum, so an edit anywhere in
+	// the file changes the first span even when the size stays the same.
+	uint64_t FileKey(const std::string& fileName, const std::vector<unsigned char>& data)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		auto mix = [&hash](const void* bytes, size_t size)
+		{
+			const unsigned char* p = (const unsigned char*) bytes;
+			for (size_t i = 0; i < size; ++i)
+			{
+				hash ^= p[i];
+				hash *= 1099511628211ull;
+			}
+		};
+
+		uint64_t size = data.size();
+		mix(fileName.data(), fileName.size());
+		mix(&size, sizeof(size));
+
+		size_t head = std::min(data.size(), FileKeySpan);
+		size_t tailStart = std::max(head, data.size() - std::min(data.size(), FileKeySpan));
+		mix(data.data(), head);
+		mix(data.data() + tailStart, data.size() - tailStart);
+		return hash;
+	}
+
+	// One FreeType library for the whole process. Faces on it may render on different threads at once, but
+	// creating and destroying them must be serialized. Never released, so no face can outlive it.
+	struct SharedLibrary
+	{
+		FT_Library Library = nullptr;
+		std::mutex Mutex;
+	};
+
+	SharedLibrary& GetSharedLibrary()
+	{
+		static SharedLibrary* s_Library = []
+		{
+			SharedLibrary* shared = new SharedLibrary();
+			if (FT_Init_FreeType(&shared->Library))
+				shared->Library = nullptr;
+			return shared;
+		}();
+		return *s_Library;
+	}
+
+	bool NewFace(const unsigned char* data, FT_Long size, FT_Face& outFace)
+	{
+		SharedLibrary& shared = GetSharedLibrary();
+		if (!shared.Library)
+			return false;
+
+		std::lock_guard<std::mutex> lock(shared.Mutex);
+		if (FT_New_Memory_Face(shared.Library, data, size, 0, &outFace))
+		{
+			outFace = nullptr;
+			return false;
+		}
+		return true;
+	}
+
+	void DoneFace(FT_Face face)
+	{
+		std::lock_guard<std::mutex> lock(GetSharedLibrary().Mutex);
+		FT_Done_Face(face);
+	}
+}
+
+// A glyph rendered by FreeType but not yet placed in the atlas
+struct Font::RasterizedGlyph
+{
+	uint32_t Codepoint = 0;
+	bool Missing = false; // Not in the font
+	bool Failed = false;  // FreeType could not load or render it
+	Character Metrics;
+	uint32_t Width = 0;
+	uint32_t Height = 0;
+	std::vector<unsigned char> Bitmap;
+};
+
+Font::Font(const std::string& fontPath, unsigned int fontSize, const std::string& cacheDir)
       : m_FontSize(fontSize)
 {
-	FT_Library ft;
-	if (FT_Init_FreeType(&ft))
+	auto start = std::chrono::steady_clock::now();
+
+	std::ifstream file(fontPath, std::ios::binary | std::ios::ate);
+	if (!file)
+	{
+		Logger::Error("ERROR::FREETYPE: Failed to load font: " + fontPath);
+		return;
+	}
+
+	// The face reads from this buffer, so it lives as long as the font; worker faces share it
+	m_FileData.resize((size_t) file.tellg());
+	file.seekg(0);
+	file.read((char*) m_FileData.data(), (std::streamsize) m_FileData.size());
+
+	if (!GetSharedLibrary().Library)
 	{
 		Logger::Error("ERROR::FREETYPE: Could not init FreeType Library");
 		return;
 	}
 
-	FT_Face face;
-	if (FT_New_Face(ft, fontPath.c_str(), 0, &face))
+	if (!NewFace(m_FileData.data(), (FT_Long) m_FileData.size(), m_Face))
 	{
 		Logger::Error("ERROR::FREETYPE: Failed to load font: " + fontPath);
-		FT_Done_FreeType(ft);
 		return;
 	}
 
 	// Set size to load glyphs as.
 	// For SDF, 48-64 is a good balance between quality and texture size.
-	FT_Set_Pixel_Sizes(face, 0, fontSize);
+	FT_Set_Pixel_Sizes(m_Face, 0, fontSize);
+
+	std::string fileName = fontPath.substr(fontPath.find_last_of("\\/") + 1);
+	m_FileKey = FileKey(fileName, m_FileData);
 
-	// Generate the Texture Atlas
-	GenerateAtlas(face);
+	if (!cacheDir.empty())
+	{
+		char key[32];
+		snprintf(key, sizeof(key), "%016llx", (unsigned long long) m_FileKey);
+		m_CachePath = cacheDir + "/" + key + "_" + std::to_string(fontSize) + ".fontcache";
+
+		if (LoadCache())
+		{
+			Logger::Info("Font: '" + fileName + "' " + std::to_string(fontSize) + "px loaded warm from cache in " + Timing::ElapsedMs(start));
+			return;
+		}
+	}
+
+	// Cold: rasterize the printable ASCII range up front (in parallel), the rest stays on demand
+	std::vector<uint32_t> codepoints;
+	for (uint32_t c = PrewarmFirst; c <= PrewarmLast; ++c)
+		codepoints.push_back(c);
+	Prewarm(codepoints);
+
+	Logger::Info("Font: '" + fileName + "' " + std::to_string(fontSize) + "px rasterized cold in " + Timing::ElapsedMs(start));
 
-	// Cleanup
-	FT_Done_Face(face);
-	FT_Done_FreeType(ft);
+	SaveCache();
 }
 
 Font::~Font()
 {
-	if (m_AtlasTexture)
+	for (auto& page: m_Pages)
 	{
-		delete m_AtlasTexture;
-		m_AtlasTexture = nullptr;
+		delete page.Atlas;
+		page.Atlas = nullptr;
 	}
+
+	if (m_Face)
+		DoneFace(m_Face);
+}
+
+void Font::BeginFrame()
+{
+	s_FrameIndex++;
+}
+
+Font::GlyphSlot& Font::GetSlot(uint32_t codepoint)
+{
+	if (codepoint < 256)
+		return m_Latin[codepoint];
+	return m_Extended[codepoint];
 }
 
-void Font::GenerateAtlas(FT_Face face)
+const Character* Font::GetGlyph(uint32_t codepoint)
 {
-	// 1. Setup Atlas Dimensions
-	// 1024x1024 is generally large enough for standard ASCII + some extras at 48px
-	const int atlasWidth = 1024;
-	const int atlasHeight = 1024;
+	GlyphSlot& slot = GetSlot(codepoint);
 
-	// Buffer to hold texture data (R8 component only)
-	std::vector<unsigned char> atlasData(atlasWidth * atlasHeight, 0);
+	if (slot.State == SlotState::Empty && !RasterizeGlyph(codepoint, slot))
+		return nullptr;
+	if (slot.State != SlotState::Loaded)
+		return nullptr;
 
-	// Packing variables
-	int xOffset = 0;
-	int yOffset = 0;
-	int rowHeight = 0;
+	if (slot.Glyph.Size.x > 0.0f && slot.Glyph.Size.y > 0.0f)
+		m_Pages[slot.Glyph.Page].LastUsedFrame = s_FrameIndex;
 
-	// 2. Load and Pack Characters (ASCII 32-126)
-	// We iterate through printable characters
-	for (unsigned char c = 32; c < 127; c++)
+	return &slot.Glyph;
+}
+
+void Font::TouchPage(uint32_t page)
+{
+	if (page < m_Pages.size())
+		m_Pages[page].LastUsedFrame = s_FrameIndex;
+}
+
+void Font::RenderGlyph(FT_Face face, uint32_t codepoint, RasterizedGlyph& out)
+{
+	out.Codepoint = codepoint;
+
+	FT_UInt glyphIndex = FT_Get_Char_Index(face, codepoint);
+	if (glyphIndex == 0)
+	{
+		out.Missing = true;
+		return;
+	}
+
+	// Load glyph outline first (no render) then render with the best mode available.
+	if (FT_Load_Glyph(face, glyphIndex, FT_LOAD_DEFAULT) || FT_Render_Glyph(face->glyph, GlyphRenderMode))
+	{
+		out.Failed = true;
+		return;
+	}
+
+	const FT_Bitmap& bitmap = face->glyph->bitmap;
+	out.Width = bitmap.width;
+	out.Height = bitmap.rows;
+
+	out.Metrics.Size = glm::vec2(out.Width, out.Height);
+	out.Metrics.Bearing = glm::vec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
+	out.Metrics.Advance = static_cast<unsigned int>(face->glyph->advance.x);
+	out.Metrics.uvMin = glm::vec2(0.0f);
+	out.Metrics.uvMax = glm::vec2(0.0f);
+
+	// FreeType reuses its glyph slot, so take a tightly packed copy
+	int pitch = bitmap.pitch < 0 ? -bitmap.pitch : bitmap.pitch;
+	out.Bitmap.resize((size_t) out.Width * out.Height);
+	for (uint32_t row = 0; row < out.Height; ++row)
+		memcpy(&out.Bitmap[(size_t) row * out.Width], &bitmap.buffer[(size_t) row * pitch], out.Width);
+}
+
+bool Font::RasterizeGlyph(uint32_t codepoint, GlyphSlot& slot)
+{
+	if (!m_Face)
+		return false;
+
+	RasterizedGlyph glyph;
+	RenderGlyph(m_Face, codepoint, glyph);
+	return StoreGlyph(glyph, slot);
+}
+
+bool Font::StoreGlyph(const RasterizedGlyph& glyph, GlyphSlot& slot)
+{
+	if (glyph.Missing || glyph.Failed)
+	{
+		// Remember it so the lookup stays cheap
+		if (glyph.Failed)
+			Logger::Warn("ERROR::FREETYPE: Failed to render Glyph: " + std::to_string(glyph.Codepoint));
+		slot.State = SlotState::Missing;
+		return false;
+	}
+
+	Character character = glyph.Metrics;
+
+	// Whitespace has metrics but no bitmap and takes no atlas space
+	if (glyph.Width > 0 && glyph.Height > 0)
+	{
+		uint32_t pageIndex = 0, x = 0, y = 0;
+		if (!AllocateRegion(glyph.Width + GlyphPadding, glyph.Height + GlyphPadding, pageIndex, x, y))
+			return false; // Left empty so it is retried once a page frees up
+
+		Page& page = m_Pages[pageIndex];
+
+		// Copy glyph bitmap into the page; FreeType renders top-down, as does the atlas
+		for (uint32_t row = 0; row < glyph.Height; ++row)
+			memcpy(&page.Pixels[(size_t) (y + row) * PageSize + x], &glyph.Bitmap[(size_t) row * glyph.Width], glyph.Width);
+
+		MarkDirty(page, x, y, glyph.Width, glyph.Height);
+
+		character.Page = pageIndex;
+		character.uvMin = glm::vec2((float) x / PageSize, (float) y / PageSize);
+		character.uvMax = glm::vec2((float) (x + glyph.Width) / PageSize, (float) (y + glyph.Height) / PageSize);
+	}
+
+	slot.Glyph = character;
+	slot.State = SlotState::Loaded;
+	m_CacheDirty = true;
+	return true;
+}
+
+void Font::Prewarm(const std::vector<uint32_t>& codepoints)
+{
+	if (!m_Face || codepoints.empty())
+		return;
+
+	// Rendering is the expensive part and runs on the workers, each with a face of its own.
+	// Packing stays serial so the atlas layout is deterministic.
+	std::vector<RasterizedGlyph> glyphs(codepoints.size());
+	const unsigned char* fileData = m_FileData.data();
+	FT_Long fileSize = (FT_Long) m_FileData.size();
+	unsigned int fontSize = m_FontSize;
+
+	JobSystem::ParallelFor(codepoints.size(), 16, [&](size_t begin, size_t end)
 	{
-		// Load glyph outline first (no render) then render with the best mode available.
-		if (FT_Load_Char(face, c, FT_LOAD_DEFAULT))
+		FT_Face face = nullptr;
+		if (!NewFace(fileData, fileSize, face))
 		{
-			Logger::Warn("ERROR::FREETYPE: Failed to load Glyph: " + std::to_string(c));
-			continue;
+			for (size_t i = begin; i < end; ++i)
+			{
+				glyphs[i].Codepoint = codepoints[i];
+				glyphs[i].Failed = true;
+			}
+			return;
 		}
 
-		// Prefer SDF if the FreeType build supports it, otherwise fall back to normal AA.
-		FT_Render_Mode renderMode = FT_RENDER_MODE_NORMAL;
-#ifdef FT_RENDER_MODE_SDF
-		renderMode = FT_RENDER_MODE_SDF;
-#endif
+		FT_Set_Pixel_Sizes(face, 0, fontSize);
+		for (size_t i = begin; i < end; ++i)
+			RenderGlyph(face, codepoints[i], glyphs[i]);
+
+		DoneFace(face);
+	});
+
+	for (const auto& glyph: glyphs)
+	{
+		GlyphSlot& slot = GetSlot(glyph.Codepoint);
+		if (slot.State == SlotState::Empty)
+			StoreGlyph(glyph, slot);
+	}
+}
+
+bool Font::LoadCache()
+{
+	// The atlas is copied into the page buffers anyway, so a single read beats mapping the file
+	std::ifstream file(m_CachePath, std::ios::binary | std::ios::ate);
+	if (!file)
+		return false;
+
+	std::vector<unsigned char> data((size_t) file.tellg());
+	file.seekg(0);
+	file.read((char*) data.data(), (std::streamsize) data.size());
+
+	size_t cursor = 0;
+	auto read = [&](void* dst, size_t size) -> bool
+	{
+		if (cursor + size > data.size())
+			return false;
+		memcpy(dst, &data[cursor], size);
+		cursor += size;
+		return true;
+	};
+
+	CacheHeader header;
+	if (!read(&header, sizeof(header)))
+		return false;
+
+	if (header.Magic != CacheMagic || header.Version != CacheVersion || header.FileKey != m_FileKey || header.FontSize != m_FontSize ||
+	    header.PageSize != PageSize || header.Padding != GlyphPadding || header.RenderMode != (uint32_t) GlyphRenderMode || header.PageCount > MaxPages)
+	{
+		Logger::Warn("Font: Ignoring stale cache " + m_CachePath);
+		return false;
+	}
 
-		if (FT_Render_Glyph(face->glyph, renderMode))
+	std::vector<CacheGlyph> glyphs(header.GlyphCount);
+	if (!read(glyphs.data(), glyphs.size() * sizeof(CacheGlyph)))
+		return false;
+
+	// A glyph with a bitmap must point at a page in this file; anything else means the cache is corrupt
+	for (const auto& cached: glyphs)
+	{
+		bool hasBitmap = !cached.Missing && cached.Size[0] > 0.0f && cached.Size[1] > 0.0f;
+		if (hasBitmap && cached.Page >= header.PageCount)
 		{
-			Logger::Warn("ERROR::FREETYPE: Failed to render Glyph: " + std::to_string(c));
+			Logger::Warn("Font: Ignoring corrupt cache " + m_CachePath);
+			return false;
+		}
+	}
+
+	std::vector<Page> pages(header.PageCount);
+	for (auto& page: pages)
+	{
+		uint32_t nodeCount = 0;
+		if (!read(&nodeCount, sizeof(nodeCount)) || nodeCount == 0 || nodeCount > PageSize)
+			return false;
+
+		page.Skyline.resize(nodeCount);
+		page.Pixels.resize((size_t) PageSize * PageSize);
+		if (!read(page.Skyline.data(), nodeCount * sizeof(SkylineNode)) || !read(page.Pixels.data(), page.Pixels.size()))
+			return false;
+	}
+
+	// Everything checked out; commit it
+	for (auto& page: pages)
+	{
+		page.Atlas = new Texture(PageSize, PageSize, TEX_FORMAT_R8_UNORM, Texture::Filter::Linear, Texture::Wrap::ClampToEdge);
+		MarkDirty(page, 0, 0, PageSize, PageSize);
+		m_PageTextures[m_Pages.size()] = page.Atlas;
+		m_Pages.push_back(std::move(page));
+	}
+
+	for (const auto& cached: glyphs)
+	{
+		GlyphSlot& slot = GetSlot(cached.Codepoint);
+		if (cached.Missing)
+		{
+			slot.State = SlotState::Missing;
 			continue;
 		}
 
-		int width = face->glyph->bitmap.width;
-		int height = face->glyph->bitmap.rows;
+		slot.Glyph.Size = glm::vec2(cached.Size[0], cached.Size[1]);
+		slot.Glyph.Bearing = glm::vec2(cached.Bearing[0], cached.Bearing[1]);
+		slot.Glyph.Advance = cached.Advance;
+		slot.Glyph.uvMin = glm::vec2(cached.UVMin[0], cached.UVMin[1]);
+		slot.Glyph.uvMax = glm::vec2(cached.UVMax[0], cached.UVMax[1]);
+		slot.Glyph.Page = cached.Page < header.PageCount ? cached.Page : 0;
+		slot.State = SlotState::Loaded;
+	}
+
+	m_CacheDirty = false;
+	return true;
+}
+
+void Font::SaveCache()
+{
+	if (m_CachePath.empty() || !m_CacheDirty)
+		return;
+
+	std::vector<CacheGlyph> glyphs;
+	auto addSlot = [&glyphs](uint32_t codepoint, const GlyphSlot& slot)
+	{
+		if (slot.State == SlotState::Empty)
+			return;
+
+		CacheGlyph cached = {};
+		cached.Codepoint = codepoint;
+		cached.Missing = slot.State == SlotState::Missing ? 1 : 0;
+		cached.Size[0] = slot.Glyph.Size.x;
+		cached.Size[1] = slot.Glyph.Size.y;
+		cached.Bearing[0] = slot.Glyph.Bearing.x;
+		cached.Bearing[1] = slot.Glyph.Bearing.y;
+		cached.Advance = slot.Glyph.Advance;
+		cached.UVMin[0] = slot.Glyph.uvMin.x;
+		cached.UVMin[1] = slot.Glyph.uvMin.y;
+		cached.UVMax[0] = slot.Glyph.uvMax.x;
+		cached.UVMax[1] = slot.Glyph.uvMax.y;
+		cached.Page = slot.Glyph.Page;
+		glyphs.push_back(cached);
+	};
+
+	for (uint32_t c = 0; c < 256; ++c)
+		addSlot(c, m_Latin[c]);
+	for (const auto& [codepoint, slot]: m_Extended)
+		addSlot(codepoint, slot);
+
+	std::error_code ec;
+	std::filesystem::create_directories(std::filesystem::path(m_CachePath).parent_path(), ec);
+
+	std::ofstream file(m_CachePath, std::ios::binary | std::ios::trunc);
+	if (!file)
+	{
+		Logger::Warn("Font: Could not write cache " + m_CachePath);
+		return;
+	}
+
+	CacheHeader header = {};
+	header.Magic = CacheMagic;
+	header.Version = CacheVersion;
+	header.FileKey = m_FileKey;
+	header.FontSize = m_FontSize;
+	header.PageSize = PageSize;
+	header.Padding = GlyphPadding;
+	header.RenderMode = (uint32_t) GlyphRenderMode;
+	header.PageCount = (uint32_t) m_Pages.size();
+	header.GlyphCount = (uint32_t) glyphs.size();
+
+	file.write((const char*) &header, sizeof(header));
+	file.write((const char*) glyphs.data(), (std::streamsize) (glyphs.size() * sizeof(CacheGlyph)));
+	for (const auto& page: m_Pages)
+	{
+		uint32_t nodeCount = (uint32_t) page.Skyline.size();
+		file.write((const char*) &nodeCount, sizeof(nodeCount));
+		file.write((const char*) page.Skyline.data(), (std::streamsize) (nodeCount * sizeof(SkylineNode)));
+		file.write((const char*) page.Pixels.data(), (std::streamsize) page.Pixels.size());
+	}
+
+	m_CacheDirty = false;
+}
 
-		// Check if we need to move to the next row
-		// We add a 2 pixel padding to prevent texture bleeding
-		if (xOffset + width + 2 > atlasWidth)
+bool Font::AllocateRegion(uint32_t width, uint32_t height, uint32_t& outPage, uint32_t& outX, uint32_t& outY)
+{
+	if (width > PageSize || height > PageSize)
+	{
+		Logger::Error("ERROR::TEXT: Glyph does not fit in a font atlas page!");
+		return false;
+	}
+
+	size_t node = 0;
+	for (uint32_t i = 0; i < (uint32_t) m_Pages.size(); ++i)
+	{
+		if (FindSkylinePosition(m_Pages[i], width, height, outX, outY, node))
 		{
-			xOffset = 0;
-			yOffset += rowHeight + 2; // +2 padding
-			rowHeight = 0;
+			AddSkylineLevel(m_Pages[i], node, outX, outY, width, height);
+			m_Pages[i].LastUsedFrame = s_FrameIndex;
+			outPage = i;
+			return true;
 		}
+	}
 
-		// Check if we ran out of space in the texture
-		if (yOffset + height > atlasHeight)
+	// Every page is full: grow, or recycle the least recently drawn page not in use this frame
+	uint32_t target;
+	if (m_Pages.size() < MaxPages)
+	{
+		target = CreatePage();
+	}
+	else
+	{
+		target = UINT32_MAX;
+		for (uint32_t i = 0; i < (uint32_t) m_Pages.size(); ++i)
 		{
-			Logger::Error("ERROR::TEXT: Font Atlas is too small for this font size!");
-			break;
+			if (m_Pages[i].LastUsedFrame == s_FrameIndex)
+				continue;
+			if (target == UINT32_MAX || m_Pages[i].LastUsedFrame < m_Pages[target].LastUsedFrame)
+				target = i;
 		}
 
-		// Copy glyph bitmap into the atlas buffer
-		for (int row = 0; row < height; ++row)
+		if (target == UINT32_MAX)
 		{
-			for (int col = 0; col < width; ++col)
+			if (!m_WarnedFull)
 			{
-				// Source buffer is row-major
-				unsigned char byte = face->glyph->bitmap.buffer[row * width + col];
-
-				// Destination index in the large atlas
-				int index = (yOffset + row) * atlasWidth + (xOffset + col);
-				atlasData[index] = byte;
+				Logger::Warn("Font: Every atlas page is in use this frame; some glyphs will be skipped");
+				m_WarnedFull = true;
 			}
+			return false;
 		}
 
-		// 3. Store Character Data
-		Character character;
-		character.Size = glm::vec2(width, height);
-		character.Bearing = glm::vec2(face->glyph->bitmap_left, face->glyph->bitmap_top);
-		character.Advance = static_cast<unsigned int>(face->glyph->advance.x);
+		EvictPage(target);
+	}
 
-		// Calculate Normalized UV coordinates (0.0 to 1.0)
-		// Note: FreeType renders top-down.
-		// We map straightforwardly here, and the Renderer handles the quad vertex UV alignment.
+	if (!FindSkylinePosition(m_Pages[target], width, height, outX, outY, node))
+		return false;
 
-		float uMin = (float) xOffset / atlasWidth;
-		float vMin = (float) yOffset / atlasHeight;
-		float uMax = (float) (xOffset + width) / atlasWidth;
-		float vMax = (float) (yOffset + height) / atlasHeight;
+	AddSkylineLevel(m_Pages[target], node, outX, outY, width, height);
+	m_Pages[target].LastUsedFrame = s_FrameIndex;
+	outPage = target;
+	return true;
+}
 
-		// Store Top-Left and Bottom-Right UVs
-		character.uvMin = glm::vec2(uMin, vMin);
-		character.uvMax = glm::vec2(uMax, vMax);
+bool Font::FindSkylinePosition(const Page& page, uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY, size_t& outNode) const
+{
+	// Bottom-left rule: lowest resulting top edge, then the narrowest supporting segment
+	uint32_t bestTop = UINT32_MAX;
+	uint32_t bestWidth = UINT32_MAX;
+	bool found = false;
 
-		m_Characters.insert(std::pair<char, Character>(c, character));
+	const auto& nodes = page.Skyline;
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		uint32_t x = nodes[i].X;
+		if (x + width > PageSize)
+			break;
 
-		// Update packing cursor
-		rowHeight = std::max(rowHeight, height);
-		xOffset += width + 2; // +2 padding
-	}
+		// The rect rests on the highest segment it spans
+		uint32_t y = 0;
+		uint32_t spanned = 0;
+		for (size_t j = i; j < nodes.size() && spanned < width; ++j)
+		{
+			y = std::max(y, nodes[j].Y);
+			spanned += nodes[j].Width;
+		}
 
-	// 4. Create Texture
-	// Create and Upload Texture using the new Class
-	m_AtlasTexture = new Texture(atlasWidth, atlasHeight, TEX_FORMAT_R8_UNORM, Texture::Filter::Linear, Texture::Wrap::ClampToEdge);
+		if (y + height > PageSize)
+			continue;
 
-	// Upload the raw bitmap data we generated into the texture
-	m_AtlasTexture->SetData(atlasData.data(), (uint32_t) atlasData.size());
-}
+		if (y + height < bestTop || (y + height == bestTop && nodes[i].Width < bestWidth))
+		{
+			bestTop = y + height;
+			bestWidth = nodes[i].Width;
+			outX = x;
+			outY = y;
+			outNode = i;
+			found = true;
+		}
+	}
 
-glm::vec2 Font::CalculateSize(const std::string& text, float scale, float wrapWidth)
-{
-	glm::vec3 result = CalculateSizeWithBaseline(text, scale, wrapWidth);
-	return glm::vec2(result.x, result.y);
+	return found;
 }
 
-glm::vec3 Font::CalculateSizeWithBaseline(const std::string& text, float scale, float wrapWidth)
+void Font::AddSkylineLevel(Page& page, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
 {
-	glm::vec3 result(0.0f);
+	auto& nodes = page.Skyline;
+	nodes.insert(nodes.begin() + node, SkylineNode { x, y + height, width });
 
-	float currentLineX = 0.0f;
-	float maxLineWidth = 0.0f;
-	
-	float currentLineMaxY = 0.0f;
-	float currentLineMinY = 0.0f;
+	// Trim the segments now hidden under the new one
+	for (size_t i = node + 1; i < nodes.size();)
+	{
+		uint32_t prevEnd = nodes[i - 1].X + nodes[i - 1].Width;
+		if (nodes[i].X >= prevEnd)
+			break;
 
-	float firstLineMaxY = 0.0f;
-	bool isFirstLine = true;
-	int lineCount = 1;
+		uint32_t shrink = prevEnd - nodes[i].X;
+		if (nodes[i].Width <= shrink)
+		{
+			nodes.erase(nodes.begin() + i);
+			continue;
+		}
 
-	float lineSpacing = m_FontSize * scale; 
+		nodes[i].X += shrink;
+		nodes[i].Width -= shrink;
+		break;
+	}
 
-	auto it = text.begin();
-	while (it != text.end())
+	// Merge neighbours at the same height
+	for (size_t i = 0; i + 1 < nodes.size();)
 	{
-		// Identify a word
-		auto wordStart = it;
-		float wordWidth = 0.0f;
-		float wordMaxY = 0.0f;
-		float wordMinY = 0.0f;
-
-		// Calculate word dimensions
-		while (it != text.end())
+		if (nodes[i].Y == nodes[i + 1].Y)
+		{
+			nodes[i].Width += nodes[i + 1].Width;
+			nodes.erase(nodes.begin() + i + 1);
+		}
+		else
 		{
-			char c = *it;
-			if (c == ' ' || c == '\n') break;
+			++i;
+		}
+	}
+}
 
-			if (m_Characters.find(c) != m_Characters.end())
-			{
-				Character ch = m_Characters[c];
-				float h = ch.Size.y * scale;
-				float bearingY = ch.Bearing.y * scale;
+uint32_t Font::CreatePage()
+{
+	Page page;
+	page.Atlas = new Texture(PageSize, PageSize, TEX_FORMAT_R8_UNORM, Texture::Filter::Linear, Texture::Wrap::ClampToEdge);
+	page.Pixels.assign((size_t) PageSize * PageSize, 0);
+	page.Skyline.push_back({ 0, 0, PageSize });
 
-				if (bearingY > wordMaxY) wordMaxY = bearingY;
-				if ((h - bearingY) > wordMinY) wordMinY = (h - bearingY);
+	// The GPU texture starts undefined; clear it with the first upload
+	MarkDirty(page, 0, 0, PageSize, PageSize);
 
-				wordWidth += (ch.Advance >> 6) * scale;
-			}
-			it++;
-		}
+	m_PageTextures[m_Pages.size()] = page.Atlas;
+	m_Pages.push_back(std::move(page));
+	return (uint32_t) m_Pages.size() - 1;
+}
 
-		// Check for wrap (if not first word on line)
-		if (wrapWidth > 0.0f && currentLineX > 0.0f && (currentLineX + wordWidth > wrapWidth))
-		{
-			// Wrap
-			if (currentLineX > maxLineWidth) maxLineWidth = currentLineX;
-			
-			if (isFirstLine)
-			{
-				firstLineMaxY = currentLineMaxY;
-				isFirstLine = false;
-			}
+void Font::EvictPage(uint32_t pageIndex)
+{
+	Page& page = m_Pages[pageIndex];
+	std::fill(page.Pixels.begin(), page.Pixels.end(), (unsigned char) 0);
+	page.Skyline.clear();
+	page.Skyline.push_back({ 0, 0, PageSize });
+	MarkDirty(page, 0, 0, PageSize, PageSize);
 
-			lineCount++;
+	auto onPage = [pageIndex](const GlyphSlot& slot)
+	{
+		return slot.State == SlotState::Loaded && slot.Glyph.Size.x > 0.0f && slot.Glyph.Size.y > 0.0f && slot.Glyph.Page == pageIndex;
+	};
 
-			currentLineX = 0.0f;
-			currentLineMaxY = 0.0f;
-			currentLineMinY = 0.0f;
-		}
+	for (auto& slot: m_Latin)
+	{
+		if (onPage(slot))
+			slot.State = SlotState::Empty;
+	}
+
+	for (auto it = m_Extended.begin(); it != m_Extended.end();)
+	{
+		if (onPage(it->second))
+			it = m_Extended.erase(it);
+		else
+			++it;
+	}
 
-		// Add word to current line
-		currentLineX += wordWidth;
-		if (wordMaxY > currentLineMaxY) currentLineMaxY = wordMaxY;
-		if (wordMinY > currentLineMinY) currentLineMinY = wordMinY;
+	m_Generation++;
+	m_CacheDirty = true;
+}
 
-		// Handle delimiter
-		if (it != text.end())
-		{
-			char c = *it;
-			if (c == '\n')
-			{
-				if (currentLineX > maxLineWidth) maxLineWidth = currentLineX;
-				
-				if (isFirstLine)
-				{
-					firstLineMaxY = currentLineMaxY;
-					isFirstLine = false;
-				}
-
-				lineCount++;
-				currentLineX = 0.0f;
-				currentLineMaxY = 0.0f;
-				currentLineMinY = 0.0f;
-			}
-			else if (c == ' ' && m_Characters.find(' ') != m_Characters.end())
-			{
-				float spaceW = (m_Characters[' '].Advance >> 6) * scale;
-				currentLineX += spaceW;
-			}
-			it++;
-		}
+void Font::MarkDirty(Page& page, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	if (page.DirtyMinX >= page.DirtyMaxX)
+	{
+		page.DirtyMinX = x;
+		page.DirtyMinY = y;
+		page.DirtyMaxX = x + width;
+		page.DirtyMaxY = y + height;
+		return;
 	}
 
-	// Finalize
-	if (currentLineX > maxLineWidth) maxLineWidth = currentLineX;
-	if (isFirstLine) firstLineMaxY = currentLineMaxY;
+	page.DirtyMinX = std::min(page.DirtyMinX, x);
+	page.DirtyMinY = std::min(page.DirtyMinY, y);
+	page.DirtyMaxX = std::max(page.DirtyMaxX, x + width);
+	page.DirtyMaxY = std::max(page.DirtyMaxY, y + height);
+}
 
-	// Calculate total height
-	if (lineCount > 1)
-		result.y = firstLineMaxY + (float)(lineCount - 1) * lineSpacing + currentLineMinY;
-	else
-		result.y = firstLineMaxY + currentLineMinY;
+void Font::UploadDirtyPages()
+{
+	for (auto& page: m_Pages)
+	{
+		if (page.DirtyMinX >= page.DirtyMaxX)
+			continue;
+
+		const unsigned char* src = &page.Pixels[(size_t) page.DirtyMinY * PageSize + page.DirtyMinX];
+		page.Atlas->SetData(src, page.DirtyMinX, page.DirtyMinY, page.DirtyMaxX - page.DirtyMinX, page.DirtyMaxY - page.DirtyMinY, PageSize);
+
+		page.DirtyMinX = page.DirtyMaxX = 0;
+		page.DirtyMinY = page.DirtyMaxY = 0;
+	}
+}
 
-	result.x = maxLineWidth;
-	result.z = firstLineMaxY;
+glm::vec2 Font::CalculateSize(const std::string& text, float scale, float wrapWidth)
+{
+	glm::vec3 result = CalculateSizeWithBaseline(text, scale, wrapWidth);
+	return glm::vec2(result.x, result.y);
+}
 
-	return result;
+glm::vec3 Font::CalculateSizeWithBaseline(const std::string& text, float scale, float wrapWidth)
+{
+	// Shaping goes through the same path as drawing so measurement and rendering never disagree
+	TextLayout layout;
+	layout.Build(text, this, scale, wrapWidth);
+	return glm::vec3(layout.GetSize(), layout.GetMaxY());
 }
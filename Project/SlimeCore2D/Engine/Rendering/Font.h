@@ -1,7 +1,8 @@
 #pragma once
 
-#include <map>
+#include <cstdint>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 // FreeType Headers
@@ -21,24 +22,65 @@ struct Character
 	// Texture Coordinates in the Atlas
 	glm::vec2 uvMin; // Top-Left UV
 	glm::vec2 uvMax; // Bottom-Right UV
+	uint32_t Page = 0; // Atlas page holding the bitmap
 };
 
+// Glyphs are rasterized on first use into a small set of atlas pages (skyline packed).
+// Once every page is full, the least recently drawn page is wiped and refilled; any cached
+// TextLayout built against it notices through GetAtlasGeneration() and reshapes.
+// Shaping, the LRU and uploads all belong to the main thread. The render thread only samples the page
+// textures, and page uploads go through RenderThread::Post, so they never overlap the frame in flight.
 class Font
 {
 public:
-	// Constructor automatically loads the font and generates the atlas
-	Font(const std::string& fontPath, unsigned int fontSize = 48);
+	static constexpr uint32_t PageSize = 1024;
+	static constexpr uint32_t MaxPages = 4;
+
+	// Opens the font face. With a 'cacheDir', a previously saved atlas for the same font file and size is
+	// loaded from disk; otherwise printable ASCII is rasterized up front across the JobSystem workers.
+	// Anything else is rasterized the first time it is needed.
+	Font(const std::string& fontPath, unsigned int fontSize = 48, const std::string& cacheDir = "");
 	~Font();
 
-	// Getters for Renderer
-	Texture* GetAtlasTexture() const
+	Font(const Font&) = delete;
+	Font& operator=(const Font&) = delete;
+
+	// Call on the main thread before recording each frame. Pages touched while recording the current frame are
+	// never evicted, which pins every page its snapshot samples: a page evicted later is re-uploaded through
+	// RenderThread::Post, which only runs once that snapshot has been drawn.
+	static void BeginFrame();
+
+	// Returns the glyph for a Unicode codepoint, rasterizing it if needed.
+	// Null if the font has no such glyph or the atlas has no room left this frame.
+	const Character* GetGlyph(uint32_t codepoint);
+
+	// Marks a page as drawn this frame for the LRU.
+	void TouchPage(uint32_t page);
+
+	// Posts the sub-rect of every page written since the last call to the GPU.
+	void UploadDirtyPages();
+
+	// Rasterizes any of 'codepoints' not yet in the atlas, rendering them in parallel.
+	void Prewarm(const std::vector<uint32_t>& codepoints);
+
+	// Writes the atlas and glyph metrics to the cache file if glyphs were added since it was loaded or saved.
+	void SaveCache();
+
+	// Safe on the render thread for any page a recorded layout refers to
+	Texture* GetPageTexture(uint32_t page) const
+	{
+		return page < MaxPages ? m_PageTextures[page] : nullptr;
+	}
+
+	uint32_t GetPageCount() const
 	{
-		return m_AtlasTexture;
+		return (uint32_t) m_Pages.size();
 	}
 
-	const std::map<char, Character>& GetCharacters() const
+	// Bumped every time a page is evicted; glyph UVs from an older generation may be stale.
+	uint32_t GetAtlasGeneration() const
 	{
-		return m_Characters;
+		return m_Generation;
 	}
 
 	unsigned int GetFontSize() const
@@ -55,9 +97,71 @@ public:
 	glm::vec3 CalculateSizeWithBaseline(const std::string& text, float scale, float wrapWidth = 0.0f);
 
 private:
-	Texture* m_AtlasTexture = nullptr;
-	std::map<char, Character> m_Characters;
+	enum class SlotState : uint8_t
+	{
+		Empty,
+		Loaded,
+		Missing
+	};
+
+	struct GlyphSlot
+	{
+		Character Glyph;
+		SlotState State = SlotState::Empty;
+	};
+
+	struct SkylineNode
+	{
+		uint32_t X;
+		uint32_t Y;
+		uint32_t Width;
+	};
+
+	struct Page
+	{
+		Texture* Atlas = nullptr;
+		std::vector<unsigned char> Pixels; // CPU copy, R8
+		std::vector<SkylineNode> Skyline;
+		uint64_t LastUsedFrame = 0;
+
+		// Dirty rect, empty when DirtyMinX >= DirtyMaxX
+		uint32_t DirtyMinX = 0;
+		uint32_t DirtyMinY = 0;
+		uint32_t DirtyMaxX = 0;
+		uint32_t DirtyMaxY = 0;
+	};
+
+	struct RasterizedGlyph;
+
+	GlyphSlot& GetSlot(uint32_t codepoint);
+	bool RasterizeGlyph(uint32_t codepoint, GlyphSlot& slot);
+	bool StoreGlyph(const RasterizedGlyph& glyph, GlyphSlot& slot);
+	static void RenderGlyph(FT_Face face, uint32_t codepoint, RasterizedGlyph& out);
+	bool LoadCache();
+
+	bool AllocateRegion(uint32_t width, uint32_t height, uint32_t& outPage, uint32_t& outX, uint32_t& outY);
+	bool FindSkylinePosition(const Page& page, uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY, size_t& outNode) const;
+	void AddSkylineLevel(Page& page, size_t node, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+	uint32_t CreatePage();
+	void EvictPage(uint32_t page);
+	void MarkDirty(Page& page, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+
+	FT_Face m_Face = nullptr; // On the process-wide FreeType library
+	std::vector<unsigned char> m_FileData;
+	uint64_t m_FileKey = 0; // Hash of the font file's name and contents; keys the cache
 	unsigned int m_FontSize;
 
-	void GenerateAtlas(FT_Face face);
+	std::string m_CachePath;
+	bool m_CacheDirty = false;
+
+	// Latin-1 is direct-indexed; everything else goes through the hash map
+	GlyphSlot m_Latin[256];
+	std::unordered_map<uint32_t, GlyphSlot> m_Extended;
+
+	std::vector<Page> m_Pages;
+	Texture* m_PageTextures[MaxPages] = {}; // Fixed slots, so the render thread never reads m_Pages while it grows
+	uint32_t m_Generation = 0;
+	bool m_WarnedFull = false;
+
+	static uint64_t s_FrameIndex; // Main-thread recording frame, advanced by BeginFrame
 };
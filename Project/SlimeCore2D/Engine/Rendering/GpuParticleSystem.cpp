@@ -0,0 +1,415 @@
+#include "GpuParticleSystem.h"
+
+#include <algorithm>
+#include <random>
+#include <utility>
+
+#include "Core/Logger.h"
+#include "Core/Window.h"
+#include "DiligentCore/Graphics/GraphicsTools/interface/MapHelper.hpp"
+#include "ParticleSystem.h"
+#include "PipelineCache.h"
+#include "ResourceState.h"
+#include "Resources/ResourceManager.h"
+#include "Shader.h"
+
+namespace
+{
+	// Must match Particles.fxh
+	constexpr uint32_t ParticleStride = 24 * sizeof(float);
+	constexpr uint32_t CounterCount = 8;
+	constexpr uint32_t DrawArgsOffset = 16;
+	constexpr uint32_t EmitGroupSize = 64;
+	constexpr uint32_t MinEmitCapacity = 256;
+
+	struct ParticleConstants
+	{
+		float DeltaTime;
+		uint32_t EmitCount;
+		uint32_t MaxParticles;
+		uint32_t Seed;
+	};
+
+	struct GpuParticleData
+	{
+		RefCntAutoPtr<IPipelineState> PreparePSO;
+		RefCntAutoPtr<IPipelineState> EmitPSO;
+		RefCntAutoPtr<IPipelineState> SimulatePSO;
+		RefCntAutoPtr<IPipelineState> FinishPSO;
+		RefCntAutoPtr<IPipelineState> RenderPSO;
+		RefCntAutoPtr<IBuffer> Constants;
+		bool Supported = false;
+	};
+
+	GpuParticleData s_Data;
+
+	void BindVar(IShaderResourceBinding* srb, SHADER_TYPE stage, const char* name, IDeviceObject* object)
+	{
+		if (auto* var = srb->GetVariableByName(stage, name))
+			var->Set(object);
+	}
+
+	IDeviceObject* UAV(IBuffer* buffer)
+	{
+		return buffer->GetDefaultView(BUFFER_VIEW_UNORDERED_ACCESS);
+	}
+
+	IDeviceObject* SRV(IBuffer* buffer)
+	{
+		return buffer->GetDefaultView(BUFFER_VIEW_SHADER_RESOURCE);
+	}
+} // namespace
+
+static_assert(sizeof(ParticleConstants) == 16, "ParticleConstants must match ParticleCompute.hlsl");
+
+void GpuParticleSystem::Init(IBuffer* globalConstants)
+{
+	auto device = Window::GetDevice();
+	const DeviceFeatures& features = device->GetDeviceInfo().Features;
+	if (features.ComputeShaders == DEVICE_FEATURE_STATE_DISABLED || features.IndirectRendering == DEVICE_FEATURE_STATE_DISABLED)
+	{
+		Logger::Info("GpuParticleSystem: Compute shaders or indirect draws unavailable, particles stay on the CPU");
+		return;
+	}
+
+	auto& ResMgr = ResourceManager::GetInstance();
+	Shader* drawShader = ResMgr.GetShader("particle");
+	const std::string& shaderDir = ResMgr.GetShaderDirectory();
+	if (!drawShader || shaderDir.empty())
+	{
+		Logger::Warn("GpuParticleSystem: 'particle' shader not found, particles stay on the CPU");
+		return;
+	}
+
+	{
+		BufferDesc CBDesc;
+		CBDesc.Name = "GPU Particle Constants";
+		CBDesc.Size = sizeof(ParticleConstants);
+		CBDesc.Usage = USAGE_DYNAMIC;
+		CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+		CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+		device->CreateBuffer(CBDesc, nullptr, &s_Data.Constants);
+	}
+
+	// 1. Compute kernels, one entry point each from the same file
+	RefCntAutoPtr<IShaderSourceInputStreamFactory> sourceFactory;
+	Window::GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(shaderDir.c_str(), &sourceFactory);
+
+	auto createKernel = [&](const char* entryPoint, RefCntAutoPtr<IPipelineState>& outPSO)
+	{
+		ShaderCreateInfo ShaderCI;
+		ShaderCI.pShaderSourceStreamFactory = sourceFactory;
+		ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+		ShaderCI.Desc.UseCombinedTextureSamplers = false;
+		ShaderCI.Desc.ShaderType = SHADER_TYPE_COMPUTE;
+		ShaderCI.Desc.Name = entryPoint;
+		ShaderCI.FilePath = "ParticleCompute.hlsl";
+		ShaderCI.EntryPoint = entryPoint;
+
+		RefCntAutoPtr<IShader> shader;
+		PipelineCache::CreateShader(ShaderCI, &shader);
+		if (!shader)
+			return;
+
+		// Buffers differ per system, so everything but the constants lives in the SRBs.
+		// The upload buffer is recreated when it grows, hence dynamic.
+		ShaderResourceVariableDesc Vars[] = {
+			{ SHADER_TYPE_COMPUTE, "ParticleConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC },
+			{ SHADER_TYPE_COMPUTE, "Emits", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC }
+		};
+
+		ComputePipelineStateCreateInfo PSOCreateInfo;
+		PSOCreateInfo.PSODesc.Name = entryPoint;
+		PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_COMPUTE;
+		PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+		PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+		PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+		PSOCreateInfo.pCS = shader;
+
+		PipelineCache::CreateComputePipelineState(PSOCreateInfo, &outPSO);
+		if (outPSO)
+		{
+			if (auto* pVar = outPSO->GetStaticVariableByName(SHADER_TYPE_COMPUTE, "ParticleConstants"))
+				pVar->Set(s_Data.Constants);
+		}
+	};
+
+	createKernel("Prepare", s_Data.PreparePSO);
+	createKernel("Emit", s_Data.EmitPSO);
+	createKernel("Simulate", s_Data.SimulatePSO);
+	createKernel("Finish", s_Data.FinishPSO);
+
+	// 2. Draw pipeline: quads expanded from the vertex id, no vertex buffer
+	{
+		GraphicsPipelineStateCreateInfo PSOCreateInfo;
+		PSOCreateInfo.PSODesc.Name = "GPU Particle PSO";
+		PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
+		PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+		PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = TEX_FORMAT_RGBA8_UNORM;
+		PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_D24_UNORM_S8_UINT;
+		PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
+		PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = false;
+
+		PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = true;
+		PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend = BLEND_FACTOR_SRC_ALPHA;
+		PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlend = BLEND_FACTOR_INV_SRC_ALPHA;
+
+		PSOCreateInfo.pVS = drawShader->GetVertexShader();
+		PSOCreateInfo.pPS = drawShader->GetPixelShader();
+
+		ShaderResourceVariableDesc Vars[] = {
+			{ SHADER_TYPE_VERTEX, "GlobalConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC }
+		};
+		PSOCreateInfo.PSODesc.ResourceLayout.DefaultVariableType = SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE;
+		PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+		PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+		PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.RenderPSO);
+		if (s_Data.RenderPSO)
+		{
+			if (auto* pVar = s_Data.RenderPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "GlobalConstants"))
+				pVar->Set(globalConstants);
+		}
+	}
+
+	s_Data.Supported = s_Data.PreparePSO && s_Data.EmitPSO && s_Data.SimulatePSO && s_Data.FinishPSO && s_Data.RenderPSO;
+	if (!s_Data.Supported)
+		Logger::Warn("GpuParticleSystem: Failed to build the particle pipelines, particles stay on the CPU");
+}
+
+void GpuParticleSystem::Shutdown()
+{
+	s_Data = GpuParticleData();
+}
+
+bool GpuParticleSystem::IsSupported()
+{
+	return s_Data.Supported;
+}
+
+GpuParticleSystem::GpuParticleSystem(uint32_t maxParticles)
+      : m_MaxParticles(std::max(maxParticles, 1u)), m_Seed(std::random_device()())
+{
+	auto device = Window::GetDevice();
+
+	auto createBuffer = [&](const char* name, uint32_t stride, uint32_t count, BIND_FLAGS bindFlags, BUFFER_MODE mode, const void* data, RefCntAutoPtr<IBuffer>& outBuffer)
+	{
+		BufferDesc Desc;
+		Desc.Name = name;
+		Desc.Usage = USAGE_DEFAULT;
+		Desc.BindFlags = bindFlags;
+		Desc.Mode = mode;
+		Desc.ElementByteStride = stride;
+		Desc.Size = (Uint64) stride * count;
+
+		BufferData Data;
+		Data.pData = data;
+		Data.DataSize = Desc.Size;
+		device->CreateBuffer(Desc, data ? &Data : nullptr, &outBuffer);
+	};
+
+	const BIND_FLAGS readWrite = BIND_SHADER_RESOURCE | BIND_UNORDERED_ACCESS;
+
+	// Every slot starts dead; emission takes from the end of the list
+	std::vector<uint32_t> deadList(m_MaxParticles);
+	for (uint32_t i = 0; i < m_MaxParticles; ++i)
+		deadList[i] = m_MaxParticles - 1 - i;
+
+	uint32_t counters[CounterCount] = { m_MaxParticles };
+	uint32_t args[8] = { 0, 1, 1, 0, 6, 0, 0, 0 }; // Simulate dispatch, then the draw (see Particles.fxh)
+
+	createBuffer("GPU Particles", ParticleStride, m_MaxParticles, readWrite, BUFFER_MODE_STRUCTURED, nullptr, m_Particles);
+	createBuffer("GPU Particle Dead List", sizeof(uint32_t), m_MaxParticles, readWrite, BUFFER_MODE_STRUCTURED, deadList.data(), m_DeadList);
+	createBuffer("GPU Particle Alive List A", sizeof(uint32_t), m_MaxParticles, readWrite, BUFFER_MODE_STRUCTURED, nullptr, m_AliveLists[0]);
+	createBuffer("GPU Particle Alive List B", sizeof(uint32_t), m_MaxParticles, readWrite, BUFFER_MODE_STRUCTURED, nullptr, m_AliveLists[1]);
+	createBuffer("GPU Particle Counters", sizeof(uint32_t), CounterCount, readWrite, BUFFER_MODE_STRUCTURED, counters, m_Counters);
+	createBuffer("GPU Particle Indirect Args", sizeof(uint32_t), 8, BIND_UNORDERED_ACCESS | BIND_INDIRECT_DRAW_ARGS, BUFFER_MODE_RAW, args, m_IndirectArgs);
+
+	if (!s_Data.Supported || !m_Particles || !m_DeadList || !m_AliveLists[0] || !m_AliveLists[1] || !m_Counters || !m_IndirectArgs)
+		return;
+
+	// Binding every buffer to every kernel keeps this independent of which ones a kernel actually reads
+	auto bindCompute = [&](IPipelineState* pso, RefCntAutoPtr<IShaderResourceBinding>& outSRB, uint32_t parity)
+	{
+		pso->CreateShaderResourceBinding(&outSRB, true);
+		BindVar(outSRB, SHADER_TYPE_COMPUTE, "Particles", UAV(m_Particles));
+		BindVar(outSRB, SHADER_TYPE_COMPUTE, "DeadList", UAV(m_DeadList));
+		BindVar(outSRB, SHADER_TYPE_COMPUTE, "AliveIn", UAV(m_AliveLists[parity]));
+		BindVar(outSRB, SHADER_TYPE_COMPUTE, "AliveOut", UAV(m_AliveLists[parity ^ 1]));
+		BindVar(outSRB, SHADER_TYPE_COMPUTE, "Counters", UAV(m_Counters));
+		BindVar(outSRB, SHADER_TYPE_COMPUTE, "IndirectArgs", UAV(m_IndirectArgs));
+	};
+
+	bindCompute(s_Data.PreparePSO, m_PrepareSRB, 0);
+	bindCompute(s_Data.FinishPSO, m_FinishSRB, 0);
+	for (uint32_t parity = 0; parity < 2; ++parity)
+	{
+		bindCompute(s_Data.EmitPSO, m_EmitSRB[parity], parity);
+		bindCompute(s_Data.SimulatePSO, m_SimulateSRB[parity], parity);
+
+		s_Data.RenderPSO->CreateShaderResourceBinding(&m_RenderSRB[parity], true);
+		BindVar(m_RenderSRB[parity], SHADER_TYPE_VERTEX, "Particles", SRV(m_Particles));
+		BindVar(m_RenderSRB[parity], SHADER_TYPE_VERTEX, "AliveList", SRV(m_AliveLists[parity]));
+	}
+}
+
+void GpuParticleSystem::Emit(const ParticleProps& props)
+{
+	if (m_PendingEmits.size() >= m_MaxParticles)
+		return;
+
+	EmitRecord& record = m_PendingEmits.emplace_back();
+	record.Position = props.Position;
+	record.Velocity = props.Velocity;
+	record.VelocityVariation = props.VelocityVariation;
+	record.Padding = glm::vec2(0.0f);
+	record.ColorBegin = props.ColorBegin;
+	record.ColorEnd = props.ColorEnd;
+	record.SizeBegin = props.SizeBegin;
+	record.SizeEnd = props.SizeEnd;
+	record.SizeVariation = props.SizeVariation;
+	record.LifeTime = props.LifeTime;
+}
+
+void GpuParticleSystem::EnsureEmitCapacity(uint32_t count)
+{
+	if (count <= m_EmitCapacity && m_Emits)
+		return;
+
+	uint32_t capacity = std::max(m_EmitCapacity, MinEmitCapacity);
+	while (capacity < count)
+		capacity *= 2;
+
+	m_Emits.Release();
+
+	BufferDesc Desc;
+	Desc.Name = "GPU Particle Emits";
+	Desc.Usage = USAGE_DEFAULT;
+	Desc.BindFlags = BIND_SHADER_RESOURCE;
+	Desc.Mode = BUFFER_MODE_STRUCTURED;
+	Desc.ElementByteStride = sizeof(EmitRecord);
+	Desc.Size = (Uint64) capacity * sizeof(EmitRecord);
+	Window::GetDevice()->CreateBuffer(Desc, nullptr, &m_Emits);
+
+	m_EmitCapacity = m_Emits ? capacity : 0;
+}
+
+void GpuParticleSystem::TransitionForCompute()
+{
+	// UAV -> UAV is a UAV barrier, so each pass sees everything the previous one wrote
+	StateTransitionDesc Barriers[] = {
+		{ m_Particles, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE },
+		{ m_DeadList, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE },
+		{ m_AliveLists[0], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE },
+		{ m_AliveLists[1], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE },
+		{ m_Counters, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE },
+		{ m_IndirectArgs, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_UNORDERED_ACCESS, STATE_TRANSITION_FLAG_UPDATE_STATE }
+	};
+	Window::GetContext()->TransitionResourceStates(_countof(Barriers), Barriers);
+}
+
+void GpuParticleSystem::Update(float ts)
+{
+	m_PendingTime += ts;
+}
+
+void GpuParticleSystem::TakeStep(Step& out)
+{
+	out.Emits.clear();
+	std::swap(out.Emits, m_PendingEmits);
+	out.DeltaTime = m_PendingTime;
+	m_PendingTime = 0.0f;
+}
+
+void GpuParticleSystem::Simulate(const Step& step)
+{
+	if (!m_PrepareSRB)
+		return;
+
+	auto context = Window::GetContext();
+
+	// 1. This frame's emissions in one upload
+	uint32_t emitCount = (uint32_t) step.Emits.size();
+	if (emitCount > 0)
+	{
+		EnsureEmitCapacity(emitCount);
+		if (!m_Emits)
+			emitCount = 0;
+		else
+		{
+			context->UpdateBuffer(m_Emits, 0, emitCount * sizeof(EmitRecord), step.Emits.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+			ResourceState::Request(m_Emits, RESOURCE_STATE_SHADER_RESOURCE);
+			ResourceState::Flush();
+		}
+	}
+
+	m_Seed = m_Seed * 1664525u + 1013904223u;
+	{
+		MapHelper<ParticleConstants> CBData(context, s_Data.Constants, MAP_WRITE, MAP_FLAG_DISCARD);
+		CBData->DeltaTime = step.DeltaTime;
+		CBData->EmitCount = emitCount;
+		CBData->MaxParticles = m_MaxParticles;
+		CBData->Seed = m_Seed;
+	}
+
+	// 2. Prepare: claim dead slots for the emissions, size the simulate dispatch
+	TransitionForCompute();
+	context->SetPipelineState(s_Data.PreparePSO);
+	context->CommitShaderResources(m_PrepareSRB, ResourceState::BindMode);
+	context->DispatchCompute(DispatchComputeAttribs(1, 1, 1));
+
+	// 3. Emit
+	if (emitCount > 0)
+	{
+		TransitionForCompute();
+		context->SetPipelineState(s_Data.EmitPSO);
+		BindVar(m_EmitSRB[m_Parity], SHADER_TYPE_COMPUTE, "Emits", SRV(m_Emits));
+		context->CommitShaderResources(m_EmitSRB[m_Parity], ResourceState::BindMode);
+		context->DispatchCompute(DispatchComputeAttribs((emitCount + EmitGroupSize - 1) / EmitGroupSize, 1, 1));
+	}
+
+	// 4. Simulate, sized on the GPU by Prepare
+	TransitionForCompute();
+	context->SetPipelineState(s_Data.SimulatePSO);
+	context->CommitShaderResources(m_SimulateSRB[m_Parity], ResourceState::BindMode);
+
+	DispatchComputeIndirectAttribs DispatchAttrs;
+	DispatchAttrs.pAttribsBuffer = m_IndirectArgs;
+	DispatchAttrs.AttribsBufferStateTransitionMode = RESOURCE_STATE_TRANSITION_MODE_TRANSITION;
+	DispatchAttrs.DispatchArgsByteOffset = 0;
+	context->DispatchComputeIndirect(DispatchAttrs);
+
+	// 5. Finish: the compacted list becomes current and feeds the draw
+	TransitionForCompute();
+	context->SetPipelineState(s_Data.FinishPSO);
+	context->CommitShaderResources(m_FinishSRB, ResourceState::BindMode);
+	context->DispatchCompute(DispatchComputeAttribs(1, 1, 1));
+
+	m_Parity ^= 1;
+}
+
+void GpuParticleSystem::Render()
+{
+	if (!m_RenderSRB[m_Parity])
+		return;
+
+	auto context = Window::GetContext();
+
+	StateTransitionDesc Barriers[] = {
+		{ m_Particles, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE },
+		{ m_AliveLists[m_Parity], RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_SHADER_RESOURCE, STATE_TRANSITION_FLAG_UPDATE_STATE },
+		{ m_IndirectArgs, RESOURCE_STATE_UNKNOWN, RESOURCE_STATE_INDIRECT_ARGUMENT, STATE_TRANSITION_FLAG_UPDATE_STATE }
+	};
+	context->TransitionResourceStates(_countof(Barriers), Barriers);
+
+	context->SetPipelineState(s_Data.RenderPSO);
+	context->CommitShaderResources(m_RenderSRB[m_Parity], ResourceState::BindMode);
+
+	DrawIndirectAttribs DrawAttrs;
+	DrawAttrs.pAttribsBuffer = m_IndirectArgs;
+	DrawAttrs.DrawArgsOffset = DrawArgsOffset;
+	DrawAttrs.Flags = ResourceState::DrawFlags;
+	DrawAttrs.AttribsBufferStateTransitionMode = ResourceState::BindMode;
+	context->DrawIndirect(DrawAttrs);
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm.hpp>
+
+#include "Buffer.h"
+#include "RefCntAutoPtr.hpp"
+#include "ShaderResourceBinding.h"
+
+using namespace Diligent;
+
+struct ParticleProps;
+
+// Particle pool that lives entirely on the GPU.
+// Emit() and Update() only queue emissions and time on the main thread. TakeStep() hands them to the frame being
+// recorded, and on the render thread Simulate() uploads them in one call and runs the kernels in
+// ParticleCompute.hlsl (prepare, emit, simulate with compaction, finish). Render() then draws the live
+// particles with one indirect instanced draw. The CPU never reads or writes a particle.
+class GpuParticleSystem
+{
+public:
+	// Matches GpuEmit in Particles.fxh
+	struct EmitRecord
+	{
+		glm::vec2 Position;
+		glm::vec2 Velocity;
+		glm::vec2 VelocityVariation;
+		glm::vec2 Padding;
+		glm::vec4 ColorBegin;
+		glm::vec4 ColorEnd;
+		float SizeBegin;
+		float SizeEnd;
+		float SizeVariation;
+		float LifeTime;
+	};
+
+	// Everything queued for one simulation step
+	struct Step
+	{
+		std::vector<EmitRecord> Emits;
+		float DeltaTime = 0.0f;
+	};
+
+	// Builds the shared compute and draw pipelines. 'globalConstants' holds the scene's view-projection.
+	static void Init(IBuffer* globalConstants);
+	static void Shutdown();
+
+	// False when the device lacks compute shaders or indirect draws, or the pipelines failed to build
+	static bool IsSupported();
+
+	explicit GpuParticleSystem(uint32_t maxParticles);
+
+	GpuParticleSystem(const GpuParticleSystem&) = delete;
+	GpuParticleSystem& operator=(const GpuParticleSystem&) = delete;
+
+	// Requests beyond the pool size in one frame are dropped, as are emissions while the pool is full
+	void Emit(const ParticleProps& props);
+	void Update(float ts);
+
+	// Moves the queued emissions and time into 'out' and starts a new queue
+	void TakeStep(Step& out);
+
+	// Runs the compute passes for 'step'. Render thread.
+	void Simulate(const Step& step);
+
+	// Issues the indirect draw; use Renderer::DrawGpuParticles so the 2D batch is flushed first
+	void Render();
+
+	uint32_t GetMaxParticles() const
+	{
+		return m_MaxParticles;
+	}
+
+private:
+	void EnsureEmitCapacity(uint32_t count);
+	void TransitionForCompute();
+
+	uint32_t m_MaxParticles;
+	uint32_t m_Parity = 0; // Alive list Simulate reads next and Render draws
+	uint32_t m_Seed;
+
+	std::vector<EmitRecord> m_PendingEmits;
+	float m_PendingTime = 0.0f;
+	uint32_t m_EmitCapacity = 0;
+
+	RefCntAutoPtr<IBuffer> m_Particles;
+	RefCntAutoPtr<IBuffer> m_DeadList;
+	RefCntAutoPtr<IBuffer> m_AliveLists[2];
+	RefCntAutoPtr<IBuffer> m_Counters;
+	RefCntAutoPtr<IBuffer> m_IndirectArgs;
+	RefCntAutoPtr<IBuffer> m_Emits;
+
+	RefCntAutoPtr<IShaderResourceBinding> m_PrepareSRB;
+	RefCntAutoPtr<IShaderResourceBinding> m_FinishSRB;
+	RefCntAutoPtr<IShaderResourceBinding> m_EmitSRB[2];
+	RefCntAutoPtr<IShaderResourceBinding> m_SimulateSRB[2];
+	RefCntAutoPtr<IShaderResourceBinding> m_RenderSRB[2];
+};
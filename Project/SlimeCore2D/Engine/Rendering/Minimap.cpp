@@ -0,0 +1,129 @@
+#include "Minimap.h"
+
+#include <algorithm>
+
+#include "RenderSnapshot.h"
+#include "Texture.h"
+
+static uint32_t PackColor(const glm::vec4& color)
+{
+	glm::vec4 c = glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f;
+	return (uint32_t) c.r | ((uint32_t) c.g << 8) | ((uint32_t) c.b << 16) | ((uint32_t) c.a << 24);
+}
+
+Minimap::Minimap(uint32_t width, uint32_t height)
+      : m_Width(std::max(width, 1u)), m_Height(std::max(height, 1u))
+{
+	m_BlocksX = (m_Width + BlockSize - 1) / BlockSize;
+	m_BlocksY = (m_Height + BlockSize - 1) / BlockSize;
+
+	m_Types.assign((size_t) m_Width * m_Height, 255);
+	m_Pixels.assign((size_t) m_Width * m_Height, 0);
+	m_Blocks.resize((size_t) m_BlocksX * m_BlocksY);
+
+	m_Texture = new Texture(m_Width, m_Height, TEX_FORMAT_RGBA8_UNORM, Texture::Filter::Nearest, Texture::Wrap::ClampToEdge);
+	m_Texture->SetData(m_Pixels.data(), (uint32_t) (m_Pixels.size() * sizeof(uint32_t)));
+}
+
+Minimap::~Minimap()
+{
+	delete m_Texture;
+}
+
+void Minimap::SetTypeColor(uint8_t type, const glm::vec4& color)
+{
+	uint32_t packed = PackColor(color);
+	if (m_Palette[type] == packed)
+		return;
+
+	m_Palette[type] = packed;
+	m_PaletteDirty = true;
+}
+
+void Minimap::SetTile(uint32_t x, uint32_t y, uint8_t type)
+{
+	if (x >= m_Width || y >= m_Height)
+		return;
+
+	size_t index = (size_t) y * m_Width + x;
+	m_Types[index] = type;
+	WriteTexel(index, x, y);
+}
+
+void Minimap::Refresh(const uint8_t* types, size_t stride)
+{
+	for (uint32_t y = 0; y < m_Height; ++y)
+	{
+		for (uint32_t x = 0; x < m_Width; ++x)
+		{
+			size_t index = (size_t) y * m_Width + x;
+			m_Types[index] = types[index * stride];
+			WriteTexel(index, x, y);
+		}
+	}
+}
+
+void Minimap::WriteTexel(size_t index, uint32_t x, uint32_t y)
+{
+	uint32_t rgba = m_Palette[m_Types[index]];
+	if (m_Pixels[index] == rgba)
+		return;
+
+	m_Pixels[index] = rgba;
+	MarkDirty(x, y);
+}
+
+void Minimap::MarkDirty(uint32_t x, uint32_t y)
+{
+	uint32_t index = (y / BlockSize) * m_BlocksX + (x / BlockSize);
+	DirtyRect& rect = m_Blocks[index];
+
+	if (!rect.Listed)
+	{
+		rect = { x, y, x + 1, y + 1, true };
+		m_DirtyBlocks.push_back(index);
+		return;
+	}
+
+	rect.MinX = std::min(rect.MinX, x);
+	rect.MinY = std::min(rect.MinY, y);
+	rect.MaxX = std::max(rect.MaxX, x + 1);
+	rect.MaxY = std::max(rect.MaxY, y + 1);
+}
+
+void Minimap::Upload()
+{
+	if (m_PaletteDirty)
+	{
+		m_PaletteDirty = false;
+		for (uint32_t y = 0; y < m_Height; ++y)
+		{
+			for (uint32_t x = 0; x < m_Width; ++x)
+				WriteTexel((size_t) y * m_Width + x, x, y);
+		}
+	}
+
+	for (uint32_t index: m_DirtyBlocks)
+	{
+		DirtyRect& rect = m_Blocks[index];
+		m_Texture->SetData(&m_Pixels[(size_t) rect.MinY * m_Width + rect.MinX], rect.MinX, rect.MinY, rect.MaxX - rect.MinX, rect.MaxY - rect.MinY, m_Width * sizeof(uint32_t));
+		rect.Listed = false;
+	}
+	m_DirtyBlocks.clear();
+}
+
+void Minimap::Draw(RenderSnapshot& snapshot, const glm::vec3& position, const glm::vec2& size, const glm::vec4& tint)
+{
+	Upload();
+
+	snapshot.DrawQuad(position, size, m_Texture, 1.0f, tint);
+
+	// Markers share the batch: untextured quads only use the white slot
+	glm::vec2 origin = glm::vec2(position) - size * 0.5f;
+	glm::vec2 texel = size / glm::vec2((float) m_Width, (float) m_Height);
+	for (const Marker& marker: m_Markers)
+	{
+		glm::vec2 center = origin + marker.Position * texel;
+		snapshot.DrawQuad(glm::vec3(center, position.z), texel * marker.Size, marker.Color);
+	}
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <glm.hpp>
+
+class RenderSnapshot;
+class Texture;
+
+// Overview texture with one texel per tile, coloured by tile type.
+// Edits are collected as dirty rects, one per touched 32x32 block, and Upload() pushes just those
+// sub-regions, so the per-frame cost follows the number of edits rather than the map area.
+// Markers (actors, pings) are a per-frame point batch drawn over the texture.
+class Minimap
+{
+public:
+	static constexpr uint32_t BlockSize = 32;
+
+	struct Marker
+	{
+		glm::vec2 Position; // In tiles, from the map's bottom-left
+		glm::vec4 Color;
+		float Size;         // In tiles
+	};
+
+	Minimap(uint32_t width, uint32_t height);
+	~Minimap();
+
+	Minimap(const Minimap&) = delete;
+	Minimap& operator=(const Minimap&) = delete;
+
+	// Colour drawn for a tile type; types without one stay transparent.
+	// Changing the palette recolours the whole map on the next Upload().
+	void SetTypeColor(uint8_t type, const glm::vec4& color);
+
+	void SetTile(uint32_t x, uint32_t y, uint8_t type);
+
+	// Copies every tile type from 'types', 'stride' bytes apart, row-major from the bottom-left.
+	void Refresh(const uint8_t* types, size_t stride);
+
+	// Markers are drawn by every Draw() until ClearMarkers(), which the owner calls once per frame after all
+	// views of the map are recorded (Scene::RenderUI), so several UI images of one minimap all show them.
+	void AddMarker(const Marker& marker)
+	{
+		m_Markers.push_back(marker);
+	}
+
+	void ClearMarkers()
+	{
+		m_Markers.clear();
+	}
+
+	// Pushes every dirty rect to the texture.
+	void Upload();
+
+	// Uploads, then records the map as one quad centred on 'position' and the markers on top.
+	void Draw(RenderSnapshot& snapshot, const glm::vec3& position, const glm::vec2& size, const glm::vec4& tint = glm::vec4(1.0f));
+
+	Texture* GetTexture() const
+	{
+		return m_Texture;
+	}
+
+	uint32_t GetWidth() const
+	{
+		return m_Width;
+	}
+
+	uint32_t GetHeight() const
+	{
+		return m_Height;
+	}
+
+private:
+	struct DirtyRect
+	{
+		uint32_t MinX = 0;
+		uint32_t MinY = 0;
+		uint32_t MaxX = 0; // Exclusive
+		uint32_t MaxY = 0;
+		bool Listed = false;
+	};
+
+	void WriteTexel(size_t index, uint32_t x, uint32_t y);
+	void MarkDirty(uint32_t x, uint32_t y);
+
+	uint32_t m_Width;
+	uint32_t m_Height;
+	uint32_t m_BlocksX;
+	uint32_t m_BlocksY;
+
+	std::vector<uint8_t> m_Types;
+	std::vector<uint32_t> m_Pixels; // RGBA8, row 0 at the bottom to match the tile rows
+	std::vector<DirtyRect> m_Blocks;
+	std::vector<uint32_t> m_DirtyBlocks;
+
+	uint32_t m_Palette[256] = {};
+	bool m_PaletteDirty = false;
+	std::vector<Marker> m_Markers;
+
+	Texture* m_Texture = nullptr;
+};
@@ -1,9 +1,13 @@
 #include "ParticleSystem.h"
-#include "Rendering/Renderer.h"
+#include "Core/Logger.h"
+#include "Core/RenderThread.h"
+#include "Rendering/GpuParticleSystem.h"
+#include "Rendering/RenderSnapshot.h"
 
 #include <random>
 
 #define GLM_ENABLE_EXPERIMENTAL
+#include <gtc/matrix_transform.hpp>
 #include <gtx/compatibility.hpp>
 
 class Random
@@ -27,14 +31,38 @@ private:
 std::mt19937 Random::s_RandomEngine;
 std::uniform_int_distribution<std::mt19937::result_type> Random::s_Distribution;
 
-ParticleSystem::ParticleSystem(uint32_t maxParticles)
+ParticleSystem::ParticleSystem(uint32_t maxParticles, ParticleBackend backend)
       : m_PoolIndex(maxParticles - 1)
 {
+	if (backend == ParticleBackend::GPU)
+	{
+		if (GpuParticleSystem::IsSupported())
+		{
+			m_Gpu = std::make_unique<GpuParticleSystem>(maxParticles);
+			return;
+		}
+
+		Logger::Warn("ParticleSystem: GPU particles unavailable on this device, using the CPU path");
+	}
+
 	m_ParticlePool.resize(maxParticles);
 }
 
+ParticleSystem::~ParticleSystem()
+{
+	// The frame in flight may still be simulating the GPU pool
+	if (m_Gpu)
+		RenderThread::Wait();
+}
+
 void ParticleSystem::OnUpdate(float ts)
 {
+	if (m_Gpu)
+	{
+		m_Gpu->Update(ts);
+		return;
+	}
+
 	for (auto& particle: m_ParticlePool)
 	{
 		if (!particle.Active)
@@ -52,8 +80,14 @@ void ParticleSystem::OnUpdate(float ts)
 	}
 }
 
-void ParticleSystem::OnRender()
+void ParticleSystem::OnRender(RenderSnapshot& snapshot)
 {
+	if (m_Gpu)
+	{
+		snapshot.DrawGpuParticles(*m_Gpu);
+		return;
+	}
+
 	for (auto& particle: m_ParticlePool)
 	{
 		if (!particle.Active)
@@ -64,12 +98,23 @@ void ParticleSystem::OnRender()
 
 		float size = glm::lerp(particle.SizeEnd, particle.SizeBegin, life);
 
-		Renderer::DrawRotatedQuad({ particle.Position.x, particle.Position.y, -0.01f }, { size, size }, particle.Rotation, color);
+		// Same transform as Renderer::DrawRotatedQuad, but the rotation is already in radians
+		Renderer::SpriteInstance& sprite = *snapshot.AddSprites(1);
+		sprite.Transform = glm::translate(glm::mat4(1.0f), { particle.Position.x, particle.Position.y, -0.01f })
+		                 * glm::rotate(glm::mat4(1.0f), particle.Rotation, { 0.0f, 0.0f, 1.0f })
+		                 * glm::scale(glm::mat4(1.0f), { size, size, 1.0f });
+		sprite.Color = color;
 	}
 }
 
 void ParticleSystem::Emit(const ParticleProps& particleProps)
 {
+	if (m_Gpu)
+	{
+		m_Gpu->Emit(particleProps);
+		return;
+	}
+
 	Particle& particle = m_ParticlePool[m_PoolIndex];
 	particle.Active = true;
 	particle.Position = particleProps.Position;
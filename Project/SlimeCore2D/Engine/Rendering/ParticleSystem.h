@@ -1,8 +1,12 @@
 #pragma once
 
 #include <glm.hpp>
+#include <memory>
 #include <vector>
 
+class GpuParticleSystem;
+class RenderSnapshot;
+
 struct ParticleProps
 {
 	glm::vec2 Position;
@@ -12,23 +16,38 @@ struct ParticleProps
 	float LifeTime = 1.0f;
 };
 
+// GPU runs emit, simulation and drawing in compute shaders (see GpuParticleSystem).
+// It falls back to CPU when the device can't do compute or indirect draws.
+enum class ParticleBackend
+{
+	CPU,
+	GPU
+};
+
 class ParticleSystem
 {
 public:
-	ParticleSystem(uint32_t maxParticles = 10000);
+	ParticleSystem(uint32_t maxParticles = 10000, ParticleBackend backend = ParticleBackend::CPU);
+	~ParticleSystem();
 
 	void OnUpdate(float ts);
-	void OnRender();
+	// Records the live particles; the GPU backend records its simulation step too
+	void OnRender(RenderSnapshot& snapshot);
 
 	void Emit(const ParticleProps& particleProps);
 
+	ParticleBackend GetBackend() const
+	{
+		return m_Gpu ? ParticleBackend::GPU : ParticleBackend::CPU;
+	}
+
 private:
 	struct Particle
 	{
 		glm::vec2 Position;
 		glm::vec2 Velocity;
 		glm::vec4 ColorBegin, ColorEnd;
-		float Rotation = 0.0f;
+		float Rotation = 0.0f; // Radians, as in ParticleCompute.hlsl
 		float SizeBegin, SizeEnd;
 
 		float LifeTime = 1.0f;
@@ -39,4 +58,6 @@ private:
 
 	std::vector<Particle> m_ParticlePool;
 	uint32_t m_PoolIndex = 9999;
+
+	std::unique_ptr<GpuParticleSystem> m_Gpu;
 };
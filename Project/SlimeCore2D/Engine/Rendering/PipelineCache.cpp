@@ -0,0 +1,230 @@
+#include "PipelineCache.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include "Core/Logger.h"
+#include "Core/Timing.h"
+#include "Core/Window.h"
+#include "DiligentCore/Common/interface/DataBlobImpl.hpp"
+#include "DiligentTools/RenderStateCache/interface/RenderStateCache.h"
+#include "RefCntAutoPtr.hpp"
+#include "Resources/ResourceManager.h"
+
+namespace
+{
+	// Bump to drop every cache written by an older build
+	constexpr Uint32 CacheContentVersion = 1;
+
+	struct PipelineCacheData
+	{
+		RefCntAutoPtr<IRenderStateCache> StateCache;
+		RefCntAutoPtr<IPipelineStateCache> DriverCache;
+		std::string StatePath;
+		std::string DriverPath;
+
+		PipelineCache::Stats Stats;
+		bool Loaded = false;
+		bool Dirty = false;
+		std::chrono::steady_clock::time_point Start;
+	};
+
+	PipelineCacheData s_Data;
+
+	const char* BackendName(RENDER_DEVICE_TYPE type)
+	{
+		switch (type)
+		{
+			case RENDER_DEVICE_TYPE_D3D11: return "D3D11";
+			case RENDER_DEVICE_TYPE_D3D12: return "D3D12";
+			case RENDER_DEVICE_TYPE_GL: return "GL";
+			case RENDER_DEVICE_TYPE_GLES: return "GLES";
+			case RENDER_DEVICE_TYPE_VULKAN: return "Vulkan";
+			case RENDER_DEVICE_TYPE_METAL: return "Metal";
+			default: return "Unknown";
+		}
+	}
+
+	std::vector<uint8_t> ReadFile(const std::string& path)
+	{
+		std::ifstream file(path, std::ios::binary);
+		if (!file)
+			return {};
+		return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	bool WriteFile(const std::string& path, IDataBlob* blob)
+	{
+		std::error_code ec;
+		std::filesystem::create_directories(std::filesystem::path(path).parent_path(), ec);
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file)
+			return false;
+		file.write(static_cast<const char*>(blob->GetConstDataPtr()), (std::streamsize) blob->GetSize());
+		return (bool) file;
+	}
+}
+
+void PipelineCache::Init()
+{
+	s_Data.Start = std::chrono::steady_clock::now();
+	s_Data.Stats = {};
+
+	IRenderDevice* device = Window::GetDevice();
+	std::string cacheDir = ResourceManager::GetInstance().GetCacheDir("ShaderCache");
+	if (!device || cacheDir.empty())
+		return;
+
+	RENDER_DEVICE_TYPE type = device->GetDeviceInfo().Type;
+	std::string backend = BackendName(type);
+	s_Data.StatePath = (std::filesystem::path(cacheDir) / ("RenderStates_" + backend + ".bin")).string();
+	s_Data.DriverPath = (std::filesystem::path(cacheDir) / ("Pipelines_" + backend + ".bin")).string();
+
+	// Hashing by content rather than path/timestamp is what invalidates an entry when a source file changes
+	RenderStateCacheCreateInfo cacheCI;
+	cacheCI.pDevice = device;
+	cacheCI.LogLevel = RENDER_STATE_CACHE_LOG_LEVEL_DISABLED;
+	cacheCI.FileHashMode = RENDER_STATE_CACHE_FILE_HASH_MODE_BY_CONTENT;
+	CreateRenderStateCache(cacheCI, &s_Data.StateCache);
+
+	if (!s_Data.StateCache)
+	{
+		Logger::Warn("PipelineCache: Render state cache unavailable, shaders will compile every launch");
+		return;
+	}
+
+	std::vector<uint8_t> states = ReadFile(s_Data.StatePath);
+	if (!states.empty())
+	{
+		RefCntAutoPtr<DataBlobImpl> blob = DataBlobImpl::Create(states.size(), states.data());
+		s_Data.Loaded = s_Data.StateCache->Load(blob, CacheContentVersion);
+		if (!s_Data.Loaded)
+			Logger::Warn("PipelineCache: Ignoring stale cache " + s_Data.StatePath);
+	}
+
+	// Driver-level pipeline cache; the driver itself rejects data written by another GPU or driver version
+	if (type == RENDER_DEVICE_TYPE_VULKAN || type == RENDER_DEVICE_TYPE_D3D12)
+	{
+		std::vector<uint8_t> driverData = ReadFile(s_Data.DriverPath);
+
+		PipelineStateCacheCreateInfo driverCI;
+		driverCI.Desc.Name = "Pipeline Cache";
+		driverCI.Desc.Mode = PSO_CACHE_MODE_LOAD | PSO_CACHE_MODE_STORE;
+		driverCI.pCacheData = driverData.empty() ? nullptr : driverData.data();
+		driverCI.CacheDataSize = (Uint32) driverData.size();
+		device->CreatePipelineStateCache(driverCI, &s_Data.DriverCache);
+	}
+}
+
+void PipelineCache::Shutdown()
+{
+	Save();
+
+	s_Data.DriverCache.Release();
+	s_Data.StateCache.Release();
+	s_Data.Loaded = false;
+}
+
+void PipelineCache::Save()
+{
+	if (!s_Data.Dirty || !s_Data.StateCache)
+		return;
+	s_Data.Dirty = false;
+
+	RefCntAutoPtr<IDataBlob> states;
+	if (s_Data.StateCache->WriteToBlob(CacheContentVersion, &states) && states && !WriteFile(s_Data.StatePath, states))
+		Logger::Warn("PipelineCache: Could not write cache " + s_Data.StatePath);
+
+	if (s_Data.DriverCache)
+	{
+		RefCntAutoPtr<IDataBlob> driverData;
+		s_Data.DriverCache->GetData(&driverData);
+		if (driverData && driverData->GetSize() > 0 && !WriteFile(s_Data.DriverPath, driverData))
+			Logger::Warn("PipelineCache: Could not write cache " + s_Data.DriverPath);
+	}
+}
+
+void PipelineCache::CreateShader(const ShaderCreateInfo& createInfo, IShader** shader)
+{
+	if (!s_Data.StateCache)
+	{
+		Window::GetDevice()->CreateShader(createInfo, shader);
+		s_Data.Stats.ShaderMisses++;
+		return;
+	}
+
+	if (s_Data.StateCache->CreateShader(createInfo, shader))
+	{
+		s_Data.Stats.ShaderHits++;
+		return;
+	}
+
+	s_Data.Stats.ShaderMisses++;
+	s_Data.Dirty = true;
+}
+
+void PipelineCache::CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& createInfo, IPipelineState** pipeline)
+{
+	GraphicsPipelineStateCreateInfo cacheCI = createInfo;
+	if (!cacheCI.pPSOCache)
+		cacheCI.pPSOCache = s_Data.DriverCache;
+
+	if (!s_Data.StateCache)
+	{
+		Window::GetDevice()->CreateGraphicsPipelineState(cacheCI, pipeline);
+		s_Data.Stats.PipelineMisses++;
+		return;
+	}
+
+	if (s_Data.StateCache->CreateGraphicsPipelineState(cacheCI, pipeline))
+	{
+		s_Data.Stats.PipelineHits++;
+		return;
+	}
+
+	s_Data.Stats.PipelineMisses++;
+	s_Data.Dirty = true;
+}
+
+void PipelineCache::CreateComputePipelineState(const ComputePipelineStateCreateInfo& createInfo, IPipelineState** pipeline)
+{
+	ComputePipelineStateCreateInfo cacheCI = createInfo;
+	if (!cacheCI.pPSOCache)
+		cacheCI.pPSOCache = s_Data.DriverCache;
+
+	if (!s_Data.StateCache)
+	{
+		Window::GetDevice()->CreateComputePipelineState(cacheCI, pipeline);
+		s_Data.Stats.PipelineMisses++;
+		return;
+	}
+
+	if (s_Data.StateCache->CreateComputePipelineState(cacheCI, pipeline))
+	{
+		s_Data.Stats.PipelineHits++;
+		return;
+	}
+
+	s_Data.Stats.PipelineMisses++;
+	s_Data.Dirty = true;
+}
+
+void PipelineCache::ReportStartup(const std::string& what)
+{
+	const Stats& stats = s_Data.Stats;
+	bool warm = s_Data.Loaded && stats.ShaderMisses == 0 && stats.PipelineMisses == 0;
+
+	Logger::Info("PipelineCache: " + what + " ready " + (warm ? "warm" : "cold") + " in " + Timing::ElapsedMs(s_Data.Start) + " (" + std::to_string(stats.ShaderHits) + "/" + std::to_string(stats.ShaderHits + stats.ShaderMisses) +
+	             " shaders, " + std::to_string(stats.PipelineHits) + "/" + std::to_string(stats.PipelineHits + stats.PipelineMisses) + " pipelines from cache)");
+
+	Save();
+}
+
+const PipelineCache::Stats& PipelineCache::GetStats()
+{
+	return s_Data.Stats;
+}
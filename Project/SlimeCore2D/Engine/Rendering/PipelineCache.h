@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "RenderDevice.h"
+
+using namespace Diligent;
+
+// Disk cache for compiled shaders and pipeline states, kept in "ShaderCache" next to the executable.
+// Shaders are keyed by a hash of their resolved source (includes too), macros, create info and the backend,
+// so editing any .hlsl/.fxh recompiles exactly what depends on it. Pipelines are keyed by their description.
+// On Vulkan and D3D12 the driver's own pipeline cache is stored alongside. Without a cache it falls through to the device.
+class PipelineCache
+{
+public:
+	struct Stats
+	{
+		uint32_t ShaderHits = 0;
+		uint32_t ShaderMisses = 0;
+		uint32_t PipelineHits = 0;
+		uint32_t PipelineMisses = 0;
+	};
+
+	// Loads the cache for the current backend. Call before creating any shader.
+	static void Init();
+
+	// Writes the cache back if anything was compiled since the last save, then releases it.
+	static void Shutdown();
+
+	// Writes the cache back if anything was compiled since the last save
+	static void Save();
+
+	static void CreateShader(const ShaderCreateInfo& createInfo, IShader** shader);
+	static void CreateGraphicsPipelineState(const GraphicsPipelineStateCreateInfo& createInfo, IPipelineState** pipeline);
+	static void CreateComputePipelineState(const ComputePipelineStateCreateInfo& createInfo, IPipelineState** pipeline);
+
+	// Logs how long it took since Init() and how much came from the cache, then saves.
+	// 'what' names the work being timed, e.g. "Renderer".
+	static void ReportStartup(const std::string& what);
+
+	static const Stats& GetStats();
+};
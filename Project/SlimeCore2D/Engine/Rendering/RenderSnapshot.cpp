@@ -0,0 +1,307 @@
+#include "RenderSnapshot.h"
+
+#include <algorithm>
+
+#include <gtc/matrix_transform.hpp>
+
+#include "Tilemap.h"
+
+namespace
+{
+	RenderSnapshot* s_Recording = nullptr;
+
+	Renderer::SpriteInstance MakeQuad(const glm::vec3& position, const glm::vec2& size, Texture* texture, float tiling, const glm::vec4& color)
+	{
+		// Same corners as Renderer::DrawQuad: the unit quad scaled about its centre
+		Renderer::SpriteInstance sprite;
+		sprite.Transform = glm::translate(glm::mat4(1.0f), position) * glm::scale(glm::mat4(1.0f), glm::vec3(size, 1.0f));
+		sprite.Texture = texture;
+		sprite.Color = color;
+		sprite.Tiling = tiling;
+		return sprite;
+	}
+} // namespace
+
+RenderSnapshot* RenderSnapshot::GetRecording()
+{
+	return s_Recording;
+}
+
+void RenderSnapshot::SetRecording(RenderSnapshot* snapshot)
+{
+	s_Recording = snapshot;
+}
+
+void RenderSnapshot::Clear()
+{
+	m_Commands.clear();
+	m_Matrices.clear();
+	m_Rects.clear();
+	m_Sprites.clear();
+	m_StaticBatches.clear();
+	m_Tilemaps.clear();
+	m_DebugFrames.clear();
+	m_Targets.clear();
+	m_TextCount = 0;
+	m_ParticleCount = 0;
+}
+
+void RenderSnapshot::Push(CommandType type, uint32_t index, uint32_t count)
+{
+	m_Commands.push_back({ type, index, count });
+}
+
+uint32_t RenderSnapshot::PushMatrix(const glm::mat4& matrix)
+{
+	m_Matrices.push_back(matrix);
+	return (uint32_t) m_Matrices.size() - 1;
+}
+
+uint32_t RenderSnapshot::PushRect(const glm::vec4& rect)
+{
+	m_Rects.push_back(rect);
+	return (uint32_t) m_Rects.size() - 1;
+}
+
+void RenderSnapshot::BeginScene(const glm::mat4& viewProj)
+{
+	Push(CommandType::BeginScene, PushMatrix(viewProj));
+}
+
+void RenderSnapshot::EndScene()
+{
+	Push(CommandType::EndScene);
+}
+
+void RenderSnapshot::ClearDepth()
+{
+	Push(CommandType::ClearDepth);
+}
+
+void RenderSnapshot::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
+{
+	*AddSprites(1) = MakeQuad(position, size, nullptr, 1.0f, color);
+}
+
+void RenderSnapshot::DrawQuad(const glm::vec3& position, const glm::vec2& size, Texture* texture, float tiling, const glm::vec4& tintColor)
+{
+	*AddSprites(1) = MakeQuad(position, size, texture, tiling, tintColor);
+}
+
+void RenderSnapshot::DrawSprites(const Renderer::SpriteInstance* sprites, size_t count)
+{
+	if (count == 0)
+		return;
+
+	Renderer::SpriteInstance* dst = AddSprites(count);
+	std::copy(sprites, sprites + count, dst);
+}
+
+Renderer::SpriteInstance* RenderSnapshot::AddSprites(size_t count)
+{
+	return AppendSprites(CommandType::Sprites, count);
+}
+
+Renderer::SpriteInstance* RenderSnapshot::AddLayeredSprites(size_t count)
+{
+	return AppendSprites(CommandType::LayeredSprites, count);
+}
+
+Renderer::SpriteInstance* RenderSnapshot::AppendSprites(CommandType type, size_t count)
+{
+	uint32_t first = (uint32_t) m_Sprites.size();
+	if (count == 0)
+		return m_Sprites.data() + first;
+
+	m_Sprites.resize(m_Sprites.size() + count);
+
+	if (!m_Commands.empty() && m_Commands.back().Type == type)
+		m_Commands.back().Count += (uint32_t) count;
+	else
+		Push(type, first, (uint32_t) count);
+
+	return m_Sprites.data() + first;
+}
+
+void RenderSnapshot::DrawStaticBatch(const Renderer::StaticBatchHandle& batch)
+{
+	if (!batch || batch->QuadCount == 0)
+		return;
+
+	m_StaticBatches.push_back(batch);
+	Push(CommandType::StaticBatch, (uint32_t) m_StaticBatches.size() - 1);
+}
+
+void RenderSnapshot::DrawTilemap(const std::shared_ptr<Tilemap>& tilemap, const glm::vec3& origin, const glm::vec2& viewMin, const glm::vec2& viewMax)
+{
+	if (!tilemap)
+		return;
+
+	tilemap->UploadDirtyChunks();
+
+	m_Tilemaps.push_back({ tilemap, origin, viewMin, viewMax });
+	Push(CommandType::Tilemap, (uint32_t) m_Tilemaps.size() - 1);
+}
+
+void RenderSnapshot::DrawTextLayout(const TextLayout& layout, const glm::vec3& position, const glm::vec4& color)
+{
+	if (!layout.GetFont() || layout.GetGlyphs().empty())
+		return;
+
+	layout.PrepareDraw();
+
+	if (m_TextCount == m_Texts.size())
+		m_Texts.emplace_back();
+
+	TextDraw& text = m_Texts[m_TextCount];
+	text.Layout = layout;
+	text.Position = position;
+	text.Color = color;
+	Push(CommandType::Text, m_TextCount++);
+}
+
+void RenderSnapshot::DrawGpuParticles(GpuParticleSystem& system)
+{
+	if (m_ParticleCount == m_Particles.size())
+		m_Particles.emplace_back();
+
+	ParticleDraw& draw = m_Particles[m_ParticleCount];
+	draw.System = &system;
+	system.TakeStep(draw.Step);
+	Push(CommandType::GpuParticles, m_ParticleCount++);
+}
+
+void RenderSnapshot::DrawDebugShapes(const glm::mat4& viewProj)
+{
+	DebugDraw::Capture(m_DebugFrames.emplace_back());
+	Push(CommandType::DebugShapes, (uint32_t) m_DebugFrames.size() - 1, PushMatrix(viewProj));
+}
+
+void RenderSnapshot::BeginRenderToTexture(Texture* target, const glm::mat4& viewProj)
+{
+	m_Targets.push_back(target);
+	Push(CommandType::BeginRenderToTexture, (uint32_t) m_Targets.size() - 1, PushMatrix(viewProj));
+}
+
+void RenderSnapshot::EndRenderToTexture()
+{
+	Push(CommandType::EndRenderToTexture);
+}
+
+void RenderSnapshot::BeginWorldPass()
+{
+	Push(CommandType::BeginWorldPass);
+}
+
+void RenderSnapshot::EndWorldPass()
+{
+	Push(CommandType::EndWorldPass);
+}
+
+void RenderSnapshot::PushClipRect(float x, float y, float w, float h)
+{
+	Push(CommandType::PushClipRect, PushRect({ x, y, w, h }));
+}
+
+void RenderSnapshot::PopClipRect()
+{
+	Push(CommandType::PopClipRect);
+}
+
+void RenderSnapshot::EnableScissor(float x, float y, float w, float h)
+{
+	Push(CommandType::EnableScissor, PushRect({ x, y, w, h }));
+}
+
+void RenderSnapshot::DisableScissor()
+{
+	Push(CommandType::DisableScissor);
+}
+
+void RenderSnapshot::RecordCulling(uint32_t visible, uint32_t total)
+{
+	Push(CommandType::Culling, visible, total);
+}
+
+void RenderSnapshot::Replay() const
+{
+	for (const Command& cmd: m_Commands)
+	{
+		switch (cmd.Type)
+		{
+			case CommandType::BeginScene:
+				Renderer::BeginScene(m_Matrices[cmd.Index]);
+				break;
+			case CommandType::EndScene:
+				Renderer::EndScene();
+				break;
+			case CommandType::ClearDepth:
+				Renderer::ClearDepth();
+				break;
+			case CommandType::Sprites:
+				Renderer::DrawSprites(&m_Sprites[cmd.Index], cmd.Count);
+				break;
+			case CommandType::LayeredSprites:
+				Renderer::DrawSpritesLayered(&m_Sprites[cmd.Index], cmd.Count);
+				break;
+			case CommandType::StaticBatch:
+				Renderer::DrawStaticBatch(*m_StaticBatches[cmd.Index]);
+				break;
+			case CommandType::Tilemap:
+			{
+				const TilemapDraw& draw = m_Tilemaps[cmd.Index];
+				Renderer::DrawTilemap(*draw.Map, draw.Origin, draw.ViewMin, draw.ViewMax);
+				break;
+			}
+			case CommandType::Text:
+			{
+				const TextDraw& text = m_Texts[cmd.Index];
+				Renderer::DrawTextLayout(text.Layout, text.Position, text.Color);
+				break;
+			}
+			case CommandType::GpuParticles:
+			{
+				const ParticleDraw& draw = m_Particles[cmd.Index];
+				draw.System->Simulate(draw.Step);
+				Renderer::DrawGpuParticles(*draw.System);
+				break;
+			}
+			case CommandType::DebugShapes:
+				DebugDraw::Render(m_Matrices[cmd.Count], m_DebugFrames[cmd.Index]);
+				break;
+			case CommandType::BeginRenderToTexture:
+				Renderer::BeginRenderToTexture(m_Targets[cmd.Index], m_Matrices[cmd.Count]);
+				break;
+			case CommandType::EndRenderToTexture:
+				Renderer::EndRenderToTexture();
+				break;
+			case CommandType::BeginWorldPass:
+				Renderer::BeginWorldPass();
+				break;
+			case CommandType::EndWorldPass:
+				Renderer::EndWorldPass();
+				break;
+			case CommandType::PushClipRect:
+			{
+				const glm::vec4& r = m_Rects[cmd.Index];
+				Renderer::PushClipRect(r.x, r.y, r.z, r.w);
+				break;
+			}
+			case CommandType::PopClipRect:
+				Renderer::PopClipRect();
+				break;
+			case CommandType::EnableScissor:
+			{
+				const glm::vec4& r = m_Rects[cmd.Index];
+				Renderer::EnableScissor(r.x, r.y, r.z, r.w);
+				break;
+			}
+			case CommandType::DisableScissor:
+				Renderer::DisableScissor();
+				break;
+			case CommandType::Culling:
+				Renderer::RecordCulling(cmd.Index, cmd.Count);
+				break;
+		}
+	}
+}
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm.hpp>
+
+#include "DebugDraw.h"
+#include "GpuParticleSystem.h"
+#include "Renderer.h"
+#include "TextLayout.h"
+
+class Texture;
+class Tilemap;
+
+// One frame of draws as plain data: recorded on the main thread at the end of update, replayed on the render
+// thread. Everything a draw reads is copied in (sprite instances, text layouts, camera matrices) or kept alive
+// (static batches, tilemaps), so the ECS can move on to the next frame while this one is submitted.
+// Textures and GPU particle systems are referenced by pointer; deleting either waits for the frame in flight.
+// Calls mirror the Renderer's and replay in the order they were recorded.
+class RenderSnapshot
+{
+public:
+	// Drops the previous frame, keeping the storage
+	void Clear();
+
+	void BeginScene(const glm::mat4& viewProj);
+	void EndScene();
+
+	// Clears the bound target's depth, e.g. between the world and the UI
+	void ClearDepth();
+
+	void DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color);
+	void DrawQuad(const glm::vec3& position, const glm::vec2& size, Texture* texture, float tiling = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
+
+	// Consecutive quads and sprites merge into one Renderer::DrawSprites call
+	void DrawSprites(const Renderer::SpriteInstance* sprites, size_t count);
+
+	// Appends 'count' sprites at this point in the frame for the caller to fill in, e.g. from JobSystem workers.
+	// The pointer is valid until the next call on this snapshot.
+	Renderer::SpriteInstance* AddSprites(size_t count);
+
+	// As AddSprites, replayed through Renderer::DrawSpritesLayered. The sprites must be in back-to-front order.
+	Renderer::SpriteInstance* AddLayeredSprites(size_t count);
+
+	void DrawStaticBatch(const Renderer::StaticBatchHandle& batch);
+
+	// Uploads the map's dirty chunks now, on the thread that edits it
+	void DrawTilemap(const std::shared_ptr<Tilemap>& tilemap, const glm::vec3& origin, const glm::vec2& viewMin, const glm::vec2& viewMax);
+
+	void DrawTextLayout(const TextLayout& layout, const glm::vec3& position, const glm::vec4& color);
+
+	// Takes the emissions and time queued on 'system' since its last draw; the simulation runs at replay
+	void DrawGpuParticles(GpuParticleSystem& system);
+
+	// Takes this frame's DebugDraw shapes
+	void DrawDebugShapes(const glm::mat4& viewProj);
+
+	void BeginRenderToTexture(Texture* target, const glm::mat4& viewProj);
+	void EndRenderToTexture();
+
+	// Draws in between at the dynamic resolution scale; see Renderer::BeginWorldPass
+	void BeginWorldPass();
+	void EndWorldPass();
+
+	void PushClipRect(float x, float y, float w, float h);
+	void PopClipRect();
+	void EnableScissor(float x, float y, float w, float h);
+	void DisableScissor();
+
+	void RecordCulling(uint32_t visible, uint32_t total);
+
+	// Issues every recorded call to the Renderer. Call between Renderer::BeginFrame and the present.
+	void Replay() const;
+
+	bool IsEmpty() const
+	{
+		return m_Commands.empty();
+	}
+
+	// Snapshot that script draw calls record into; null outside Game2D::Draw, where they are dropped
+	static RenderSnapshot* GetRecording();
+	static void SetRecording(RenderSnapshot* snapshot);
+
+private:
+	enum class CommandType : uint8_t
+	{
+		BeginScene,
+		EndScene,
+		ClearDepth,
+		Sprites,
+		LayeredSprites,
+		StaticBatch,
+		Tilemap,
+		Text,
+		GpuParticles,
+		DebugShapes,
+		BeginRenderToTexture,
+		EndRenderToTexture,
+		BeginWorldPass,
+		EndWorldPass,
+		PushClipRect,
+		PopClipRect,
+		EnableScissor,
+		DisableScissor,
+		Culling
+	};
+
+	// 'Index' points into the storage of its type. 'Count' is a second operand where one is needed: the sprite
+	// count, the matrix of a debug or render-to-texture pass, or Culling's total.
+	struct Command
+	{
+		CommandType Type;
+		uint32_t Index;
+		uint32_t Count;
+	};
+
+	struct TilemapDraw
+	{
+		std::shared_ptr<Tilemap> Map;
+		glm::vec3 Origin;
+		glm::vec2 ViewMin;
+		glm::vec2 ViewMax;
+	};
+
+	struct TextDraw
+	{
+		TextLayout Layout;
+		glm::vec3 Position;
+		glm::vec4 Color;
+	};
+
+	struct ParticleDraw
+	{
+		GpuParticleSystem* System;
+		GpuParticleSystem::Step Step;
+	};
+
+	void Push(CommandType type, uint32_t index = 0, uint32_t count = 0);
+	uint32_t PushMatrix(const glm::mat4& matrix);
+	uint32_t PushRect(const glm::vec4& rect);
+	Renderer::SpriteInstance* AppendSprites(CommandType type, size_t count);
+
+	std::vector<Command> m_Commands;
+	std::vector<glm::mat4> m_Matrices;
+	std::vector<glm::vec4> m_Rects; // Clip and scissor rects
+	std::vector<Renderer::SpriteInstance> m_Sprites;
+	std::vector<Renderer::StaticBatchHandle> m_StaticBatches;
+	std::vector<TilemapDraw> m_Tilemaps;
+	std::vector<TextDraw> m_Texts;
+	std::vector<ParticleDraw> m_Particles;
+	std::vector<DebugDraw::Frame> m_DebugFrames;
+	std::vector<Texture*> m_Targets;
+
+	uint32_t m_TextCount = 0; // Entries past this in m_Texts are spare, kept for their glyph storage
+	uint32_t m_ParticleCount = 0;
+};
@@ -1,13 +1,25 @@
 #include "Renderer.h"
 
+#include <algorithm>
 #include <array>
+#include <cassert>
+#include <cmath>
+#include <fstream>
 #include <gtc/matrix_transform.hpp>
+#include <gtc/packing.hpp>
 #include <iostream>
+#include <unordered_map>
 
+#include "Core/JobSystem.h"
 #include "Core/Window.h"
 #include "Core/Logger.h"
 #include "Resources/ResourceManager.h"
 #include "Font.h"
+#include "GpuParticleSystem.h"
+#include "PipelineCache.h"
+#include "ResourceState.h"
+#include "TextLayout.h"
+#include "Tilemap.h"
 #include "DiligentCore/Graphics/GraphicsTools/interface/MapHelper.hpp"
 #include "Shader.h"
 
@@ -18,18 +30,17 @@ struct RendererData
     // ==============================================================================================
     // 2D Batching Data
     // ==============================================================================================
-    static const uint32_t MaxQuads = 1000; // Reduced batch size to prevent dynamic heap exhaustion
+    // Capacity of the per-frame vertex ring. A batch is no longer capped by this; it only bounds how many
+    // quads can be staged before the pending batches are uploaded and drawn.
+    static const uint32_t MaxQuads = 65536;
     static const uint32_t MaxVertices = MaxQuads * 4;
     static const uint32_t MaxIndices = MaxQuads * 6;
     static const uint32_t MaxTextureSlots = 32; // REDUCED from 1024 to 32 to fix descriptor heap issues
 
     RefCntAutoPtr<IPipelineState> QuadPSO;
-    RefCntAutoPtr<IShaderResourceBinding> QuadSRB;
+    RefCntAutoPtr<IPipelineState> TextPSO; // Both take their SRBs from SRBCache
 
-    RefCntAutoPtr<IPipelineState> TextPSO;
-    RefCntAutoPtr<IShaderResourceBinding> TextSRB;
-
-    RefCntAutoPtr<IBuffer> QuadVB; // Dynamic Vertex Buffer (Interleaved)
+    RefCntAutoPtr<IBuffer> QuadVB; // Dynamic Vertex Ring (Interleaved), discarded once per frame
     RefCntAutoPtr<IBuffer> QuadIB; // Static Index Buffer
 
     // Vertex Structure for 2D
@@ -40,11 +51,18 @@ struct RendererData
         glm::vec2 TexCoord;
         float TexIndex;
         float Tiling;
-        float IsText; // 0.0 = Sprite, 1.0 = Text
+        float IsText; // 0.0 = Sprite, 1.0 = Text, 2.0 = Sprite shaped by the fields below, 3.0 = Sprite alpha-tested at half
+        glm::u16vec4 ClipRect; // Render-target pixels (left, top, right, bottom); fragments outside are discarded
+        glm::u16vec2 ShapeCoord; // Half floats: offset from the quad's centre in quad units
+        glm::u16vec4 Shape; // Half floats: half width, half height, corner radius, border width
+        uint32_t BorderColor; // RGBA8
     };
+    // Every sprite carries the clip and shape fields, so they are packed to keep the vertex small
+    static_assert(sizeof(QuadVertex) == 72, "QuadVertex must match the renderer2d input layout");
 
     QuadVertex* QuadBufferBase = nullptr;
     QuadVertex* QuadBufferPtr = nullptr;
+    QuadVertex* BatchStartPtr = nullptr; // First vertex of the batch currently being filled
 
     uint32_t QuadIndexCount = 0;
     
@@ -53,20 +71,198 @@ struct RendererData
 
     RefCntAutoPtr<ITextureView> WhiteTexture;
 
+    // ==============================================================================================
+    // Deferred Batch Submission
+    // ==============================================================================================
+    // Flush() only closes the current batch and records it here. The staged vertices of every
+    // recorded batch are uploaded with a single map in SubmitBatches() and then drawn with base-vertex
+    // offsets, so a frame costs one DISCARD plus a NO_OVERWRITE append per submission.
+    // Frames in flight are covered by the backend's dynamic heap, which retires each frame's
+    // DISCARD allocation behind its own fence.
+    enum class PipelineType { None, Quad, Text, Mesh, Opaque, Translucent }; // The last two are DrawSpritesLayered's passes
+
+    struct BatchCommand
+    {
+        PipelineType Pipeline = PipelineType::Quad;
+        IBuffer* VertexBuffer = nullptr; // Static batch buffer, or null for the frame ring
+        uint32_t BaseVertex = 0; // Offset into the staging buffer (or into VertexBuffer)
+        uint32_t IndexCount = 0;
+        uint32_t TextureCount = 0;
+        std::array<ITextureView*, MaxTextureSlots> Textures;
+        bool UsesTable = false; // Samples the bindless table; Textures is unused
+    };
+    std::vector<BatchCommand> Batches;
+
+    // Batch-break diagnostics. Every recorded draw lands in FrameReport; BeginFrame swaps it into
+    // LastFrameReport, so both vectors keep their capacity and steady frames don't allocate.
+    std::vector<Renderer::BatchRecord> FrameReport;
+    std::vector<Renderer::BatchRecord> LastFrameReport;
+
+    // ==============================================================================================
+    // Shader Resource Binding Cache
+    // ==============================================================================================
+    // One SRB per (pipeline, texture set) seen recently, with unused slots padded with white.
+    // A batch whose set is cached costs a hash lookup; u_Textures is only written when an SRB is
+    // created. Entries unused for SRBCacheMaxAge frames are released by BeginFrame.
+    struct TextureSetKey
+    {
+        PipelineType Pipeline = PipelineType::None;
+        std::array<ITextureView*, MaxTextureSlots> Views;
+
+        bool operator==(const TextureSetKey& other) const
+        {
+            return Pipeline == other.Pipeline && Views == other.Views;
+        }
+    };
+
+    struct TextureSetKeyHash
+    {
+        size_t operator()(const TextureSetKey& key) const
+        {
+            size_t hash = std::hash<int>()((int)key.Pipeline);
+            for (ITextureView* view : key.Views)
+                hash ^= std::hash<ITextureView*>()(view) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+
+    struct CachedSRB
+    {
+        RefCntAutoPtr<IShaderResourceBinding> SRB;
+        uint64_t LastUsedFrame = 0;
+    };
+
+    static const uint64_t SRBCacheMaxAge = 120;
+    std::unordered_map<TextureSetKey, CachedSRB, TextureSetKeyHash> SRBCache;
+    uint64_t FrameIndex = 0;
+
+    // ==============================================================================================
+    // Bindless Texture Table
+    // ==============================================================================================
+    // When the device supports bindless resources, dynamic quads and text index one table of
+    // BindlessTableSlots textures instead of a per-batch set, so a new texture never breaks the batch.
+    // A texture keeps its slot while it is drawn; slots unused for SRBCacheMaxAge frames are written
+    // back to white and reused. The table is a dynamic variable, so a commit snapshots it and slots can
+    // be rewritten once the batches that read them are submitted. Static batches keep their baked
+    // per-range sets and the set pipelines above.
+    static const uint32_t BindlessTableSlots = 1024; // Matches TEXTURE_SLOTS in BasicBindlessPixel.hlsl
+
+    struct TableSlot
+    {
+        RefCntAutoPtr<ITextureView> View;
+        uint64_t LastUsedFrame = 0;
+        uint64_t LastBatch = 0;
+    };
+
+    bool Bindless = false;
+    RefCntAutoPtr<IPipelineState> BindlessPSO; // Quad and text batches alike; IsText picks the shading
+    RefCntAutoPtr<IShaderResourceBinding> BindlessSRB;
+    IShaderResourceVariable* BindlessTextures = nullptr;
+    std::vector<TableSlot> TableSlots; // Slot 0 is the white texture
+    std::unordered_map<ITextureView*, uint32_t> TableLookup;
+    std::vector<uint32_t> FreeTableSlots;
+    uint64_t BatchSerial = 1; // Identifies the open batch, for counting the table slots it samples
+    uint32_t BatchTableTextures = 1;
+
+    // ==============================================================================================
+    // Layered Sprite Pass
+    // ==============================================================================================
+    // DrawSpritesLayered draws opaque sprites front to back with depth writes, then the rest in order with
+    // depth testing. A sprite's depth comes from its list position, mapped back to a z through the current
+    // view-projection, so the list order stays the draw order whatever the transforms' z.
+    static const size_t MaxLayeredSprites = 1 << 20; // Keeps neighbouring depths apart in a float and in 24 bits
+
+    bool LayeredPass = false; // The depth-tested pipelines below were built
+    RefCntAutoPtr<IPipelineState> OpaquePSO;
+    RefCntAutoPtr<IPipelineState> TranslucentPSO;
+    RefCntAutoPtr<IPipelineState> BindlessOpaquePSO;
+    RefCntAutoPtr<IPipelineState> BindlessTranslucentPSO;
+
+    PipelineType SpritePipeline = PipelineType::Quad; // Pipeline DrawSpriteList batches under
+    bool LayerDepth = false; // DrawSpriteList overwrites z with LayerZBase + position * LayerZStep
+    float LayerZBase = 0.0f;
+    float LayerZStep = 0.0f;
+    std::vector<uint32_t> LayerOrder; // List positions: opaque front to back, then translucent back to front
+
+    // What the bound depth buffer may hold. DrawSpritesLayered only clears before its pass when something wrote
+    // depth since the last clear, and meshes clear first when the sprites' depth is still there.
+    struct DepthState
+    {
+        bool Written = false; // Something drew with depth writes since the last clear
+        bool Sprites = false; // DrawSpritesLayered's depths, meaningless to anything else
+    };
+    DepthState Depth;
+    DepthState OffscreenSavedDepth; // The base target's, while drawing into a texture
+    DepthState WorldSavedDepth;     // The back buffer's, while the world pass draws into the scaled target
+
+    // Per-sprite setup resolved serially by DrawSprites before the parallel vertex pass
+    struct SpriteSetup
+    {
+        glm::vec4 UVRect;
+        float TexIndex;
+        uint32_t FirstQuad; // Offset into the chunk's quads
+    };
+    std::vector<SpriteSetup> SpriteScratch;
+
+    // DrawString's layouts, keyed by a hash of (text, font, scale, wrap width). Each distinct string keeps its own
+    // shaped layout across frames; entries not drawn for StringCacheMaxAge frames are dropped by BeginFrame.
+    struct CachedString
+    {
+        TextLayout Layout;
+        uint64_t LastUsedFrame = 0;
+    };
+    static const uint64_t StringCacheMaxAge = 60;
+    std::unordered_map<size_t, CachedString> StringCache;
+
+    uint32_t RingCursor = 0;        // Next free vertex in QuadVB for this frame
+    bool RingDiscarded = false;     // QuadVB has been mapped with DISCARD this frame
+
+    // Clip rect stack. Clipping is per vertex, so changing it never breaks a batch;
+    // ClipRect is the intersection of everything pushed, already packed as it is copied into each vertex written.
+    static constexpr glm::u16vec4 NoClip = { 0, 0, 0xFFFF, 0xFFFF };
+    std::vector<glm::u16vec4> ClipStack;
+    glm::u16vec4 ClipRect = NoClip;
+
     // ==============================================================================================
     // 3D Rendering Data
     // ==============================================================================================
     RefCntAutoPtr<IPipelineState> MeshPSO;
     RefCntAutoPtr<IShaderResourceBinding> MeshSRB;
-    
-    struct MeshConstants
+
+    // Per-instance vertex data, read from buffer slot 1 (matches Basic3DVertex.hlsl)
+    struct MeshInstance
     {
         glm::mat4 World;
         glm::vec4 Color;
-        float UseTexture; // 0.0 = No, 1.0 = Yes
-        float Padding[3];
     };
-    RefCntAutoPtr<IBuffer> MeshConstantBuffer;
+
+    struct MeshDraw
+    {
+        IBuffer* VertexBuffer;
+        IBuffer* IndexBuffer;
+        uint32_t IndexCount;
+        ITextureView* Texture; // White texture when untextured
+        MeshInstance Instance;
+    };
+
+    static constexpr uint32_t MinMeshInstances = 256;
+    std::vector<MeshDraw> MeshQueue;
+    RefCntAutoPtr<IBuffer> MeshInstanceBuffer;
+    uint32_t MeshInstanceCapacity = 0;
+
+    // ==============================================================================================
+    // Tilemap Data
+    // ==============================================================================================
+    RefCntAutoPtr<IPipelineState> TilemapPSO;
+    RefCntAutoPtr<IShaderResourceBinding> TilemapSRB;
+
+    struct TilemapConstants
+    {
+        glm::vec4 ChunkRect; // xy = world origin, zw = world size
+        glm::vec4 ChunkInfo; // x = tiles per chunk side, y = depth
+        glm::vec4 TypeAnim[Tilemap::MaxTileTypes + 1]; // x = frame count, y = frames per second
+    };
+    RefCntAutoPtr<IBuffer> TilemapConstantBuffer;
 
     // ==============================================================================================
     // Global Data
@@ -74,22 +270,489 @@ struct RendererData
     struct GlobalConstants
     {
         glm::mat4 ViewProjection;
+        float Time; // Seconds since startup, drives shader-side animation
+        float Padding[3];
     };
     RefCntAutoPtr<IBuffer> GlobalConstantBuffer;
+    glm::mat4 SceneViewProj = glm::mat4(1.0f); // Restored after drawing into a texture
+    glm::mat4 CurrentViewProj = glm::mat4(1.0f); // The scene's, or the offscreen target's while one is bound
+
+    // ==============================================================================================
+    // Render To Texture Data
+    // ==============================================================================================
+    // The 2D pipelines are built for a D24S8 depth target, so offscreen passes bind this one
+    RefCntAutoPtr<ITexture> OffscreenDepth;
+    Texture* OffscreenTarget = nullptr;
+    glm::u16vec4 OffscreenSavedClip = RendererData::NoClip;
+
+    // ==============================================================================================
+    // Dynamic Resolution Data
+    // ==============================================================================================
+    // WorldColor and WorldDepth match the back buffer; a scaled pass draws into their top-left WorldWidth x
+    // WorldHeight corner, so a new scale never reallocates. World pass timings come from a ring of duration
+    // queries, each read back once the GPU has finished with it.
+    static const uint32_t TimingQueryCount = 4;
+
+    struct UpscaleConstants
+    {
+        glm::vec2 SourceScale;
+        glm::vec2 SourceMax;
+    };
+
+    Renderer::DynamicResolutionSettings ResolutionSettings;
+    Renderer::DynamicResolutionStats ResolutionStats;
+
+    RefCntAutoPtr<IPipelineState> UpscalePSO;
+    RefCntAutoPtr<IShaderResourceBinding> UpscaleSRB; // Reads WorldColor; recreated with it
+    RefCntAutoPtr<IBuffer> UpscaleConstantBuffer;
+    RefCntAutoPtr<ITexture> WorldColor;
+    RefCntAutoPtr<ITexture> WorldDepth;
+    uint32_t WorldWidth = 0;
+    uint32_t WorldHeight = 0;
+    bool InWorldPass = false;
+    bool WorldTargetBound = false; // The pass draws into WorldColor rather than the back buffer
+    float ClipScale = 1.0f;        // Back-buffer pixels to world target pixels, for clip rects
+
+    RefCntAutoPtr<IQuery> TimingQueries[TimingQueryCount];
+    bool TimingPending[TimingQueryCount] = {};
+    uint32_t TimingNext = 0;
+    bool TimingStarted = false; // The current world pass began TimingQueries[TimingNext]
 
     Renderer::Statistics Stats;
 
-    enum class PipelineType { None, Quad, Text, Mesh };
     PipelineType CurrentPipeline = PipelineType::None;
 };
 
 static RendererData s_Data;
 
+// Returns the cached SRB for a pipeline and texture set, creating and filling it on first use.
+static IShaderResourceBinding* GetBatchSRB(const RendererData::TextureSetKey& key, IPipelineState* pPSO)
+{
+    auto it = s_Data.SRBCache.find(key);
+    if (it == s_Data.SRBCache.end())
+    {
+        RendererData::CachedSRB entry;
+        pPSO->CreateShaderResourceBinding(&entry.SRB, true);
+        if (!entry.SRB)
+            return nullptr;
+
+        if (auto* pVar = entry.SRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_Textures"))
+        {
+            std::array<IDeviceObject*, RendererData::MaxTextureSlots> pViews;
+            for (uint32_t i = 0; i < RendererData::MaxTextureSlots; ++i)
+                pViews[i] = key.Views[i];
+            pVar->SetArray(pViews.data(), 0, RendererData::MaxTextureSlots);
+        }
+
+        it = s_Data.SRBCache.emplace(key, std::move(entry)).first;
+    }
+
+    it->second.LastUsedFrame = s_Data.FrameIndex;
+    return it->second.SRB;
+}
+
+// Frees the bindless table slots no batch has sampled for SRBCacheMaxAge frames, or every slot with 'all'.
+// Freed slots point back at the white texture, so the table stays fully bound.
+static void ReleaseTableSlots(bool all)
+{
+    IDeviceObject* pWhite = s_Data.WhiteTexture;
+    for (uint32_t slot = 1; slot < RendererData::BindlessTableSlots; ++slot)
+    {
+        RendererData::TableSlot& entry = s_Data.TableSlots[slot];
+        if (!entry.View || (!all && s_Data.FrameIndex - entry.LastUsedFrame <= RendererData::SRBCacheMaxAge))
+            continue;
+
+        s_Data.TableLookup.erase(entry.View.RawPtr());
+        entry.View.Release();
+        s_Data.BindlessTextures->SetArray(&pWhite, slot, 1);
+        s_Data.FreeTableSlots.push_back(slot);
+    }
+}
+
+// Returns the index the open batch samples 'srv' with, adding it to the batch's set or to the bindless table.
+// False when there is no room: the caller closes the batch with NextBatch(BatchBreak::TextureSlots) and asks again.
+static bool AcquireTextureSlot(ITextureView* srv, float& outIndex)
+{
+    if (s_Data.Bindless)
+    {
+        auto it = s_Data.TableLookup.find(srv);
+        if (it == s_Data.TableLookup.end())
+        {
+            if (s_Data.FreeTableSlots.empty())
+                return false;
+
+            uint32_t slot = s_Data.FreeTableSlots.back();
+            s_Data.FreeTableSlots.pop_back();
+            s_Data.TableSlots[slot].View = srv;
+
+            IDeviceObject* pView = srv;
+            s_Data.BindlessTextures->SetArray(&pView, slot, 1);
+            it = s_Data.TableLookup.emplace(srv, slot).first;
+        }
+
+        RendererData::TableSlot& entry = s_Data.TableSlots[it->second];
+        entry.LastUsedFrame = s_Data.FrameIndex;
+        if (entry.LastBatch != s_Data.BatchSerial)
+        {
+            entry.LastBatch = s_Data.BatchSerial;
+            s_Data.BatchTableTextures++;
+        }
+
+        outIndex = (float)it->second;
+        return true;
+    }
+
+    for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+    {
+        if (s_Data.TextureSlots[i] == srv)
+        {
+            outIndex = (float)i;
+            return true;
+        }
+    }
+
+    if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
+        return false;
+
+    outIndex = (float)s_Data.TextureSlotIndex;
+    s_Data.TextureSlots[s_Data.TextureSlotIndex++] = srv;
+    return true;
+}
+
+// Pipeline state a recorded batch draws with. Table batches share the bindless shaders, set batches pick by pipeline.
+static IPipelineState* GetBatchPSO(const RendererData::BatchCommand& batch)
+{
+    switch (batch.Pipeline)
+    {
+    case RendererData::PipelineType::Text: return batch.UsesTable ? s_Data.BindlessPSO : s_Data.TextPSO;
+    case RendererData::PipelineType::Opaque: return batch.UsesTable ? s_Data.BindlessOpaquePSO : s_Data.OpaquePSO;
+    case RendererData::PipelineType::Translucent: return batch.UsesTable ? s_Data.BindlessTranslucentPSO : s_Data.TranslucentPSO;
+    default: return batch.UsesTable ? s_Data.BindlessPSO : s_Data.QuadPSO;
+    }
+}
+
+// Why the open batch can't take another quad for 'pipeline', or None if it can.
+// 'needsTextureSlot' is set by callers that may register a new texture.
+static Renderer::BatchBreak CheckBatchBreak(RendererData::PipelineType pipeline, bool needsTextureSlot)
+{
+    if (s_Data.CurrentPipeline != RendererData::PipelineType::None && s_Data.CurrentPipeline != pipeline)
+        return Renderer::BatchBreak::PipelineSwitch;
+    if (s_Data.QuadBufferPtr + 4 > s_Data.QuadBufferBase + s_Data.MaxVertices)
+        return Renderer::BatchBreak::VertexBufferFull;
+    if (needsTextureSlot && s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
+        return Renderer::BatchBreak::TextureSlots;
+    return Renderer::BatchBreak::None;
+}
+
+static void RecordBatch(Renderer::BatchBreak reason, Renderer::BatchPipeline pipeline, uint32_t drawCalls, uint32_t quadCount, uint32_t textureCount)
+{
+    Renderer::BatchRecord& record = s_Data.FrameReport.emplace_back();
+    record.Reason = reason;
+    record.Pipeline = pipeline;
+    record.DrawCalls = drawCalls;
+    record.QuadCount = quadCount;
+    record.TextureCount = textureCount;
+}
+
+// Resolves the view and UV sub-rect a texture is sampled from. Atlased textures sample their
+// shared page, except when the quad tiles, which needs the standalone texture's wrap addressing.
+static ITextureView* ResolveTextureView(Texture* texture, float tiling, glm::vec4& uvRect)
+{
+    if (texture->IsInAtlas() && tiling == 1.0f)
+    {
+        uvRect = texture->GetAtlasUVRect();
+        return texture->GetAtlasPage()->GetSRV();
+    }
+
+    uvRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+    return texture->GetSRV();
+}
+
+// Resolves the view a sprite samples and its final UV rect, with any atlas remap applied.
+static ITextureView* ResolveSpriteTexture(const Renderer::SpriteInstance& sprite, glm::vec4& uvRect)
+{
+    uvRect = sprite.UVRect;
+    if (!sprite.Texture)
+        return nullptr;
+
+    glm::vec4 atlasRect;
+    ITextureView* srv = ResolveTextureView(sprite.Texture, sprite.Tiling, atlasRect);
+    glm::vec2 atlasSize = { atlasRect.z - atlasRect.x, atlasRect.w - atlasRect.y };
+    uvRect = { atlasRect.x + sprite.UVRect.x * atlasSize.x, atlasRect.y + sprite.UVRect.y * atlasSize.y, atlasRect.x + sprite.UVRect.z * atlasSize.x, atlasRect.y + sprite.UVRect.w * atlasSize.y };
+    return srv;
+}
+
+// Whether DrawSpritesLayered may draw 'sprite' with blending off: full alpha, no rounding or border, and white
+// or a texture whose texels are all either opaque or clear (the clear ones are alpha-tested away)
+static bool IsSpriteOpaque(const Renderer::SpriteInstance& sprite)
+{
+    if (sprite.Color.a < 1.0f || sprite.CornerRadius > 0.0f || sprite.BorderWidth > 0.0f)
+        return false;
+    return !sprite.Texture || sprite.Texture->IsCutout();
+}
+
+// Binds the target drawing returns to outside render to texture: the scaled world target during a world pass,
+// otherwise the back buffer
+static void BindBaseTarget()
+{
+    auto context = Window::GetContext();
+
+    if (s_Data.WorldTargetBound)
+    {
+        ITextureView* pRTV = s_Data.WorldColor->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        ITextureView* pDSV = s_Data.WorldDepth->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
+        context->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+        // Binding reset the viewport to the whole texture; the pass only covers its scaled corner
+        Viewport viewport;
+        viewport.Width = (float)s_Data.WorldWidth;
+        viewport.Height = (float)s_Data.WorldHeight;
+        context->SetViewports(1, &viewport, 0, 0);
+        return;
+    }
+
+    ITextureView* pRTV = Window::GetSwapChain()->GetCurrentBackBufferRTV();
+    ITextureView* pDSV = Window::GetSwapChain()->GetDepthBufferDSV();
+    context->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+}
+
+// Clears the depth of the bound target: the back buffer's, the world target's, or the offscreen one while drawing
+// into a texture
+static void ClearBoundDepth()
+{
+    ITextureView* pDSV = Window::GetDepthStencilView();
+    if (s_Data.OffscreenTarget)
+        pDSV = s_Data.OffscreenDepth ? s_Data.OffscreenDepth->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL) : nullptr;
+    else if (s_Data.WorldTargetBound)
+        pDSV = s_Data.WorldDepth->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL);
+
+    if (pDSV)
+        Window::GetContext()->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG | CLEAR_STENCIL_FLAG, 1.0f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    s_Data.Depth = {};
+}
+
+static bool IsNineSlice(const Renderer::SpriteInstance& sprite)
+{
+    return sprite.Texture && sprite.Slice != glm::vec4(0.0f);
+}
+
+// Packs a clip rect in render-target pixels (left, top, right, bottom) into the vertex format
+static glm::u16vec4 PackClipRect(const glm::vec4& rect)
+{
+    return glm::u16vec4(glm::clamp(glm::round(rect), glm::vec4(0.0f), glm::vec4(65535.0f)));
+}
+
+// Quads WriteSpriteVertices emits for a sprite
+static uint32_t SpriteQuadCount(const Renderer::SpriteInstance& sprite)
+{
+    return IsNineSlice(sprite) ? 9 : 1;
+}
+
+// Writes a sprite's quads, four corners each (BL, BR, TR, TL) in the same layout as DrawQuad: one quad, or the
+// nine cells of a nine-slice row by row from the v0 side.
+static void WriteSpriteVertices(const Renderer::SpriteInstance& sprite, const glm::vec4& uvRect, float texIndex, const glm::u16vec4& clipRect, RendererData::QuadVertex* v)
+{
+    glm::vec2 quadSize = { glm::length(glm::vec3(sprite.Transform[0])), glm::length(glm::vec3(sprite.Transform[1])) };
+
+    bool shaped = sprite.CornerRadius > 0.0f || sprite.BorderWidth > 0.0f;
+    glm::u16vec4 shape = glm::packHalf(glm::vec4(quadSize.x * 0.5f, quadSize.y * 0.5f, sprite.CornerRadius, sprite.BorderWidth));
+    uint32_t borderColor = glm::packUnorm4x8(sprite.BorderColor);
+
+    // Cell edges in quad-local space and the UVs they sample; only the outer ones are used without slicing
+    float xs[4] = { -0.5f, -0.5f, 0.5f, 0.5f };
+    float ys[4] = { -0.5f, -0.5f, 0.5f, 0.5f };
+    float us[4] = { uvRect.x, uvRect.x, uvRect.z, uvRect.z };
+    float vs[4] = { uvRect.y, uvRect.y, uvRect.w, uvRect.w };
+
+    int cells = 1;
+    if (IsNineSlice(sprite))
+    {
+        cells = 3;
+
+        // Borders in quad-local units, shrunk together when they would overlap
+        glm::vec4 border = sprite.Slice * sprite.SliceScale;
+        glm::vec2 across = { border.x + border.z, border.y + border.w };
+        float fitX = across.x > quadSize.x ? quadSize.x / across.x : 1.0f;
+        float fitY = across.y > quadSize.y ? quadSize.y / across.y : 1.0f;
+        float invW = quadSize.x > 0.0f ? 1.0f / quadSize.x : 0.0f;
+        float invH = quadSize.y > 0.0f ? 1.0f / quadSize.y : 0.0f;
+        xs[1] = -0.5f + border.x * fitX * invW;
+        xs[2] = 0.5f - border.z * fitX * invW;
+        ys[1] = -0.5f + border.y * fitY * invH;
+        ys[2] = 0.5f - border.w * fitY * invH;
+
+        // UV step per texel of the source region, signed so flipped UV rects slice the right way
+        float texelsX = std::abs(sprite.UVRect.z - sprite.UVRect.x) * (float)sprite.Texture->GetWidth();
+        float texelsY = std::abs(sprite.UVRect.w - sprite.UVRect.y) * (float)sprite.Texture->GetHeight();
+        float du = texelsX > 0.0f ? (uvRect.z - uvRect.x) / texelsX : 0.0f;
+        float dv = texelsY > 0.0f ? (uvRect.w - uvRect.y) / texelsY : 0.0f;
+        us[1] = uvRect.x + sprite.Slice.x * du;
+        us[2] = uvRect.z - sprite.Slice.z * du;
+        vs[1] = uvRect.y + sprite.Slice.y * dv;
+        vs[2] = uvRect.w - sprite.Slice.w * dv;
+    }
+
+    for (int cy = 0; cy < cells; ++cy)
+    {
+        int y0 = cells == 1 ? 0 : cy;
+        int y1 = cells == 1 ? 3 : cy + 1;
+
+        for (int cx = 0; cx < cells; ++cx)
+        {
+            int x0 = cells == 1 ? 0 : cx;
+            int x1 = cells == 1 ? 3 : cx + 1;
+
+            const glm::vec2 corners[4] = {
+                { xs[x0], ys[y0] },
+                { xs[x1], ys[y0] },
+                { xs[x1], ys[y1] },
+                { xs[x0], ys[y1] },
+            };
+            const glm::vec2 uvs[4] = {
+                { us[x0], vs[y0] },
+                { us[x1], vs[y0] },
+                { us[x1], vs[y1] },
+                { us[x0], vs[y1] },
+            };
+
+            for (int c = 0; c < 4; ++c)
+            {
+                glm::vec4 p = sprite.Transform * glm::vec4(corners[c], 0.0f, 1.0f);
+                v[c].Position = { p.x, p.y, p.z };
+                v[c].Color = sprite.Color;
+                v[c].TexCoord = uvs[c];
+                v[c].TexIndex = texIndex;
+                v[c].Tiling = sprite.Tiling;
+                v[c].IsText = shaped ? 2.0f : 0.0f;
+                v[c].ClipRect = clipRect;
+                v[c].ShapeCoord = glm::packHalf(corners[c] * quadSize);
+                v[c].Shape = shape;
+                v[c].BorderColor = borderColor;
+            }
+            v += 4;
+        }
+    }
+}
+
+// Writes the four corners of a glyph quad (BL, BR, TR, TL) with its first baseline at 'position'.
+static void WriteGlyphVertices(const TextLayout::Glyph& glyph, const glm::vec3& position, const glm::vec4& color, float texIndex, const glm::u16vec4& clipRect, RendererData::QuadVertex* v)
+{
+    float x0 = position.x + glyph.Min.x;
+    float y0 = position.y + glyph.Min.y;
+    float x1 = position.x + glyph.Max.x;
+    float y1 = position.y + glyph.Max.y;
+
+    const glm::vec3 corners[4] = {
+        { x0, y0, position.z },
+        { x1, y0, position.z },
+        { x1, y1, position.z },
+        { x0, y1, position.z },
+    };
+    const glm::vec2 uvs[4] = {
+        { glyph.UVMin.x, glyph.UVMax.y },
+        { glyph.UVMax.x, glyph.UVMax.y },
+        { glyph.UVMax.x, glyph.UVMin.y },
+        { glyph.UVMin.x, glyph.UVMin.y },
+    };
+
+    for (int c = 0; c < 4; ++c)
+    {
+        v[c].Position = corners[c];
+        v[c].Color = color;
+        v[c].TexCoord = uvs[c];
+        v[c].TexIndex = texIndex;
+        v[c].Tiling = 1.0f;
+        v[c].IsText = 1.0f;
+        v[c].ClipRect = clipRect;
+    }
+}
+
+// Packs quads into the ranges of a StaticBatch with the same slot assignment as the dynamic batcher.
+// A range closes when the pipeline changes or it runs out of indices or texture slots.
+class StaticBatchWriter
+{
+public:
+    explicit StaticBatchWriter(Renderer::StaticBatch& batch)
+        : m_Batch(batch)
+    {
+        m_Batch.VertexBuffer.Release();
+        m_Batch.Ranges.clear();
+        m_Batch.QuadCount = 0;
+    }
+
+    // Reserves 'quadCount' quads in one range, sampling 'srv' (null for none), and returns their vertices
+    RendererData::QuadVertex* AddQuads(ITextureView* srv, bool isText, uint32_t quadCount, float& outTextureIndex)
+    {
+        bool sameRange = m_Range && m_Range->IsText == isText && m_Range->IndexCount + quadCount * 6 <= s_Data.MaxIndices;
+
+        float textureIndex = 0.0f;
+        if (sameRange && srv)
+        {
+            for (uint32_t slot = 1; slot < (uint32_t)m_Range->Textures.size(); slot++)
+            {
+                if (m_Range->Textures[slot].RawPtr() == srv)
+                {
+                    textureIndex = (float)slot;
+                    break;
+                }
+            }
+        }
+
+        bool needsSlot = srv && textureIndex == 0.0f;
+        if (!sameRange || (needsSlot && m_Range->Textures.size() >= s_Data.MaxTextureSlots))
+        {
+            m_Range = &m_Batch.Ranges.emplace_back();
+            m_Range->BaseVertex = (uint32_t)m_Vertices.size();
+            m_Range->IsText = isText;
+            m_Range->Textures.emplace_back(s_Data.WhiteTexture);
+        }
+
+        if (needsSlot)
+        {
+            textureIndex = (float)m_Range->Textures.size();
+            m_Range->Textures.emplace_back(srv);
+        }
+
+        m_Range->IndexCount += quadCount * 6;
+        m_Batch.QuadCount += quadCount;
+        outTextureIndex = textureIndex;
+
+        m_Vertices.resize(m_Vertices.size() + quadCount * 4);
+        return &m_Vertices[m_Vertices.size() - quadCount * 4];
+    }
+
+    void Finish()
+    {
+        if (m_Vertices.empty())
+            return;
+
+        BufferDesc VBDesc;
+        VBDesc.Name = "Renderer2D Static VB";
+        VBDesc.Usage = USAGE_IMMUTABLE;
+        VBDesc.BindFlags = BIND_VERTEX_BUFFER;
+        VBDesc.Size = m_Vertices.size() * sizeof(RendererData::QuadVertex);
+
+        BufferData VBData;
+        VBData.pData = m_Vertices.data();
+        VBData.DataSize = VBDesc.Size;
+        Window::GetDevice()->CreateBuffer(VBDesc, &VBData, &m_Batch.VertexBuffer);
+        ResourceState::Request(m_Batch.VertexBuffer, RESOURCE_STATE_VERTEX_BUFFER);
+    }
+
+private:
+    Renderer::StaticBatch& m_Batch;
+    Renderer::StaticBatch::Range* m_Range = nullptr;
+    std::vector<RendererData::QuadVertex> m_Vertices;
+};
+
 void Renderer::Init()
 {
     auto device = Window::GetDevice();
     auto& ResMgr = ResourceManager::GetInstance();
 
+    // Shaders and pipelines below come from the disk cache when their sources are unchanged
+    PipelineCache::Init();
+
     // Ensure shaders are loaded
     ResMgr.LoadShadersFromDir();
 
@@ -116,6 +779,7 @@ void Renderer::Init()
         RefCntAutoPtr<ITexture> texture;
         device->CreateTexture(TexDesc, &InitData, &texture);
         s_Data.WhiteTexture = texture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+        ResourceState::Request(texture, RESOURCE_STATE_SHADER_RESOURCE);
         
         s_Data.TextureSlots[0] = s_Data.WhiteTexture;
     }
@@ -135,7 +799,7 @@ void Renderer::Init()
     {
         // Create Dynamic Vertex Buffer
         BufferDesc VBDesc;
-        VBDesc.Name = "Renderer2D Dynamic VB";
+        VBDesc.Name = "Renderer2D Vertex Ring";
         VBDesc.Size = s_Data.MaxVertices * sizeof(RendererData::QuadVertex);
         VBDesc.Usage = USAGE_DYNAMIC;
         VBDesc.BindFlags = BIND_VERTEX_BUFFER;
@@ -143,6 +807,9 @@ void Renderer::Init()
         device->CreateBuffer(VBDesc, nullptr, &s_Data.QuadVB);
 
         s_Data.QuadBufferBase = new RendererData::QuadVertex[s_Data.MaxVertices];
+        s_Data.QuadBufferPtr = s_Data.QuadBufferBase;
+        s_Data.BatchStartPtr = s_Data.QuadBufferBase;
+        s_Data.Batches.reserve(64);
 
         // Create Static Index Buffer
         uint32_t* indices = new uint32_t[s_Data.MaxIndices];
@@ -170,6 +837,7 @@ void Renderer::Init()
         IBData.pData = indices;
         IBData.DataSize = s_Data.MaxIndices * sizeof(uint32_t);
         device->CreateBuffer(IBDesc, &IBData, &s_Data.QuadIB);
+        ResourceState::Request(s_Data.QuadIB, RESOURCE_STATE_INDEX_BUFFER);
         delete[] indices;
 
         // Create PSO
@@ -197,7 +865,11 @@ void Renderer::Init()
             LayoutElement{ 2, 0, 2, VT_FLOAT32, False }, // TexCoord
             LayoutElement{ 3, 0, 1, VT_FLOAT32, False }, // TexIndex
             LayoutElement{ 4, 0, 1, VT_FLOAT32, False }, // Tiling
-            LayoutElement{ 5, 0, 1, VT_FLOAT32, False }  // IsText
+            LayoutElement{ 5, 0, 1, VT_FLOAT32, False }, // IsText
+            LayoutElement{ 6, 0, 4, VT_UINT16, False },  // ClipRect
+            LayoutElement{ 7, 0, 2, VT_FLOAT16, False }, // ShapeCoord
+            LayoutElement{ 8, 0, 4, VT_FLOAT16, False }, // Shape
+            LayoutElement{ 9, 0, 4, VT_UINT8, True }     // BorderColor
         };
         PSOCreateInfo.GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
         PSOCreateInfo.GraphicsPipeline.InputLayout.NumElements = _countof(LayoutElems);
@@ -266,12 +938,10 @@ void Renderer::Init()
             PSOCreateInfo.pPS = pPS;
             PSOCreateInfo.PSODesc.Name = "Renderer2D Quad PSO";
 
-            device->CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.QuadPSO);
+            PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.QuadPSO);
             
             if (auto* pVar = s_Data.QuadPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "GlobalConstants"))
                 pVar->Set(s_Data.GlobalConstantBuffer);
-
-            s_Data.QuadPSO->CreateShaderResourceBinding(&s_Data.QuadSRB, true);
         }
 
         // --- Text PSO ---
@@ -289,48 +959,214 @@ void Renderer::Init()
             PSOCreateInfo.pPS = pPS;
             PSOCreateInfo.PSODesc.Name = "Renderer2D Text PSO";
 
-            device->CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.TextPSO);
+            PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.TextPSO);
             
             if (auto* pVar = s_Data.TextPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "GlobalConstants"))
                 pVar->Set(s_Data.GlobalConstantBuffer);
+        }
+
+        // --- Bindless PSO ---
+        // The stock shaders over the large texture table. A custom 'renderer2d' or 'text' shader keeps the
+        // per-batch sets, since it was written against the 32-slot array.
+        bool customShaders = ResMgr.GetShader("renderer2d") || ResMgr.GetShader("text");
+        RefCntAutoPtr<IShader> bindlessPS;
+        if (device->GetDeviceInfo().Features.BindlessResources != DEVICE_FEATURE_STATE_DISABLED && !customShaders)
+        {
+            RefCntAutoPtr<IShaderSourceInputStreamFactory> sourceFactory;
+            Window::GetEngineFactory()->CreateDefaultShaderSourceStreamFactory(ResMgr.GetShaderDirectory().c_str(), &sourceFactory);
+
+            ShaderCreateInfo ShaderCI;
+            ShaderCI.pShaderSourceStreamFactory = sourceFactory;
+            ShaderCI.SourceLanguage = SHADER_SOURCE_LANGUAGE_HLSL;
+            ShaderCI.Desc.UseCombinedTextureSamplers = false;
+            ShaderCI.Desc.ShaderType = SHADER_TYPE_PIXEL;
+            ShaderCI.Desc.Name = "Renderer2D Bindless Pixel Shader";
+            ShaderCI.FilePath = "BasicBindlessPixel.hlsl";
+            ShaderCI.EntryPoint = "main";
+
+            PipelineCache::CreateShader(ShaderCI, &bindlessPS);
+
+            if (bindlessPS)
+            {
+                PSOCreateInfo.pVS = basicShader->GetVertexShader();
+                PSOCreateInfo.pPS = bindlessPS;
+                PSOCreateInfo.PSODesc.Name = "Renderer2D Bindless PSO";
+                PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.BindlessPSO);
+            }
+
+            if (s_Data.BindlessPSO)
+            {
+                if (auto* pVar = s_Data.BindlessPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "GlobalConstants"))
+                    pVar->Set(s_Data.GlobalConstantBuffer);
+
+                s_Data.BindlessPSO->CreateShaderResourceBinding(&s_Data.BindlessSRB, true);
+                if (s_Data.BindlessSRB)
+                    s_Data.BindlessTextures = s_Data.BindlessSRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_Textures");
+            }
+
+            if (s_Data.BindlessTextures)
+            {
+                // Every slot starts out white, so the table is always fully bound
+                std::vector<IDeviceObject*> pViews(RendererData::BindlessTableSlots, s_Data.WhiteTexture.RawPtr());
+                s_Data.BindlessTextures->SetArray(pViews.data(), 0, RendererData::BindlessTableSlots);
+
+                s_Data.TableSlots.resize(RendererData::BindlessTableSlots);
+                s_Data.TableSlots[0].View = s_Data.WhiteTexture;
+                for (uint32_t slot = RendererData::BindlessTableSlots - 1; slot > 0; --slot)
+                    s_Data.FreeTableSlots.push_back(slot);
+
+                s_Data.Bindless = true;
+                Logger::Info("Renderer: 2D batches sample a bindless table of " + std::to_string(RendererData::BindlessTableSlots) + " textures");
+            }
+            else
+            {
+                Logger::Warn("Renderer: Bindless texture table unavailable, 2D batches use per-batch texture sets");
+            }
+        }
+
+        // --- Layered Sprite PSOs ---
+        // The stock quad shaders (or the bindless ones) with depth testing, for DrawSpritesLayered: the opaque pass
+        // writes depth with blending off, the translucent pass blends and only tests. Custom shaders skip them.
+        if (!customShaders)
+        {
+            auto createLayeredPSO = [&](IShader* pPS, const char* name, bool opaque, RefCntAutoPtr<IPipelineState>& outPSO)
+            {
+                GraphicsPipelineStateCreateInfo LayeredCI = PSOCreateInfo;
+                LayeredCI.pVS = basicShader->GetVertexShader();
+                LayeredCI.pPS = pPS;
+                LayeredCI.PSODesc.Name = name;
+                LayeredCI.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = !opaque;
+                LayeredCI.GraphicsPipeline.DepthStencilDesc.DepthEnable = true;
+                LayeredCI.GraphicsPipeline.DepthStencilDesc.DepthWriteEnable = opaque;
+                LayeredCI.GraphicsPipeline.DepthStencilDesc.DepthFunc = COMPARISON_FUNC_LESS;
+
+                PipelineCache::CreateGraphicsPipelineState(LayeredCI, &outPSO);
+                if (!outPSO)
+                    return false;
+
+                if (auto* pVar = outPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "GlobalConstants"))
+                    pVar->Set(s_Data.GlobalConstantBuffer);
+                return true;
+            };
+
+            bool built = createLayeredPSO(basicShader->GetPixelShader(), "Renderer2D Opaque PSO", true, s_Data.OpaquePSO) &&
+                         createLayeredPSO(basicShader->GetPixelShader(), "Renderer2D Translucent PSO", false, s_Data.TranslucentPSO);
+            if (built && s_Data.Bindless)
+            {
+                // Table batches keep committing BindlessSRB; these share the bindless PSO's resource layout
+                built = createLayeredPSO(bindlessPS, "Renderer2D Bindless Opaque PSO", true, s_Data.BindlessOpaquePSO) &&
+                        createLayeredPSO(bindlessPS, "Renderer2D Bindless Translucent PSO", false, s_Data.BindlessTranslucentPSO);
+            }
 
-            s_Data.TextPSO->CreateShaderResourceBinding(&s_Data.TextSRB, true);
+            s_Data.LayeredPass = built;
+            if (!built)
+                Logger::Warn("Renderer: Depth-tested sprite pipelines unavailable, DrawSpritesLayered draws in painter order");
         }
     }
 
-    // 4. Initialize 3D Pipeline
+    // 4. Initialize Tilemap Pipeline (optional, only when the shader ships)
+    if (Shader* tilemapShader = ResMgr.GetShader("tilemap"))
     {
-        // Create Mesh Constant Buffer
         BufferDesc CBDesc;
-        CBDesc.Name = "Renderer Mesh CB";
-        CBDesc.Size = sizeof(RendererData::MeshConstants);
+        CBDesc.Name = "Renderer Tilemap CB";
+        CBDesc.Size = sizeof(RendererData::TilemapConstants);
         CBDesc.Usage = USAGE_DYNAMIC;
         CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
         CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
-        device->CreateBuffer(CBDesc, nullptr, &s_Data.MeshConstantBuffer);
+        device->CreateBuffer(CBDesc, nullptr, &s_Data.TilemapConstantBuffer);
 
         GraphicsPipelineStateCreateInfo PSOCreateInfo;
-        PSOCreateInfo.PSODesc.Name = "Renderer3D PSO";
+        PSOCreateInfo.PSODesc.Name = "Renderer2D Tilemap PSO";
         PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
         PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
         PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = TEX_FORMAT_RGBA8_UNORM;
         PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_D24_UNORM_S8_UINT;
-        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
-        
-        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_BACK;
-        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = true;
-        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthWriteEnable = true;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP;
 
-        // Standard Mesh Layout: Pos(3), Normal(3), UV(2)
-        LayoutElement LayoutElems[] = {
-            LayoutElement{ 0, 0, 3, VT_FLOAT32, False }, // Position
-            LayoutElement{ 1, 0, 3, VT_FLOAT32, False }, // Normal
-            LayoutElement{ 2, 0, 2, VT_FLOAT32, False }  // UV
+        PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].BlendEnable = true;
+        PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].SrcBlend = BLEND_FACTOR_SRC_ALPHA;
+        PSOCreateInfo.GraphicsPipeline.BlendDesc.RenderTargets[0].DestBlend = BLEND_FACTOR_INV_SRC_ALPHA;
+
+        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = false;
+
+        // No input layout: the vertex shader builds the chunk quad from SV_VertexID
+        PSOCreateInfo.pVS = tilemapShader->GetVertexShader();
+        PSOCreateInfo.pPS = tilemapShader->GetPixelShader();
+
+        ShaderResourceVariableDesc Vars[] = {
+            { SHADER_TYPE_PIXEL, "u_Textures", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC },
+            { SHADER_TYPE_PIXEL, "u_TileData", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC },
+            { SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, "GlobalConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC },
+            { SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, "TilemapConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC }
         };
-        PSOCreateInfo.GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
-        PSOCreateInfo.GraphicsPipeline.InputLayout.NumElements = _countof(LayoutElems);
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
 
-        // Use a simple 3D shader
+        // Point sampling keeps pixel-art tiles crisp; clamping stops the sheet edge bleeding across
+        SamplerDesc SamPoint;
+        SamPoint.MinFilter = FILTER_TYPE_POINT;
+        SamPoint.MagFilter = FILTER_TYPE_POINT;
+        SamPoint.MipFilter = FILTER_TYPE_POINT;
+        SamPoint.AddressU = TEXTURE_ADDRESS_CLAMP;
+        SamPoint.AddressV = TEXTURE_ADDRESS_CLAMP;
+
+        ImmutableSamplerDesc ImtblSamplers[] = {
+            { SHADER_TYPE_PIXEL, "u_Sampler", SamPoint },
+            { SHADER_TYPE_PIXEL, "u_SamplerLinear", SamPoint }
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = ImtblSamplers;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = _countof(ImtblSamplers);
+
+        PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.TilemapPSO);
+
+        if (s_Data.TilemapPSO)
+        {
+            for (SHADER_TYPE stage : { SHADER_TYPE_VERTEX, SHADER_TYPE_PIXEL })
+            {
+                if (auto* pVar = s_Data.TilemapPSO->GetStaticVariableByName(stage, "GlobalConstants"))
+                    pVar->Set(s_Data.GlobalConstantBuffer);
+                if (auto* pVar = s_Data.TilemapPSO->GetStaticVariableByName(stage, "TilemapConstants"))
+                    pVar->Set(s_Data.TilemapConstantBuffer);
+            }
+
+            s_Data.TilemapPSO->CreateShaderResourceBinding(&s_Data.TilemapSRB, true);
+        }
+    }
+    else
+    {
+        Logger::Warn("Renderer: 'tilemap' shader not found. Tilemaps will not be drawn.");
+    }
+
+    // 5. Initialize 3D Pipeline
+    {
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Renderer3D PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = TEX_FORMAT_RGBA8_UNORM;
+        PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_D24_UNORM_S8_UINT;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+        
+        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_BACK;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = true;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthWriteEnable = true;
+
+        // Standard Mesh Layout: Pos(3), Normal(3), UV(2), then the per-instance world matrix and color on slot 1
+        LayoutElement LayoutElems[] = {
+            LayoutElement{ 0, 0, 3, VT_FLOAT32, False }, // Position
+            LayoutElement{ 1, 0, 3, VT_FLOAT32, False }, // Normal
+            LayoutElement{ 2, 0, 2, VT_FLOAT32, False }, // UV
+            LayoutElement{ 3, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE }, // World column 0
+            LayoutElement{ 4, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE }, // World column 1
+            LayoutElement{ 5, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE }, // World column 2
+            LayoutElement{ 6, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE }, // World column 3
+            LayoutElement{ 7, 1, 4, VT_FLOAT32, False, INPUT_ELEMENT_FREQUENCY_PER_INSTANCE }  // Color
+        };
+        PSOCreateInfo.GraphicsPipeline.InputLayout.LayoutElements = LayoutElems;
+        PSOCreateInfo.GraphicsPipeline.InputLayout.NumElements = _countof(LayoutElems);
+
+        // Use a simple 3D shader
         auto& ResMgr = ResourceManager::GetInstance();
         Shader* basic3DShader = ResMgr.GetShader("basic3d");
         if (!basic3DShader)
@@ -356,8 +1192,7 @@ void Renderer::Init()
 
         ShaderResourceVariableDesc Vars[] = {
             { SHADER_TYPE_PIXEL, "u_Texture", SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC },
-            { SHADER_TYPE_VERTEX, "GlobalConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC },
-            { SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, "MeshConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC }
+            { SHADER_TYPE_VERTEX, "GlobalConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC }
         };
         PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
         PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
@@ -374,33 +1209,144 @@ void Renderer::Init()
         PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = ImtblSamplers;
         PSOCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = _countof(ImtblSamplers);
 
-        device->CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.MeshPSO);
+        PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.MeshPSO);
         
         if (auto* pVar = s_Data.MeshPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "GlobalConstants"))
             pVar->Set(s_Data.GlobalConstantBuffer);
-        if (auto* pVar = s_Data.MeshPSO->GetStaticVariableByName(SHADER_TYPE_VERTEX, "MeshConstants"))
-            pVar->Set(s_Data.MeshConstantBuffer);
-        if (auto* pVar = s_Data.MeshPSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "MeshConstants"))
-            pVar->Set(s_Data.MeshConstantBuffer);
 
         s_Data.MeshPSO->CreateShaderResourceBinding(&s_Data.MeshSRB, true);
     }
+
+    // 6. Initialize Upscale Pipeline and World Pass Timing (dynamic resolution)
+    if (Shader* upscaleShader = ResMgr.GetShader("upscale"))
+    {
+        BufferDesc CBDesc;
+        CBDesc.Name = "Renderer Upscale CB";
+        CBDesc.Size = sizeof(RendererData::UpscaleConstants);
+        CBDesc.Usage = USAGE_DYNAMIC;
+        CBDesc.BindFlags = BIND_UNIFORM_BUFFER;
+        CBDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        device->CreateBuffer(CBDesc, nullptr, &s_Data.UpscaleConstantBuffer);
+
+        GraphicsPipelineStateCreateInfo PSOCreateInfo;
+        PSOCreateInfo.PSODesc.Name = "Renderer Upscale PSO";
+        PSOCreateInfo.PSODesc.PipelineType = PIPELINE_TYPE_GRAPHICS;
+        PSOCreateInfo.GraphicsPipeline.NumRenderTargets = 1;
+        PSOCreateInfo.GraphicsPipeline.RTVFormats[0] = TEX_FORMAT_RGBA8_UNORM;
+        PSOCreateInfo.GraphicsPipeline.DSVFormat = TEX_FORMAT_D24_UNORM_S8_UINT;
+        PSOCreateInfo.GraphicsPipeline.PrimitiveTopology = PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+
+        // Overwrites the back buffer; no vertex input, the triangle comes from SV_VertexID
+        PSOCreateInfo.GraphicsPipeline.RasterizerDesc.CullMode = CULL_MODE_NONE;
+        PSOCreateInfo.GraphicsPipeline.DepthStencilDesc.DepthEnable = false;
+
+        PSOCreateInfo.pVS = upscaleShader->GetVertexShader();
+        PSOCreateInfo.pPS = upscaleShader->GetPixelShader();
+
+        ShaderResourceVariableDesc Vars[] = {
+            { SHADER_TYPE_PIXEL, "u_Source", SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE },
+            { SHADER_TYPE_PIXEL, "UpscaleConstants", SHADER_RESOURCE_VARIABLE_TYPE_STATIC }
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.Variables = Vars;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumVariables = _countof(Vars);
+
+        SamplerDesc SamLinearClamp;
+        SamLinearClamp.MinFilter = FILTER_TYPE_LINEAR;
+        SamLinearClamp.MagFilter = FILTER_TYPE_LINEAR;
+        SamLinearClamp.MipFilter = FILTER_TYPE_LINEAR;
+        SamLinearClamp.AddressU = TEXTURE_ADDRESS_CLAMP;
+        SamLinearClamp.AddressV = TEXTURE_ADDRESS_CLAMP;
+
+        ImmutableSamplerDesc ImtblSamplers[] = {
+            { SHADER_TYPE_PIXEL, "u_SourceSampler", SamLinearClamp }
+        };
+        PSOCreateInfo.PSODesc.ResourceLayout.ImmutableSamplers = ImtblSamplers;
+        PSOCreateInfo.PSODesc.ResourceLayout.NumImmutableSamplers = _countof(ImtblSamplers);
+
+        PipelineCache::CreateGraphicsPipelineState(PSOCreateInfo, &s_Data.UpscalePSO);
+
+        if (s_Data.UpscalePSO)
+        {
+            if (auto* pVar = s_Data.UpscalePSO->GetStaticVariableByName(SHADER_TYPE_PIXEL, "UpscaleConstants"))
+                pVar->Set(s_Data.UpscaleConstantBuffer);
+        }
+    }
+    else
+    {
+        Logger::Warn("Renderer: 'upscale' shader not found, the world pass always renders at native resolution");
+    }
+
+    if (device->GetDeviceInfo().Features.DurationQueries != DEVICE_FEATURE_STATE_DISABLED)
+    {
+        QueryDesc TimingDesc;
+        TimingDesc.Name = "Renderer World Pass Timing";
+        TimingDesc.Type = QUERY_TYPE_DURATION;
+
+        bool created = true;
+        for (auto& query : s_Data.TimingQueries)
+        {
+            device->CreateQuery(TimingDesc, &query);
+            created = created && query != nullptr;
+        }
+        s_Data.ResolutionStats.TimingAvailable = created;
+    }
+
+    if (!s_Data.ResolutionStats.TimingAvailable)
+        Logger::Warn("Renderer: Duration queries unavailable, dynamic resolution keeps a fixed scale");
+
+    GpuParticleSystem::Init(s_Data.GlobalConstantBuffer);
+
+    PipelineCache::ReportStartup("Renderer");
 }
 
 void Renderer::Shutdown()
 {
     delete[] s_Data.QuadBufferBase;
+    s_Data.QuadBufferBase = nullptr;
+    s_Data.Batches.clear();
     s_Data.QuadVB.Release();
     s_Data.QuadIB.Release();
+    s_Data.SRBCache.clear();
     s_Data.QuadPSO.Release();
-    s_Data.QuadSRB.Release();
     s_Data.TextPSO.Release();
-    s_Data.TextSRB.Release();
+    s_Data.Bindless = false;
+    s_Data.BindlessTextures = nullptr;
+    s_Data.BindlessSRB.Release();
+    s_Data.BindlessPSO.Release();
+    s_Data.LayeredPass = false;
+    s_Data.OpaquePSO.Release();
+    s_Data.TranslucentPSO.Release();
+    s_Data.BindlessOpaquePSO.Release();
+    s_Data.BindlessTranslucentPSO.Release();
+    s_Data.TableSlots.clear();
+    s_Data.TableLookup.clear();
+    s_Data.FreeTableSlots.clear();
     s_Data.MeshPSO.Release();
     s_Data.MeshSRB.Release();
+    s_Data.TilemapPSO.Release();
+    s_Data.TilemapSRB.Release();
+    s_Data.TilemapConstantBuffer.Release();
+    s_Data.OffscreenDepth.Release();
+    s_Data.UpscalePSO.Release();
+    s_Data.UpscaleSRB.Release();
+    s_Data.UpscaleConstantBuffer.Release();
+    s_Data.WorldColor.Release();
+    s_Data.WorldDepth.Release();
+    for (uint32_t i = 0; i < RendererData::TimingQueryCount; ++i)
+    {
+        s_Data.TimingQueries[i].Release();
+        s_Data.TimingPending[i] = false;
+    }
+    s_Data.ResolutionStats.TimingAvailable = false;
     s_Data.WhiteTexture.Release();
     s_Data.GlobalConstantBuffer.Release();
-    s_Data.MeshConstantBuffer.Release();
+    s_Data.MeshInstanceBuffer.Release();
+    s_Data.MeshInstanceCapacity = 0;
+    s_Data.MeshQueue.clear();
+    GpuParticleSystem::Shutdown();
+    ResourceState::Clear();
+
+    PipelineCache::Shutdown();
 }
 
 void Renderer::BeginScene(Camera& camera)
@@ -409,7 +1355,10 @@ void Renderer::BeginScene(Camera& camera)
     {
         MapHelper<RendererData::GlobalConstants> CBData(Window::GetContext(), s_Data.GlobalConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
         CBData->ViewProjection = camera.GetViewProjectionMatrix();
+        CBData->Time = (float)glfwGetTime();
     }
+    s_Data.SceneViewProj = camera.GetViewProjectionMatrix();
+    s_Data.CurrentViewProj = s_Data.SceneViewProj;
 
     StartBatch();
 }
@@ -420,125 +1369,272 @@ void Renderer::BeginScene(const glm::mat4& viewProj)
     {
         MapHelper<RendererData::GlobalConstants> CBData(Window::GetContext(), s_Data.GlobalConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
         CBData->ViewProjection = viewProj;
+        CBData->Time = (float)glfwGetTime();
     }
+    s_Data.SceneViewProj = viewProj;
+    s_Data.CurrentViewProj = viewProj;
 
     StartBatch();
 }
 
 void Renderer::EndScene()
 {
-    Flush();
+    Flush(BatchBreak::EndScene);
+    SubmitBatches();
+    StartBatch();
+}
+
+void Renderer::BeginFrame()
+{
+    // The previous frame's ring allocation belongs to the GPU now; the first upload of this frame discards it.
+    s_Data.RingDiscarded = false;
+    s_Data.RingCursor = 0;
+
+    // Drop bindings no batch has used for a while; they hold references to their textures
+    s_Data.FrameIndex++;
+    for (auto it = s_Data.SRBCache.begin(); it != s_Data.SRBCache.end();)
+    {
+        if (s_Data.FrameIndex - it->second.LastUsedFrame > RendererData::SRBCacheMaxAge)
+            it = s_Data.SRBCache.erase(it);
+        else
+            ++it;
+    }
+
+    for (auto it = s_Data.StringCache.begin(); it != s_Data.StringCache.end();)
+    {
+        if (s_Data.FrameIndex - it->second.LastUsedFrame > RendererData::StringCacheMaxAge)
+            it = s_Data.StringCache.erase(it);
+        else
+            ++it;
+    }
+
+    if (s_Data.Bindless)
+        ReleaseTableSlots(false);
+
+    std::swap(s_Data.FrameReport, s_Data.LastFrameReport);
+    s_Data.FrameReport.clear();
+
+    // A push left unpopped would otherwise clip everything drawn from here on
+    assert(s_Data.ClipStack.empty() && "PushClipRect without a matching PopClipRect last frame");
+    s_Data.ClipStack.clear();
+    s_Data.ClipRect = RendererData::NoClip;
+
+    // Window::BeginFrame has just cleared the back buffer's depth
+    s_Data.Depth = {};
+
+    // Resources created between frames (scene loads, script textures) settle before the first draw
+    s_Data.Stats.StateTransitions += ResourceState::Flush();
 }
 
 void Renderer::StartBatch()
 {
     s_Data.QuadIndexCount = 0;
-    s_Data.QuadBufferPtr = s_Data.QuadBufferBase;
+    s_Data.BatchStartPtr = s_Data.QuadBufferPtr;
     s_Data.TextureSlotIndex = 1;
+    s_Data.BatchSerial++;
+    s_Data.BatchTableTextures = 1;
     s_Data.CurrentPipeline = RendererData::PipelineType::None;
 }
 
-void Renderer::NextBatch()
+void Renderer::NextBatch(BatchBreak reason)
 {
-    Flush();
+    Flush(reason);
+
+    // Out of staging space: upload and draw what we have, then start filling from the beginning again.
+    // A full bindless table likewise: once everything sampling it is submitted, its slots can be reassigned.
+    bool tableFull = reason == BatchBreak::TextureSlots && s_Data.Bindless;
+    if (tableFull || s_Data.QuadBufferPtr + 4 > s_Data.QuadBufferBase + s_Data.MaxVertices)
+        SubmitBatches();
+    if (tableFull)
+        ReleaseTableSlots(true);
+
     StartBatch();
 }
 
-void Renderer::Flush()
+void Renderer::Flush(BatchBreak reason)
+{
+    if (s_Data.QuadIndexCount == 0)
+        return;
+
+    uint32_t textureCount = s_Data.Bindless ? s_Data.BatchTableTextures : s_Data.TextureSlotIndex;
+    BatchPipeline pipeline = BatchPipeline::Quad;
+    if (s_Data.CurrentPipeline == RendererData::PipelineType::Text)
+        pipeline = BatchPipeline::Text;
+    else if (s_Data.CurrentPipeline == RendererData::PipelineType::Opaque)
+        pipeline = BatchPipeline::Opaque;
+    else if (s_Data.CurrentPipeline == RendererData::PipelineType::Translucent)
+        pipeline = BatchPipeline::Translucent;
+    RecordBatch(reason, pipeline, 1, s_Data.QuadIndexCount / 6, textureCount);
+
+    RendererData::BatchCommand& batch = s_Data.Batches.emplace_back();
+    batch.Pipeline = s_Data.CurrentPipeline;
+    batch.BaseVertex = (uint32_t)(s_Data.BatchStartPtr - s_Data.QuadBufferBase);
+    batch.IndexCount = s_Data.QuadIndexCount;
+    batch.UsesTable = s_Data.Bindless;
+    batch.TextureCount = s_Data.TextureSlotIndex;
+    for (uint32_t i = 0; i < s_Data.TextureSlotIndex; ++i)
+        batch.Textures[i] = s_Data.TextureSlots[i];
+
+    // The next batch continues right after this one in the staging buffer.
+    s_Data.QuadIndexCount = 0;
+    s_Data.BatchStartPtr = s_Data.QuadBufferPtr;
+    s_Data.BatchSerial++;
+    s_Data.BatchTableTextures = 1;
+}
+
+void Renderer::SubmitBatches()
 {
-    if (s_Data.QuadIndexCount == 0 || !s_Data.QuadPSO || !s_Data.QuadVB || !s_Data.QuadIB)
+    // Queued meshes were all drawn before any batch still pending (DrawMesh submits those first)
+    SubmitMeshes();
+
+    if (s_Data.Batches.empty() || !s_Data.QuadPSO || !s_Data.QuadVB || !s_Data.QuadIB)
+    {
+        s_Data.Batches.clear();
+        s_Data.QuadBufferPtr = s_Data.QuadBufferBase;
+        s_Data.BatchStartPtr = s_Data.QuadBufferBase;
         return;
+    }
 
     auto context = Window::GetContext();
 
-    // 1. Update Vertex Buffer
-    uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.QuadBufferPtr - (uint8_t*)s_Data.QuadBufferBase);
+    // 1. Upload every staged batch with a single map into the frame ring
+    uint32_t vertexCount = (uint32_t)(s_Data.QuadBufferPtr - s_Data.QuadBufferBase);
+
+    MAP_FLAGS mapFlags = MAP_FLAG_NO_OVERWRITE;
+    if (vertexCount > 0 && (!s_Data.RingDiscarded || s_Data.RingCursor + vertexCount > s_Data.MaxVertices))
+    {
+        // First upload of the frame, or the ring wrapped: take a fresh allocation.
+        // Draws already recorded keep referencing the previous one.
+        mapFlags = MAP_FLAG_DISCARD;
+        s_Data.RingCursor = 0;
+        s_Data.RingDiscarded = true;
+    }
+
+    if (vertexCount > 0)
     {
-        MapHelper<RendererData::QuadVertex> VBData(context, s_Data.QuadVB, MAP_WRITE, MAP_FLAG_DISCARD);
+        MapHelper<RendererData::QuadVertex> VBData(context, s_Data.QuadVB, MAP_WRITE, mapFlags);
         if (!VBData)
         {
-            Logger::Error("Renderer: Failed to map vertex buffer. Dynamic heap might be exhausted.");
+            Logger::Error("Renderer: Failed to map vertex ring. Dynamic heap might be exhausted.");
+            s_Data.Batches.clear();
+            s_Data.QuadBufferPtr = s_Data.QuadBufferBase;
+            s_Data.BatchStartPtr = s_Data.QuadBufferBase;
             return;
         }
-            
-        memcpy(VBData, s_Data.QuadBufferBase, dataSize);
+
+        RendererData::QuadVertex* pDst = VBData;
+        memcpy(pDst + s_Data.RingCursor, s_Data.QuadBufferBase, vertexCount * sizeof(RendererData::QuadVertex));
     }
 
-    // 2. Bind Pipeline
-    IPipelineState* pPSO = nullptr;
-    IShaderResourceBinding* pSRB = nullptr;
+    // Everything written since the last submit (uploads, mips, new buffers) becomes readable in one barrier batch
+    s_Data.Stats.StateTransitions += ResourceState::Flush();
 
-    if (s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-    {
-        pPSO = s_Data.TextPSO;
-        pSRB = s_Data.TextSRB;
-    }
-    else
-    {
-        pPSO = s_Data.QuadPSO;
-        pSRB = s_Data.QuadSRB;
-    }
+    // 2. Bind the shared index buffer once; vertex buffers only change between ring and static batches
+    context->SetIndexBuffer(s_Data.QuadIB, 0, ResourceState::BindMode);
+    IBuffer* boundVB = nullptr;
 
-    context->SetPipelineState(pPSO);
+    // 3. Replay batches
+    IPipelineState* boundPSO = nullptr;
+    IShaderResourceBinding* committedSRB = nullptr;
+    RendererData::TextureSetKey key;
 
-    // 3. Bind Textures
-    if (auto* pVar = pSRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_Textures"))
+    for (const auto& batch : s_Data.Batches)
     {
-        std::vector<IDeviceObject*> pViews(s_Data.MaxTextureSlots);
-        for (uint32_t i = 0; i < s_Data.TextureSlotIndex; ++i)
-            pViews[i] = s_Data.TextureSlots[i];
-        for (uint32_t i = s_Data.TextureSlotIndex; i < s_Data.MaxTextureSlots; ++i)
-            pViews[i] = s_Data.WhiteTexture;
+        IBuffer* pVB = batch.VertexBuffer ? batch.VertexBuffer : s_Data.QuadVB.RawPtr();
+        if (pVB != boundVB)
+        {
+            IBuffer* pVBs[] = { pVB };
+            Uint64 offsets[] = { 0 };
+            context->SetVertexBuffers(0, 1, pVBs, offsets, ResourceState::BindMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+            boundVB = pVB;
+        }
+
+        IPipelineState* pPSO = GetBatchPSO(batch);
+        IShaderResourceBinding* pSRB = nullptr;
+        if (batch.UsesTable)
+        {
+            // Every table batch shares one SRB, committed once per submission
+            pSRB = s_Data.BindlessSRB;
+        }
+        else
+        {
+            // Consecutive batches over the same texture set share one SRB and one commit
+            key.Pipeline = batch.Pipeline == RendererData::PipelineType::None ? RendererData::PipelineType::Quad : batch.Pipeline;
+            for (uint32_t i = 0; i < batch.TextureCount; ++i)
+                key.Views[i] = batch.Textures[i];
+            for (uint32_t i = batch.TextureCount; i < s_Data.MaxTextureSlots; ++i)
+                key.Views[i] = s_Data.WhiteTexture;
+
+            pSRB = GetBatchSRB(key, pPSO);
+        }
+
+        if (!pSRB)
+            continue;
+
+        if (pPSO != boundPSO)
+        {
+            context->SetPipelineState(pPSO);
+            boundPSO = pPSO;
+        }
+
+        if (pSRB != committedSRB)
+        {
+            context->CommitShaderResources(pSRB, ResourceState::BindMode);
+            committedSRB = pSRB;
+        }
 
-        pVar->SetArray(pViews.data(), 0, s_Data.MaxTextureSlots);
+        DrawIndexedAttribs DrawAttrs;
+        DrawAttrs.NumIndices = batch.IndexCount;
+        DrawAttrs.IndexType = VT_UINT32;
+        DrawAttrs.BaseVertex = batch.VertexBuffer ? batch.BaseVertex : s_Data.RingCursor + batch.BaseVertex;
+        DrawAttrs.Flags = ResourceState::DrawFlags;
+        context->DrawIndexed(DrawAttrs);
+
+        s_Data.Stats.DrawCalls++;
     }
-    context->CommitShaderResources(pSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
 
-    // 4. Draw
-    IBuffer* pVBs[] = { s_Data.QuadVB };
-    Uint64 offsets[] = { 0 };
-    context->SetVertexBuffers(0, 1, pVBs, offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-    context->SetIndexBuffer(s_Data.QuadIB, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    s_Data.RingCursor += vertexCount;
 
-    DrawIndexedAttribs DrawAttrs;
-    DrawAttrs.NumIndices = s_Data.QuadIndexCount;
-    DrawAttrs.IndexType = VT_UINT32;
-    DrawAttrs.Flags = DRAW_FLAG_VERIFY_ALL;
-    context->DrawIndexed(DrawAttrs);
+    s_Data.Batches.clear();
+    s_Data.QuadBufferPtr = s_Data.QuadBufferBase;
+    s_Data.BatchStartPtr = s_Data.QuadBufferBase;
+}
 
-    s_Data.Stats.DrawCalls++;
+void Renderer::PushClipRect(float x, float y, float w, float h)
+{
+    // A scaled world pass draws into fewer pixels than the back-buffer rect describes
+    float scale = s_Data.OffscreenTarget ? 1.0f : s_Data.ClipScale;
+
+    // Nested regions only ever shrink the visible area
+    glm::u16vec4 rect = PackClipRect(glm::vec4(x, y, x + w, y + h) * scale);
+    const glm::u16vec4& parent = s_Data.ClipRect;
+    rect = { std::max(rect.x, parent.x), std::max(rect.y, parent.y), std::min(rect.z, parent.z), std::min(rect.w, parent.w) };
+
+    s_Data.ClipStack.push_back(s_Data.ClipRect);
+    s_Data.ClipRect = rect;
+}
+
+void Renderer::PopClipRect()
+{
+    if (s_Data.ClipStack.empty())
+        return;
+
+    s_Data.ClipRect = s_Data.ClipStack.back();
+    s_Data.ClipStack.pop_back();
 }
 
 void Renderer::EnableScissor(float x, float y, float w, float h)
 {
-    Flush();
-    
-    auto context = Window::GetContext();
-    
-    Rect scissor;
-    scissor.left = (Int32)x;
-    scissor.top = (Int32)y;
-    scissor.right = (Int32)(x + w);
-    scissor.bottom = (Int32)(y + h);
-    
-    context->SetScissorRects(1, &scissor, 0, 0);
+    // Replaces any active clipping with a single rect
+    s_Data.ClipStack.clear();
+    s_Data.ClipRect = RendererData::NoClip;
+    PushClipRect(x, y, w, h);
 }
 
 void Renderer::DisableScissor()
 {
-    Flush();
-    
-    auto context = Window::GetContext();
-    auto swapChain = Window::GetSwapChain();
-    const auto& SCDesc = swapChain->GetDesc();
-    
-    Rect scissor;
-    scissor.left = 0;
-    scissor.top = 0;
-    scissor.right = SCDesc.Width;
-    scissor.bottom = SCDesc.Height;
-    
-    context->SetScissorRects(1, &scissor, 0, 0);
+    s_Data.ClipStack.clear();
+    s_Data.ClipRect = RendererData::NoClip;
 }
 
 // ==============================================================================================
@@ -552,8 +1648,8 @@ void Renderer::DrawQuad(const glm::vec2& position, const glm::vec2& size, const
 
 void Renderer::DrawQuad(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color)
 {
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-        NextBatch();
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Quad, false); reason != BatchBreak::None)
+        NextBatch(reason);
 
     s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
 
@@ -571,6 +1667,7 @@ void Renderer::DrawQuad(const glm::vec3& position, const glm::vec2& size, const
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = p1;
@@ -579,6 +1676,7 @@ void Renderer::DrawQuad(const glm::vec3& position, const glm::vec2& size, const
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = p2;
@@ -587,6 +1685,7 @@ void Renderer::DrawQuad(const glm::vec3& position, const glm::vec2& size, const
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = p3;
@@ -595,6 +1694,7 @@ void Renderer::DrawQuad(const glm::vec3& position, const glm::vec2& size, const
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadIndexCount += 6;
@@ -608,34 +1708,23 @@ void Renderer::DrawQuad(const glm::vec2& position, const glm::vec2& size, Textur
 
 void Renderer::DrawQuad(const glm::vec3& position, const glm::vec2& size, Texture* texture, float tiling, const glm::vec4& tintColor)
 {
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots || s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-        NextBatch();
-
-    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Quad, true); reason != BatchBreak::None)
+        NextBatch(reason);
 
     float textureIndex = 0.0f;
+    glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
     if (texture)
     {
-        ITextureView* srv = texture->GetSRV();
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (s_Data.TextureSlots[i] == srv)
-            {
-                textureIndex = (float)i;
-                break;
-            }
-        }
-
-        if (textureIndex == 0.0f)
+        ITextureView* srv = ResolveTextureView(texture, tiling, uvRect);
+        if (!AcquireTextureSlot(srv, textureIndex))
         {
-            if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
-                NextBatch();
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = srv;
-            s_Data.TextureSlotIndex++;
+            NextBatch(BatchBreak::TextureSlots);
+            AcquireTextureSlot(srv, textureIndex);
         }
     }
 
+    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+
     glm::vec3 p0 = { position.x - size.x * 0.5f, position.y - size.y * 0.5f, position.z };
     glm::vec3 p1 = { position.x + size.x * 0.5f, position.y - size.y * 0.5f, position.z };
     glm::vec3 p2 = { position.x + size.x * 0.5f, position.y + size.y * 0.5f, position.z };
@@ -643,34 +1732,38 @@ void Renderer::DrawQuad(const glm::vec3& position, const glm::vec2& size, Textur
 
     s_Data.QuadBufferPtr->Position = p0;
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 0.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x, uvRect.y };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = p1;
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 1.0f, 0.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.z, uvRect.y };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = p2;
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 1.0f, 1.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.z, uvRect.w };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = p3;
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 1.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x, uvRect.w };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadIndexCount += 6;
@@ -684,8 +1777,8 @@ void Renderer::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size,
 
 void Renderer::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color)
 {
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-        NextBatch();
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Quad, false); reason != BatchBreak::None)
+        NextBatch(reason);
 
     s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
 
@@ -707,6 +1800,7 @@ void Renderer::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size,
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p1.x, p1.y, p1.z };
@@ -715,6 +1809,7 @@ void Renderer::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size,
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p2.x, p2.y, p2.z };
@@ -723,6 +1818,7 @@ void Renderer::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size,
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p3.x, p3.y, p3.z };
@@ -731,6 +1827,7 @@ void Renderer::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size,
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadIndexCount += 6;
@@ -744,34 +1841,23 @@ void Renderer::DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size,
 
 void Renderer::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, Texture* texture, float tiling, const glm::vec4& tintColor)
 {
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots || s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-        NextBatch();
-
-    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Quad, true); reason != BatchBreak::None)
+        NextBatch(reason);
 
     float textureIndex = 0.0f;
+    glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
     if (texture)
     {
-        ITextureView* srv = texture->GetSRV();
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (s_Data.TextureSlots[i] == srv)
-            {
-                textureIndex = (float)i;
-                break;
-            }
-        }
-
-        if (textureIndex == 0.0f)
+        ITextureView* srv = ResolveTextureView(texture, tiling, uvRect);
+        if (!AcquireTextureSlot(srv, textureIndex))
         {
-            if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
-                NextBatch();
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = srv;
-            s_Data.TextureSlotIndex++;
+            NextBatch(BatchBreak::TextureSlots);
+            AcquireTextureSlot(srv, textureIndex);
         }
     }
 
+    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+
     glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
         * glm::rotate(glm::mat4(1.0f), glm::radians(rotation), { 0.0f, 0.0f, 1.0f })
         * glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
@@ -783,204 +1869,398 @@ void Renderer::DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size,
 
     s_Data.QuadBufferPtr->Position = { p0.x, p0.y, p0.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 0.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x, uvRect.y };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p1.x, p1.y, p1.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 1.0f, 0.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.z, uvRect.y };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p2.x, p2.y, p2.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 1.0f, 1.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.z, uvRect.w };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p3.x, p3.y, p3.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 1.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x, uvRect.w };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadIndexCount += 6;
     s_Data.Stats.QuadCount++;
 }
 
-void Renderer::DrawString(const std::string& text, Font* font, const glm::vec3& position, float scale, const glm::vec4& color, float wrapWidth)
+void Renderer::DrawSprites(const SpriteInstance* sprites, size_t count)
 {
-    if (!font) return;
+    DrawSpriteList(sprites, nullptr, count);
+}
 
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots || s_Data.CurrentPipeline == RendererData::PipelineType::Quad)
-        NextBatch();
+void Renderer::DrawSpritesLayered(const SpriteInstance* sprites, size_t count)
+{
+    // Depth from list position needs a projection whose depth follows z alone: orthographic, unskewed
+    const glm::mat4& vp = s_Data.CurrentViewProj;
+    bool depthFollowsZ = vp[0][2] == 0.0f && vp[1][2] == 0.0f && vp[2][2] != 0.0f && vp[0][3] == 0.0f && vp[1][3] == 0.0f && vp[2][3] == 0.0f;
+    if (!s_Data.LayeredPass || !depthFollowsZ || count > RendererData::MaxLayeredSprites)
+    {
+        DrawSprites(sprites, count);
+        return;
+    }
 
-    s_Data.CurrentPipeline = RendererData::PipelineType::Text;
+    s_Data.LayerOrder.clear();
+    for (size_t i = count; i-- > 0;)
+    {
+        if (IsSpriteOpaque(sprites[i]))
+            s_Data.LayerOrder.push_back((uint32_t)i);
+    }
 
-    const auto& characters = font->GetCharacters();
-    ITextureView* srv = font->GetAtlasTexture()->GetSRV();
-    float textureIndex = 0.0f;
+    size_t opaqueCount = s_Data.LayerOrder.size();
+    if (opaqueCount == 0)
+    {
+        // Nothing can hide anything; depth would only cost the clears
+        DrawSprites(sprites, count);
+        return;
+    }
 
-    // Find or add texture
-    for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+    for (size_t i = 0; i < count; ++i)
     {
-        if (s_Data.TextureSlots[i] == srv)
-        {
-            textureIndex = (float)i;
-            break;
-        }
+        if (!IsSpriteOpaque(sprites[i]))
+            s_Data.LayerOrder.push_back((uint32_t)i);
     }
 
-    if (textureIndex == 0.0f)
+    // Position p gets depth (count - p) / (count + 1): the back of the list is farthest and every sprite has its own value
+    float w = vp[3][3];
+    float slots = (float)(count + 1);
+    s_Data.LayerZBase = ((float)count / slots * w - vp[3][2]) / vp[2][2];
+    s_Data.LayerZStep = -w / (slots * vp[2][2]);
+
+    // Nothing before this point wrote depth that 2D content should test against; the pass starts from a clear
+    // buffer. Batches already recorded don't test depth, so they only have to go ahead of a clear; queued meshes
+    // will write depth when submitted, so they count as written.
+    Flush(BatchBreak::PipelineSwitch);
+    if (s_Data.Depth.Written || !s_Data.MeshQueue.empty())
     {
-        if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
-            NextBatch();
-        textureIndex = (float)s_Data.TextureSlotIndex;
-        s_Data.TextureSlots[s_Data.TextureSlotIndex] = srv;
-        s_Data.TextureSlotIndex++;
+        SubmitBatches();
+        ClearBoundDepth();
     }
+    StartBatch();
+    s_Data.Depth.Written = true;
+    s_Data.Depth.Sprites = true;
+
+    s_Data.LayerDepth = true;
+    s_Data.SpritePipeline = RendererData::PipelineType::Opaque;
+    DrawSpriteList(sprites, s_Data.LayerOrder.data(), opaqueCount);
+    s_Data.SpritePipeline = RendererData::PipelineType::Translucent;
+    DrawSpriteList(sprites, s_Data.LayerOrder.data() + opaqueCount, count - opaqueCount);
+    s_Data.SpritePipeline = RendererData::PipelineType::Quad;
+    s_Data.LayerDepth = false;
+
+    // The next quad breaks the batch on its own pipeline switch; meshes clear the sprites' depth before drawing
+}
 
-    float startX = position.x;
-    float currentX = 0.0f;
-    float currentY = position.y;
-    float z = position.z;
+void Renderer::DrawSpriteList(const SpriteInstance* sprites, const uint32_t* order, size_t count)
+{
+    // Below this many sprites per range, waking workers costs more than it saves
+    static const size_t MinSpritesPerJob = 256;
 
-    float lineSpacing = font->GetFontSize() * scale;
+    auto spriteAt = [sprites, order](size_t i) -> const SpriteInstance&
+    {
+        return order ? sprites[order[i]] : sprites[i];
+    };
 
-    auto it = text.begin();
-    while (it != text.end())
+    size_t done = 0;
+    while (done < count)
     {
-        // Identify word
-        float wordWidth = 0.0f;
-        std::vector<char> wordChars;
-        auto wordStart = it;
+        if (BatchBreak reason = CheckBatchBreak(s_Data.SpritePipeline, false); reason != BatchBreak::None)
+            NextBatch(reason);
 
-        while (it != text.end())
-        {
-            char c = *it;
-            if (c == ' ' || c == '\n') break;
-            if (characters.find(c) != characters.end())
-            {
-                wordChars.push_back(c);
-                wordWidth += (characters.at(c).Advance >> 6) * scale;
-            }
-            it++;
-        }
+        s_Data.CurrentPipeline = s_Data.SpritePipeline;
+
+        size_t capacity = (size_t)(s_Data.QuadBufferBase + s_Data.MaxVertices - s_Data.QuadBufferPtr) / 4;
 
-        // Check wrap
-        if (wrapWidth > 0.0f && currentX > 0.0f && (currentX + wordWidth > wrapWidth))
+        // As many sprites as there are quads left; a nine-slice takes nine
+        s_Data.SpriteScratch.resize(std::min(capacity, count - done));
+        size_t chunk = 0;
+        uint32_t chunkQuads = 0;
+        while (chunk < s_Data.SpriteScratch.size())
         {
-            currentX = 0.0f;
-            currentY -= lineSpacing;
+            uint32_t quads = SpriteQuadCount(spriteAt(done + chunk));
+            if (chunkQuads + quads > capacity)
+                break;
+            s_Data.SpriteScratch[chunk++].FirstQuad = chunkQuads;
+            chunkQuads += quads;
         }
 
-        // Draw word
-        for (char c : wordChars)
+        if (chunk == 0)
         {
-            const Character& ch = characters.at(c);
-
-            float xpos = startX + currentX + ch.Bearing.x * scale;
-            float ypos = currentY - (ch.Size.y - ch.Bearing.y) * scale;
-
-            float w = ch.Size.x * scale;
-            float h = ch.Size.y * scale;
-
-            // Check batch capacity
-            if (s_Data.QuadIndexCount >= s_Data.MaxIndices)
-                NextBatch();
-
-            s_Data.QuadBufferPtr->Position = { xpos, ypos, z };
-            s_Data.QuadBufferPtr->Color = color;
-            s_Data.QuadBufferPtr->TexCoord = { ch.uvMin.x, ch.uvMax.y }; // BL
-            s_Data.QuadBufferPtr->TexIndex = textureIndex;
-            s_Data.QuadBufferPtr->Tiling = 1.0f;
-            s_Data.QuadBufferPtr->IsText = 1.0f;
-            s_Data.QuadBufferPtr++;
-
-            s_Data.QuadBufferPtr->Position = { xpos + w, ypos, z };
-            s_Data.QuadBufferPtr->Color = color;
-            s_Data.QuadBufferPtr->TexCoord = { ch.uvMax.x, ch.uvMax.y }; // BR
-            s_Data.QuadBufferPtr->TexIndex = textureIndex;
-            s_Data.QuadBufferPtr->Tiling = 1.0f;
-            s_Data.QuadBufferPtr->IsText = 1.0f;
-            s_Data.QuadBufferPtr++;
-
-            s_Data.QuadBufferPtr->Position = { xpos + w, ypos + h, z };
-            s_Data.QuadBufferPtr->Color = color;
-            s_Data.QuadBufferPtr->TexCoord = { ch.uvMax.x, ch.uvMin.y }; // TR
-            s_Data.QuadBufferPtr->TexIndex = textureIndex;
-            s_Data.QuadBufferPtr->Tiling = 1.0f;
-            s_Data.QuadBufferPtr->IsText = 1.0f;
-            s_Data.QuadBufferPtr++;
-
-            s_Data.QuadBufferPtr->Position = { xpos, ypos + h, z };
-            s_Data.QuadBufferPtr->Color = color;
-            s_Data.QuadBufferPtr->TexCoord = { ch.uvMin.x, ch.uvMin.y }; // TL
-            s_Data.QuadBufferPtr->TexIndex = textureIndex;
-            s_Data.QuadBufferPtr->Tiling = 1.0f;
-            s_Data.QuadBufferPtr->IsText = 1.0f;
-            s_Data.QuadBufferPtr++;
-
-            s_Data.QuadIndexCount += 6;
-            s_Data.Stats.QuadCount++;
-
-            currentX += (ch.Advance >> 6) * scale;
+            // Too little staging space left for the next nine-slice: draw what is pending and start over
+            Flush(BatchBreak::VertexBufferFull);
+            SubmitBatches();
+            StartBatch();
+            continue;
         }
 
-        // Handle separators
-        if (it != text.end())
+        RendererData::QuadVertex* chunkBase = s_Data.QuadBufferPtr;
+
+        // 1. Texture slots (serial, order dependent). A sprite that finds no free slot ends the chunk;
+        //    the batch closes once the sprites before it are written.
+        ITextureView* lastSrv = nullptr;
+        float lastIndex = 0.0f;
+        bool slotsFull = false;
+        for (size_t i = 0; i < chunk; ++i)
         {
-            char c = *it;
-            if (c == '\n')
+            const SpriteInstance& sprite = spriteAt(done + i);
+            RendererData::SpriteSetup& setup = s_Data.SpriteScratch[i];
+
+            setup.TexIndex = 0.0f;
+
+            if (ITextureView* srv = ResolveSpriteTexture(sprite, setup.UVRect))
             {
-                currentX = 0.0f;
-                currentY -= lineSpacing;
+                if (srv == lastSrv)
+                {
+                    setup.TexIndex = lastIndex;
+                    continue;
+                }
+
+                if (!AcquireTextureSlot(srv, setup.TexIndex))
+                {
+                    chunk = i;
+                    chunkQuads = setup.FirstQuad;
+                    slotsFull = true;
+                    break;
+                }
+
+                lastSrv = srv;
+                lastIndex = setup.TexIndex;
             }
-            else if (c == ' ')
+        }
+
+        // 2. Vertex generation (parallel). Sprite i owns its quads from FirstQuad on.
+        JobSystem::ParallelFor(chunk, MinSpritesPerJob, [&](size_t begin, size_t end)
+        {
+            for (size_t i = begin; i < end; ++i)
             {
-                if (characters.find(' ') != characters.end())
+                const SpriteInstance& sprite = spriteAt(done + i);
+                const RendererData::SpriteSetup& setup = s_Data.SpriteScratch[i];
+                RendererData::QuadVertex* v = chunkBase + setup.FirstQuad * 4;
+                WriteSpriteVertices(sprite, setup.UVRect, setup.TexIndex, s_Data.ClipRect, v);
+
+                if (s_Data.LayerDepth)
                 {
-                    float spaceW = (characters.at(' ').Advance >> 6) * scale;
-                    // Note: Spaces at end of line might cause wrap on next word, but space itself usually renders.
-                    // If space is at exact wrap edge, it might be weird, but usually acceptable.
-                    currentX += spaceW;
+                    // Blending is off in the opaque pass, so cutout texels are alpha-tested instead
+                    float z = s_Data.LayerZBase + (float)order[done + i] * s_Data.LayerZStep;
+                    bool alphaTest = s_Data.SpritePipeline == RendererData::PipelineType::Opaque;
+                    for (uint32_t k = 0, n = SpriteQuadCount(sprite) * 4; k < n; ++k)
+                    {
+                        v[k].Position.z = z;
+                        if (alphaTest)
+                            v[k].IsText = 3.0f;
+                    }
                 }
             }
-            it++;
-        }
+        });
+
+        s_Data.QuadBufferPtr = chunkBase + chunkQuads * 4;
+        s_Data.QuadIndexCount = (uint32_t)(s_Data.QuadBufferPtr - s_Data.BatchStartPtr) / 4 * 6;
+        s_Data.Stats.QuadCount += chunkQuads;
+
+        done += chunk;
+
+        if (slotsFull)
+            NextBatch(BatchBreak::TextureSlots);
     }
 }
 
-void Renderer::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+void Renderer::BuildStaticBatch(const SpriteInstance* sprites, size_t count, StaticBatch& outBatch)
 {
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-        NextBatch();
+    StaticBatchWriter writer(outBatch);
+    for (size_t i = 0; i < count; ++i)
+    {
+        glm::vec4 uvRect;
+        ITextureView* srv = ResolveSpriteTexture(sprites[i], uvRect);
 
-    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+        float textureIndex = 0.0f;
+        RendererData::QuadVertex* v = writer.AddQuads(srv, false, SpriteQuadCount(sprites[i]), textureIndex);
+        WriteSpriteVertices(sprites[i], uvRect, textureIndex, RendererData::NoClip, v);
+    }
+    writer.Finish();
+}
 
-    const float texIndex = 0.0f; // White Texture
-    const float tiling = 1.0f;
+void Renderer::BuildStaticBatch(const StaticItem* items, size_t count, StaticBatch& outBatch)
+{
+    StaticBatchWriter writer(outBatch);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const StaticItem& item = items[i];
 
-    glm::vec4 p0 = transform * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f);
-    glm::vec4 p1 = transform * glm::vec4( 0.5f, -0.5f, 0.0f, 1.0f);
-    glm::vec4 p2 = transform * glm::vec4( 0.5f,  0.5f, 0.0f, 1.0f);
-    glm::vec4 p3 = transform * glm::vec4(-0.5f,  0.5f, 0.0f, 1.0f);
+        glm::u16vec4 clipRect = RendererData::NoClip;
+        if (item.ClipRect.z > 0.0f && item.ClipRect.w > 0.0f)
+            clipRect = PackClipRect({ item.ClipRect.x, item.ClipRect.y, item.ClipRect.x + item.ClipRect.z, item.ClipRect.y + item.ClipRect.w });
 
-    s_Data.QuadBufferPtr->Position = { p0.x, p0.y, p0.z };
-    s_Data.QuadBufferPtr->Color = color;
-    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 0.0f };
-    s_Data.QuadBufferPtr->TexIndex = texIndex;
-    s_Data.QuadBufferPtr->Tiling = tiling;
+        if (!item.Text)
+        {
+            glm::vec4 uvRect;
+            ITextureView* srv = ResolveSpriteTexture(item.Sprite, uvRect);
+
+            float textureIndex = 0.0f;
+            RendererData::QuadVertex* v = writer.AddQuads(srv, false, SpriteQuadCount(item.Sprite), textureIndex);
+            WriteSpriteVertices(item.Sprite, uvRect, textureIndex, clipRect, v);
+            continue;
+        }
+
+        Font* font = item.Text->GetFont();
+        if (!font)
+            continue;
+
+        // Glyphs rasterized while shaping go up before the batch can sample them
+        font->UploadDirtyPages();
+
+        for (const auto& glyph : item.Text->GetGlyphs())
+        {
+            float textureIndex = 0.0f;
+            RendererData::QuadVertex* v = writer.AddQuads(font->GetPageTexture(glyph.Page)->GetSRV(), true, 1, textureIndex);
+            WriteGlyphVertices(glyph, item.TextPosition, item.Sprite.Color, textureIndex, clipRect, v);
+        }
+    }
+    writer.Finish();
+}
+
+void Renderer::DrawStaticBatch(const StaticBatch& batch)
+{
+    if (!batch.VertexBuffer)
+        return;
+
+    // Keep draw order: everything queued so far goes first
+    Flush(BatchBreak::StaticBatch);
+
+    for (const auto& range : batch.Ranges)
+    {
+        RendererData::BatchCommand& cmd = s_Data.Batches.emplace_back();
+        cmd.Pipeline = range.IsText ? RendererData::PipelineType::Text : RendererData::PipelineType::Quad;
+        cmd.VertexBuffer = batch.VertexBuffer.RawPtr();
+        cmd.BaseVertex = range.BaseVertex;
+        cmd.IndexCount = range.IndexCount;
+        cmd.TextureCount = (uint32_t)range.Textures.size();
+        for (uint32_t i = 0; i < cmd.TextureCount; ++i)
+            cmd.Textures[i] = range.Textures[i].RawPtr();
+
+        RecordBatch(BatchBreak::None, BatchPipeline::Static, 1, range.IndexCount / 6, cmd.TextureCount);
+    }
+
+    s_Data.Stats.QuadCount += batch.QuadCount;
+
+    StartBatch();
+}
+
+void Renderer::DrawString(const std::string& text, Font* font, const glm::vec3& position, float scale, const glm::vec4& color, float wrapWidth)
+{
+    if (!font) return;
+
+    // Every distinct string keeps its own layout, so one redrawn unchanged every frame is shaped once however many
+    // others are drawn around it. Update still compares the text, which also settles the rare hash collision.
+    size_t key = std::hash<std::string>()(text);
+    key ^= std::hash<const void*>()(font) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= std::hash<float>()(scale) + 0x9e3779b9 + (key << 6) + (key >> 2);
+    key ^= std::hash<float>()(wrapWidth) + 0x9e3779b9 + (key << 6) + (key >> 2);
+
+    RendererData::CachedString& entry = s_Data.StringCache[key];
+    entry.LastUsedFrame = s_Data.FrameIndex;
+    entry.Layout.Update(text, font, scale, wrapWidth);
+    entry.Layout.PrepareDraw();
+    DrawTextLayout(entry.Layout, position, color);
+}
+
+void Renderer::DrawTextLayout(const TextLayout& layout, const glm::vec3& position, const glm::vec4& color)
+{
+    Font* font = layout.GetFont();
+    const auto& glyphs = layout.GetGlyphs();
+    if (!font || glyphs.empty()) return;
+
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Text, true); reason != BatchBreak::None)
+        NextBatch(reason);
+
+    s_Data.CurrentPipeline = RendererData::PipelineType::Text;
+
+    // Find or add the atlas page in the current batch
+    auto resolvePageSlot = [](ITextureView* srv) -> float
+    {
+        float textureIndex = 0.0f;
+        if (!AcquireTextureSlot(srv, textureIndex))
+        {
+            NextBatch(BatchBreak::TextureSlots);
+            s_Data.CurrentPipeline = RendererData::PipelineType::Text;
+            AcquireTextureSlot(srv, textureIndex);
+        }
+        return textureIndex;
+    };
+
+    uint32_t currentPage = UINT32_MAX;
+    ITextureView* srv = nullptr;
+    float textureIndex = 0.0f;
+
+    for (const auto& glyph : glyphs)
+    {
+        // Check batch capacity; a new batch starts without the atlas bound, so re-register it
+        if (s_Data.QuadBufferPtr + 4 > s_Data.QuadBufferBase + s_Data.MaxVertices)
+        {
+            NextBatch(BatchBreak::VertexBufferFull);
+            s_Data.CurrentPipeline = RendererData::PipelineType::Text;
+            currentPage = UINT32_MAX;
+        }
+
+        if (glyph.Page != currentPage)
+        {
+            currentPage = glyph.Page;
+            srv = font->GetPageTexture(currentPage)->GetSRV();
+            textureIndex = resolvePageSlot(srv);
+        }
+
+        WriteGlyphVertices(glyph, position, color, textureIndex, s_Data.ClipRect, s_Data.QuadBufferPtr);
+        s_Data.QuadBufferPtr += 4;
+
+        s_Data.QuadIndexCount += 6;
+        s_Data.Stats.QuadCount++;
+    }
+}
+
+void Renderer::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
+{
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Quad, false); reason != BatchBreak::None)
+        NextBatch(reason);
+
+    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+
+    const float texIndex = 0.0f; // White Texture
+    const float tiling = 1.0f;
+
+    glm::vec4 p0 = transform * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f);
+    glm::vec4 p1 = transform * glm::vec4( 0.5f, -0.5f, 0.0f, 1.0f);
+    glm::vec4 p2 = transform * glm::vec4( 0.5f,  0.5f, 0.0f, 1.0f);
+    glm::vec4 p3 = transform * glm::vec4(-0.5f,  0.5f, 0.0f, 1.0f);
+
+    s_Data.QuadBufferPtr->Position = { p0.x, p0.y, p0.z };
+    s_Data.QuadBufferPtr->Color = color;
+    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 0.0f };
+    s_Data.QuadBufferPtr->TexIndex = texIndex;
+    s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p1.x, p1.y, p1.z };
@@ -989,6 +2269,7 @@ void Renderer::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p2.x, p2.y, p2.z };
@@ -997,6 +2278,7 @@ void Renderer::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p3.x, p3.y, p3.z };
@@ -1005,6 +2287,7 @@ void Renderer::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
     s_Data.QuadBufferPtr->TexIndex = texIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadIndexCount += 6;
@@ -1013,34 +2296,23 @@ void Renderer::DrawQuad(const glm::mat4& transform, const glm::vec4& color)
 
 void Renderer::DrawQuad(const glm::mat4& transform, Texture* texture, float tiling, const glm::vec4& tintColor)
 {
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots || s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-        NextBatch();
-
-    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Quad, true); reason != BatchBreak::None)
+        NextBatch(reason);
 
     float textureIndex = 0.0f;
+    glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
     if (texture)
     {
-        ITextureView* srv = texture->GetSRV();
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-        {
-            if (s_Data.TextureSlots[i] == srv)
-            {
-                textureIndex = (float)i;
-                break;
-            }
-        }
-
-        if (textureIndex == 0.0f)
+        ITextureView* srv = ResolveTextureView(texture, tiling, uvRect);
+        if (!AcquireTextureSlot(srv, textureIndex))
         {
-            if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
-                NextBatch();
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = srv;
-            s_Data.TextureSlotIndex++;
+            NextBatch(BatchBreak::TextureSlots);
+            AcquireTextureSlot(srv, textureIndex);
         }
     }
 
+    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+
     glm::vec4 p0 = transform * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f);
     glm::vec4 p1 = transform * glm::vec4( 0.5f, -0.5f, 0.0f, 1.0f);
     glm::vec4 p2 = transform * glm::vec4( 0.5f,  0.5f, 0.0f, 1.0f);
@@ -1048,34 +2320,38 @@ void Renderer::DrawQuad(const glm::mat4& transform, Texture* texture, float tili
 
     s_Data.QuadBufferPtr->Position = { p0.x, p0.y, p0.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 0.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x, uvRect.y };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p1.x, p1.y, p1.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 1.0f, 0.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.z, uvRect.y };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p2.x, p2.y, p2.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 1.0f, 1.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.z, uvRect.w };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p3.x, p3.y, p3.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = { 0.0f, 1.0f };
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x, uvRect.w };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = tiling;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadIndexCount += 6;
@@ -1084,34 +2360,23 @@ void Renderer::DrawQuad(const glm::mat4& transform, Texture* texture, float tili
 
 void Renderer::DrawQuadUV(const glm::mat4& transform, Texture* texture, const glm::vec2 uvs[4], const glm::vec4& tintColor)
 {
-    if (s_Data.QuadIndexCount >= s_Data.MaxIndices || s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots || s_Data.CurrentPipeline == RendererData::PipelineType::Text)
-        NextBatch();
-
-    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+    if (BatchBreak reason = CheckBatchBreak(RendererData::PipelineType::Quad, true); reason != BatchBreak::None)
+        NextBatch(reason);
 
     float textureIndex = 0.0f;
+    glm::vec4 uvRect(0.0f, 0.0f, 1.0f, 1.0f);
     if (texture)
     {
-        ITextureView* srv = texture->GetSRV();
-        for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+        ITextureView* srv = ResolveTextureView(texture, 1.0f, uvRect);
+        if (!AcquireTextureSlot(srv, textureIndex))
         {
-            if (s_Data.TextureSlots[i] == srv)
-            {
-                textureIndex = (float)i;
-                break;
-            }
-        }
-
-        if (textureIndex == 0.0f)
-        {
-            if (s_Data.TextureSlotIndex >= s_Data.MaxTextureSlots)
-                NextBatch();
-            textureIndex = (float)s_Data.TextureSlotIndex;
-            s_Data.TextureSlots[s_Data.TextureSlotIndex] = srv;
-            s_Data.TextureSlotIndex++;
+            NextBatch(BatchBreak::TextureSlots);
+            AcquireTextureSlot(srv, textureIndex);
         }
     }
 
+    s_Data.CurrentPipeline = RendererData::PipelineType::Quad;
+
     glm::vec4 p0 = transform * glm::vec4(-0.5f, -0.5f, 0.0f, 1.0f);
     glm::vec4 p1 = transform * glm::vec4( 0.5f, -0.5f, 0.0f, 1.0f);
     glm::vec4 p2 = transform * glm::vec4( 0.5f,  0.5f, 0.0f, 1.0f);
@@ -1119,40 +2384,460 @@ void Renderer::DrawQuadUV(const glm::mat4& transform, Texture* texture, const gl
 
     s_Data.QuadBufferPtr->Position = { p0.x, p0.y, p0.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = uvs[0];
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x + uvs[0].x * (uvRect.z - uvRect.x), uvRect.y + uvs[0].y * (uvRect.w - uvRect.y) };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = 1.0f;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p1.x, p1.y, p1.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = uvs[1];
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x + uvs[1].x * (uvRect.z - uvRect.x), uvRect.y + uvs[1].y * (uvRect.w - uvRect.y) };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = 1.0f;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p2.x, p2.y, p2.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = uvs[2];
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x + uvs[2].x * (uvRect.z - uvRect.x), uvRect.y + uvs[2].y * (uvRect.w - uvRect.y) };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = 1.0f;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadBufferPtr->Position = { p3.x, p3.y, p3.z };
     s_Data.QuadBufferPtr->Color = tintColor;
-    s_Data.QuadBufferPtr->TexCoord = uvs[3];
+    s_Data.QuadBufferPtr->TexCoord = { uvRect.x + uvs[3].x * (uvRect.z - uvRect.x), uvRect.y + uvs[3].y * (uvRect.w - uvRect.y) };
     s_Data.QuadBufferPtr->TexIndex = textureIndex;
     s_Data.QuadBufferPtr->Tiling = 1.0f;
     s_Data.QuadBufferPtr->IsText = 0.0f;
+    s_Data.QuadBufferPtr->ClipRect = s_Data.ClipRect;
     s_Data.QuadBufferPtr++;
 
     s_Data.QuadIndexCount += 6;
     s_Data.Stats.QuadCount++;
 }
 
+// ==============================================================================================
+// Tilemap Implementation
+// ==============================================================================================
+
+void Renderer::DrawTilemap(Tilemap& tilemap, const glm::vec3& origin, const glm::vec2& viewMin, const glm::vec2& viewMax)
+{
+    if (!s_Data.TilemapPSO || !s_Data.TilemapSRB)
+        return;
+
+    // Keep draw order with everything batched so far
+    Flush(BatchBreak::Tilemap);
+    SubmitBatches();
+    StartBatch();
+
+    s_Data.Stats.StateTransitions += ResourceState::Flush();
+
+    // Only the chunk range under the view is visited, so the map size never enters the cost
+    float chunkWorld = Tilemap::ChunkSize * tilemap.GetTileSize();
+    int32_t cx0 = std::max(0, (int32_t)std::floor((viewMin.x - origin.x) / chunkWorld));
+    int32_t cy0 = std::max(0, (int32_t)std::floor((viewMin.y - origin.y) / chunkWorld));
+    int32_t cx1 = std::min((int32_t)tilemap.GetChunksX() - 1, (int32_t)std::floor((viewMax.x - origin.x) / chunkWorld));
+    int32_t cy1 = std::min((int32_t)tilemap.GetChunksY() - 1, (int32_t)std::floor((viewMax.y - origin.y) / chunkWorld));
+    if (cx0 > cx1 || cy0 > cy1)
+        return;
+
+    auto context = Window::GetContext();
+    context->SetPipelineState(s_Data.TilemapPSO);
+
+    if (auto* pVar = s_Data.TilemapSRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_Textures"))
+    {
+        std::array<IDeviceObject*, RendererData::MaxTextureSlots> pViews;
+        pViews[0] = s_Data.WhiteTexture;
+        for (uint32_t i = 1; i < RendererData::MaxTextureSlots; ++i)
+        {
+            Texture* sheet = tilemap.GetTileType((uint8_t)(i - 1)).Sheet;
+            pViews[i] = sheet ? sheet->GetSRV() : s_Data.WhiteTexture.RawPtr();
+        }
+        pVar->SetArray(pViews.data(), 0, RendererData::MaxTextureSlots);
+    }
+
+    RendererData::TilemapConstants constants = {};
+    constants.ChunkInfo = { (float)Tilemap::ChunkSize, origin.z, 0.0f, 0.0f };
+    for (uint32_t i = 0; i < Tilemap::MaxTileTypes; ++i)
+    {
+        const Tilemap::TileType& type = tilemap.GetTileType((uint8_t)i);
+        constants.TypeAnim[i] = { (float)type.FrameCount, type.FrameRate, 0.0f, 0.0f };
+    }
+
+    auto* pTileData = s_Data.TilemapSRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_TileData");
+    uint32_t chunksDrawn = 0;
+
+    for (int32_t cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int32_t cx = cx0; cx <= cx1; ++cx)
+        {
+            ITextureView* chunkView = tilemap.GetChunkView((uint32_t)cx, (uint32_t)cy);
+            if (!chunkView)
+                continue;
+
+            constants.ChunkRect = { origin.x + cx * chunkWorld, origin.y + cy * chunkWorld, chunkWorld, chunkWorld };
+            {
+                MapHelper<RendererData::TilemapConstants> CBData(context, s_Data.TilemapConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+                *CBData = constants;
+            }
+
+            if (pTileData)
+                pTileData->Set(chunkView);
+            context->CommitShaderResources(s_Data.TilemapSRB, ResourceState::BindMode);
+
+            DrawAttribs DrawAttrs;
+            DrawAttrs.NumVertices = 4;
+            DrawAttrs.Flags = ResourceState::DrawFlags;
+            context->Draw(DrawAttrs);
+
+            s_Data.Stats.DrawCalls++;
+            chunksDrawn++;
+        }
+    }
+
+    if (chunksDrawn > 0)
+        RecordBatch(BatchBreak::None, BatchPipeline::Tilemap, chunksDrawn, chunksDrawn, RendererData::MaxTextureSlots);
+}
+
+void Renderer::DrawGpuParticles(GpuParticleSystem& system)
+{
+    // Keep draw order with everything batched so far
+    Flush(BatchBreak::Particles);
+    SubmitBatches();
+    StartBatch();
+
+    // The instance count is only known on the GPU, so quads here count nothing
+    system.Render();
+    s_Data.Stats.DrawCalls++;
+    RecordBatch(BatchBreak::None, BatchPipeline::Particles, 1, 0, 0);
+}
+
+// ==============================================================================================
+// Render To Texture Implementation
+// ==============================================================================================
+
+void Renderer::BeginRenderToTexture(Texture* target, const glm::mat4& viewProj)
+{
+    if (!target || !target->GetRTV() || s_Data.OffscreenTarget)
+        return;
+
+    Flush(BatchBreak::RenderTarget);
+    SubmitBatches();
+
+    auto device = Window::GetDevice();
+    auto context = Window::GetContext();
+
+    // Diligent wants the depth target to match the render target, so it is recreated when the size changes
+    if (!s_Data.OffscreenDepth || s_Data.OffscreenDepth->GetDesc().Width != target->GetWidth() || s_Data.OffscreenDepth->GetDesc().Height != target->GetHeight())
+    {
+        TextureDesc DepthDesc;
+        DepthDesc.Name = "Renderer Offscreen Depth";
+        DepthDesc.Type = RESOURCE_DIM_TEX_2D;
+        DepthDesc.Width = target->GetWidth();
+        DepthDesc.Height = target->GetHeight();
+        DepthDesc.Format = TEX_FORMAT_D24_UNORM_S8_UINT;
+        DepthDesc.Usage = USAGE_DEFAULT;
+        DepthDesc.BindFlags = BIND_DEPTH_STENCIL;
+        s_Data.OffscreenDepth.Release();
+        device->CreateTexture(DepthDesc, nullptr, &s_Data.OffscreenDepth);
+    }
+
+    // Binding the targets also sets the viewport to cover the whole texture
+    ITextureView* pRTV = target->GetRTV();
+    ITextureView* pDSV = s_Data.OffscreenDepth ? s_Data.OffscreenDepth->GetDefaultView(TEXTURE_VIEW_DEPTH_STENCIL) : nullptr;
+    context->SetRenderTargets(1, &pRTV, pDSV, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+
+    float clear[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    context->ClearRenderTarget(pRTV, clear, ResourceState::BindMode);
+    // The depth target is shared by every offscreen target, so the previous one's depth must go too
+    if (pDSV)
+        context->ClearDepthStencil(pDSV, CLEAR_DEPTH_FLAG | CLEAR_STENCIL_FLAG, 1.0f, 0, ResourceState::BindMode);
+    s_Data.OffscreenSavedDepth = s_Data.Depth;
+    s_Data.Depth = {};
+
+    {
+        MapHelper<RendererData::GlobalConstants> CBData(context, s_Data.GlobalConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+        CBData->ViewProjection = viewProj;
+        CBData->Time = (float)glfwGetTime();
+    }
+
+    // Clip rects are in back-buffer pixels and mean nothing here
+    s_Data.OffscreenSavedClip = s_Data.ClipRect;
+    s_Data.ClipRect = RendererData::NoClip;
+    s_Data.OffscreenTarget = target;
+    s_Data.CurrentViewProj = viewProj;
+
+    StartBatch();
+}
+
+void Renderer::EndRenderToTexture()
+{
+    if (!s_Data.OffscreenTarget)
+        return;
+
+    Flush(BatchBreak::RenderTarget);
+    SubmitBatches();
+
+    auto context = Window::GetContext();
+
+    BindBaseTarget();
+
+    {
+        MapHelper<RendererData::GlobalConstants> CBData(context, s_Data.GlobalConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+        CBData->ViewProjection = s_Data.SceneViewProj;
+        CBData->Time = (float)glfwGetTime();
+    }
+
+    s_Data.OffscreenTarget->GenerateMips();
+    s_Data.OffscreenTarget = nullptr;
+    s_Data.ClipRect = s_Data.OffscreenSavedClip;
+    s_Data.Depth = s_Data.OffscreenSavedDepth;
+    s_Data.CurrentViewProj = s_Data.SceneViewProj;
+
+    StartBatch();
+}
+
+// ==============================================================================================
+// Dynamic Resolution Implementation
+// ==============================================================================================
+
+// (Re)creates the world target at the back buffer's size. False when there is nothing to upscale with.
+static bool EnsureWorldTarget(uint32_t width, uint32_t height)
+{
+    if (!s_Data.UpscalePSO)
+        return false;
+    if (s_Data.WorldColor && s_Data.WorldColor->GetDesc().Width == width && s_Data.WorldColor->GetDesc().Height == height)
+        return true;
+
+    auto device = Window::GetDevice();
+
+    s_Data.UpscaleSRB.Release();
+    s_Data.WorldColor.Release();
+    s_Data.WorldDepth.Release();
+
+    TextureDesc ColorDesc;
+    ColorDesc.Name = "Renderer World Target";
+    ColorDesc.Type = RESOURCE_DIM_TEX_2D;
+    ColorDesc.Width = width;
+    ColorDesc.Height = height;
+    ColorDesc.Format = TEX_FORMAT_RGBA8_UNORM;
+    ColorDesc.Usage = USAGE_DEFAULT;
+    ColorDesc.BindFlags = BIND_RENDER_TARGET | BIND_SHADER_RESOURCE;
+    device->CreateTexture(ColorDesc, nullptr, &s_Data.WorldColor);
+
+    TextureDesc DepthDesc = ColorDesc;
+    DepthDesc.Name = "Renderer World Depth";
+    DepthDesc.Format = TEX_FORMAT_D24_UNORM_S8_UINT;
+    DepthDesc.BindFlags = BIND_DEPTH_STENCIL;
+    device->CreateTexture(DepthDesc, nullptr, &s_Data.WorldDepth);
+
+    if (s_Data.WorldColor && s_Data.WorldDepth)
+    {
+        s_Data.UpscalePSO->CreateShaderResourceBinding(&s_Data.UpscaleSRB, true);
+        if (s_Data.UpscaleSRB)
+        {
+            if (auto* pVar = s_Data.UpscaleSRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_Source"))
+                pVar->Set(s_Data.WorldColor->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE));
+        }
+    }
+
+    if (!s_Data.UpscaleSRB)
+    {
+        Logger::Error("Renderer: Failed to create the " + std::to_string(width) + "x" + std::to_string(height) + " world target");
+        s_Data.WorldColor.Release();
+        s_Data.WorldDepth.Release();
+        return false;
+    }
+    return true;
+}
+
+// Collects finished world pass timings and steers the scale toward the budget. GPU time is taken as
+// proportional to the pixel count, so the scale moves by the square root of the time ratio, in bounded steps
+// and with a dead band below the budget so it settles instead of oscillating.
+static void UpdateResolutionScale()
+{
+    static const float Smoothing = 0.25f;
+    static const float HeadroomBand = 0.8f; // Grow only below this fraction of the budget
+    static const float MaxStepDown = 0.1f;
+    static const float MaxStepUp = 0.05f;
+
+    Renderer::DynamicResolutionSettings& settings = s_Data.ResolutionSettings;
+    Renderer::DynamicResolutionStats& stats = s_Data.ResolutionStats;
+
+    // Oldest query first, so the newest finished one lands last
+    bool sampled = false;
+    for (uint32_t i = 0; i < RendererData::TimingQueryCount; ++i)
+    {
+        uint32_t slot = (s_Data.TimingNext + i) % RendererData::TimingQueryCount;
+        if (!s_Data.TimingPending[slot])
+            continue;
+
+        QueryDataDuration data;
+        if (!s_Data.TimingQueries[slot]->GetData(&data, sizeof(data), true))
+            continue;
+
+        s_Data.TimingPending[slot] = false;
+        if (data.Frequency == 0)
+            continue;
+
+        stats.GpuTimeMs = (float)((double)data.Duration * 1000.0 / (double)data.Frequency);
+        stats.SmoothedGpuTimeMs = stats.SmoothedGpuTimeMs > 0.0f ? glm::mix(stats.SmoothedGpuTimeMs, stats.GpuTimeMs, Smoothing) : stats.GpuTimeMs;
+        sampled = true;
+    }
+
+    float scale = stats.Scale;
+    if (!settings.Enabled)
+    {
+        scale = settings.MaxScale;
+    }
+    else if (sampled && stats.SmoothedGpuTimeMs > 0.0f)
+    {
+        float budget = settings.TargetGpuMs;
+        if (stats.SmoothedGpuTimeMs > budget)
+            scale = std::max(scale * std::sqrt(budget / stats.SmoothedGpuTimeMs), scale - MaxStepDown);
+        else if (stats.SmoothedGpuTimeMs < budget * HeadroomBand)
+            scale = std::min(scale * std::sqrt(budget * HeadroomBand / stats.SmoothedGpuTimeMs), scale + MaxStepUp);
+    }
+
+    scale = glm::clamp(scale, settings.MinScale, settings.MaxScale);
+
+    // Close enough to full size is full size, which skips the offscreen target
+    if (scale > 0.99f)
+        scale = 1.0f;
+    stats.Scale = scale;
+}
+
+void Renderer::BeginWorldPass()
+{
+    if (s_Data.InWorldPass || s_Data.OffscreenTarget)
+        return;
+
+    // Anything pending belongs to the back buffer
+    Flush(BatchBreak::RenderTarget);
+    SubmitBatches();
+
+    auto context = Window::GetContext();
+
+    UpdateResolutionScale();
+
+    const SwapChainDesc& SCDesc = Window::GetSwapChain()->GetDesc();
+    float scale = s_Data.ResolutionStats.Scale;
+    uint32_t width = std::max(1u, (uint32_t)((float)SCDesc.Width * scale + 0.5f));
+    uint32_t height = std::max(1u, (uint32_t)((float)SCDesc.Height * scale + 0.5f));
+
+    s_Data.InWorldPass = true;
+    s_Data.WorldTargetBound = scale < 1.0f && EnsureWorldTarget(SCDesc.Width, SCDesc.Height);
+    if (s_Data.WorldTargetBound)
+    {
+        s_Data.WorldWidth = width;
+        s_Data.WorldHeight = height;
+        s_Data.ClipScale = (float)width / (float)SCDesc.Width;
+        s_Data.WorldSavedDepth = s_Data.Depth;
+        BindBaseTarget();
+
+        ITextureView* pRTV = s_Data.WorldColor->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+        context->ClearRenderTarget(pRTV, Window::ClearColor, ResourceState::BindMode);
+        ClearBoundDepth();
+    }
+    else
+    {
+        width = SCDesc.Width;
+        height = SCDesc.Height;
+        s_Data.ResolutionStats.Scale = 1.0f;
+    }
+
+    s_Data.ResolutionStats.Width = width;
+    s_Data.ResolutionStats.Height = height;
+
+    // A slot whose result hasn't come back yet is skipped; that frame goes unmeasured
+    s_Data.TimingStarted = s_Data.ResolutionStats.TimingAvailable && !s_Data.TimingPending[s_Data.TimingNext];
+    if (s_Data.TimingStarted)
+        context->BeginQuery(s_Data.TimingQueries[s_Data.TimingNext]);
+
+    StartBatch();
+}
+
+void Renderer::EndWorldPass()
+{
+    if (!s_Data.InWorldPass || s_Data.OffscreenTarget)
+        return;
+
+    Flush(BatchBreak::RenderTarget);
+    SubmitBatches();
+
+    auto context = Window::GetContext();
+
+    if (s_Data.WorldTargetBound)
+    {
+        s_Data.WorldTargetBound = false;
+        s_Data.ClipScale = 1.0f;
+        BindBaseTarget();
+        s_Data.Depth = s_Data.WorldSavedDepth;
+
+        {
+            const TextureDesc& desc = s_Data.WorldColor->GetDesc();
+            MapHelper<RendererData::UpscaleConstants> CBData(context, s_Data.UpscaleConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+            CBData->SourceScale = { (float)s_Data.WorldWidth / (float)desc.Width, (float)s_Data.WorldHeight / (float)desc.Height };
+            CBData->SourceMax = { ((float)s_Data.WorldWidth - 0.5f) / (float)desc.Width, ((float)s_Data.WorldHeight - 0.5f) / (float)desc.Height };
+        }
+
+        ResourceState::Request(s_Data.WorldColor, RESOURCE_STATE_SHADER_RESOURCE);
+        s_Data.Stats.StateTransitions += ResourceState::Flush();
+
+        context->SetPipelineState(s_Data.UpscalePSO);
+        context->CommitShaderResources(s_Data.UpscaleSRB, ResourceState::BindMode);
+
+        DrawAttribs DrawAttrs;
+        DrawAttrs.NumVertices = 3;
+        DrawAttrs.Flags = ResourceState::DrawFlags;
+        context->Draw(DrawAttrs);
+
+        s_Data.Stats.DrawCalls++;
+    }
+
+    if (s_Data.TimingStarted)
+    {
+        context->EndQuery(s_Data.TimingQueries[s_Data.TimingNext]);
+        s_Data.TimingPending[s_Data.TimingNext] = true;
+        s_Data.TimingNext = (s_Data.TimingNext + 1) % RendererData::TimingQueryCount;
+        s_Data.TimingStarted = false;
+    }
+
+    s_Data.InWorldPass = false;
+
+    StartBatch();
+}
+
+void Renderer::SetDynamicResolution(const DynamicResolutionSettings& settings)
+{
+    DynamicResolutionSettings& dst = s_Data.ResolutionSettings;
+    dst = settings;
+    dst.MaxScale = glm::clamp(settings.MaxScale, 0.1f, 1.0f);
+    dst.MinScale = glm::clamp(settings.MinScale, 0.1f, dst.MaxScale);
+    dst.TargetGpuMs = std::max(settings.TargetGpuMs, 0.1f);
+}
+
+Renderer::DynamicResolutionSettings Renderer::GetDynamicResolution()
+{
+    return s_Data.ResolutionSettings;
+}
+
+Renderer::DynamicResolutionStats Renderer::GetDynamicResolutionStats()
+{
+    return s_Data.ResolutionStats;
+}
+
+void Renderer::ClearDepth()
+{
+    ClearBoundDepth();
+}
+
 // ==============================================================================================
 // 3D Implementation
 // ==============================================================================================
@@ -1164,45 +2849,150 @@ void Renderer::DrawMesh(const MeshData& mesh, const glm::mat4& transform, const
 
 void Renderer::DrawMesh(const MeshData& mesh, const glm::mat4& transform, Texture* texture, const glm::vec4& color)
 {
-    // Flush 2D batch if any, to preserve order (though 3D usually draws before 2D UI)
-    // But if we mix them, we should flush.
-    Flush();
+    if (!mesh.VertexBuffer || !mesh.IndexBuffer || mesh.IndexCount == 0)
+        return;
+
+    // 2D content drawn before this mesh must go first; the queue then only ever holds meshes that precede every
+    // pending batch, so SubmitBatches can draw it ahead of them
+    if (s_Data.QuadIndexCount > 0 || !s_Data.Batches.empty())
+    {
+        Flush(BatchBreak::Mesh);
+        SubmitBatches();
+        StartBatch();
+    }
+
+    // Untextured meshes sample the white texture, so they group with each other
+    ITextureView* view = texture ? texture->GetSRV() : s_Data.WhiteTexture.RawPtr();
+    s_Data.MeshQueue.push_back({ mesh.VertexBuffer, mesh.IndexBuffer, mesh.IndexCount, view, { transform, color } });
+}
+
+void Renderer::SubmitMeshes()
+{
+    if (s_Data.MeshQueue.empty())
+        return;
+
+    auto& queue = s_Data.MeshQueue;
+    if (!s_Data.MeshPSO)
+    {
+        queue.clear();
+        return;
+    }
+
+    // Group by mesh, then texture; each run becomes one instanced draw
+    std::stable_sort(queue.begin(), queue.end(), [](const RendererData::MeshDraw& a, const RendererData::MeshDraw& b)
+    {
+        if (a.VertexBuffer != b.VertexBuffer)
+            return a.VertexBuffer < b.VertexBuffer;
+        if (a.IndexBuffer != b.IndexBuffer)
+            return a.IndexBuffer < b.IndexBuffer;
+        return a.Texture < b.Texture;
+    });
+
+    uint32_t instanceCount = (uint32_t)queue.size();
+    if (instanceCount > s_Data.MeshInstanceCapacity || !s_Data.MeshInstanceBuffer)
+    {
+        uint32_t capacity = std::max(s_Data.MeshInstanceCapacity, RendererData::MinMeshInstances);
+        while (capacity < instanceCount)
+            capacity *= 2;
+
+        s_Data.MeshInstanceBuffer.Release();
+
+        BufferDesc InstDesc;
+        InstDesc.Name = "Renderer3D Instance Buffer";
+        InstDesc.Usage = USAGE_DYNAMIC;
+        InstDesc.BindFlags = BIND_VERTEX_BUFFER;
+        InstDesc.CPUAccessFlags = CPU_ACCESS_WRITE;
+        InstDesc.Size = (Uint64)capacity * sizeof(RendererData::MeshInstance);
+        Window::GetDevice()->CreateBuffer(InstDesc, nullptr, &s_Data.MeshInstanceBuffer);
+
+        s_Data.MeshInstanceCapacity = s_Data.MeshInstanceBuffer ? capacity : 0;
+        if (!s_Data.MeshInstanceBuffer)
+        {
+            queue.clear();
+            return;
+        }
+    }
 
     auto context = Window::GetContext();
 
-    // Update Mesh Constants
+    // 1. Every instance of the scene in one map, already in group order
+    {
+        MapHelper<RendererData::MeshInstance> InstData(context, s_Data.MeshInstanceBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
+        RendererData::MeshInstance* pDst = InstData;
+        for (const auto& draw : queue)
+            *pDst++ = draw.Instance;
+    }
+
+    // Mesh buffers belong to the caller, so their states are requested here; already-correct ones cost a compare
+    for (size_t i = 0; i < queue.size(); ++i)
     {
-        MapHelper<RendererData::MeshConstants> CBData(context, s_Data.MeshConstantBuffer, MAP_WRITE, MAP_FLAG_DISCARD);
-        CBData->World = transform;
-        CBData->Color = color;
-        CBData->UseTexture = texture ? 1.0f : 0.0f;
+        if (i == 0 || queue[i].VertexBuffer != queue[i - 1].VertexBuffer || queue[i].IndexBuffer != queue[i - 1].IndexBuffer)
+        {
+            ResourceState::Request(queue[i].VertexBuffer, RESOURCE_STATE_VERTEX_BUFFER);
+            ResourceState::Request(queue[i].IndexBuffer, RESOURCE_STATE_INDEX_BUFFER);
+        }
     }
+    s_Data.Stats.StateTransitions += ResourceState::Flush();
+
+    // DrawSpritesLayered's depths are list positions, nothing a mesh should be hidden by
+    if (s_Data.Depth.Sprites)
+        ClearBoundDepth();
+    s_Data.Depth.Written = true;
 
     context->SetPipelineState(s_Data.MeshPSO);
+    auto* pTextureVar = s_Data.MeshSRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_Texture");
 
-    // Bind Texture
-    if (auto* pVar = s_Data.MeshSRB->GetVariableByName(SHADER_TYPE_PIXEL, "u_Texture"))
+    // 2. One draw per run of equal mesh and texture
+    IBuffer* boundVB = nullptr;
+    IBuffer* boundIB = nullptr;
+    ITextureView* boundTexture = nullptr;
+    uint32_t groups = 0;
+    uint32_t textureBinds = 0;
+
+    size_t first = 0;
+    while (first < queue.size())
     {
-        if (texture)
-            pVar->Set(texture->GetSRV());
-        else
-            pVar->Set(s_Data.WhiteTexture);
-    }
-    context->CommitShaderResources(s_Data.MeshSRB, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        const auto& draw = queue[first];
+        size_t last = first + 1;
+        while (last < queue.size() && queue[last].VertexBuffer == draw.VertexBuffer && queue[last].IndexBuffer == draw.IndexBuffer && queue[last].Texture == draw.Texture)
+            last++;
 
-    // Bind Buffers
-    IBuffer* pVBs[] = { mesh.VertexBuffer };
-    Uint64 offsets[] = { 0 };
-    context->SetVertexBuffers(0, 1, pVBs, offsets, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, SET_VERTEX_BUFFERS_FLAG_RESET);
-    context->SetIndexBuffer(mesh.IndexBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        if (draw.VertexBuffer != boundVB)
+        {
+            IBuffer* pVBs[] = { draw.VertexBuffer, s_Data.MeshInstanceBuffer };
+            Uint64 offsets[] = { 0, 0 };
+            context->SetVertexBuffers(0, 2, pVBs, offsets, ResourceState::BindMode, SET_VERTEX_BUFFERS_FLAG_RESET);
+            boundVB = draw.VertexBuffer;
+        }
+        if (draw.IndexBuffer != boundIB)
+        {
+            context->SetIndexBuffer(draw.IndexBuffer, 0, ResourceState::BindMode);
+            boundIB = draw.IndexBuffer;
+        }
+        if (draw.Texture != boundTexture)
+        {
+            if (pTextureVar)
+                pTextureVar->Set(draw.Texture);
+            context->CommitShaderResources(s_Data.MeshSRB, ResourceState::BindMode);
+            boundTexture = draw.Texture;
+            textureBinds++;
+        }
 
-    DrawIndexedAttribs DrawAttrs;
-    DrawAttrs.NumIndices = mesh.IndexCount;
-    DrawAttrs.IndexType = VT_UINT32;
-    DrawAttrs.Flags = DRAW_FLAG_VERIFY_ALL;
-    context->DrawIndexed(DrawAttrs);
+        DrawIndexedAttribs DrawAttrs;
+        DrawAttrs.NumIndices = draw.IndexCount;
+        DrawAttrs.IndexType = VT_UINT32;
+        DrawAttrs.NumInstances = (Uint32)(last - first);
+        DrawAttrs.FirstInstanceLocation = (Uint32)first;
+        DrawAttrs.Flags = ResourceState::DrawFlags;
+        context->DrawIndexed(DrawAttrs);
+
+        s_Data.Stats.DrawCalls++;
+        groups++;
+        first = last;
+    }
 
-    s_Data.Stats.DrawCalls++;
+    RecordBatch(BatchBreak::None, BatchPipeline::Mesh, groups, 0, textureBinds);
+    queue.clear();
 }
 
 Renderer::Statistics Renderer::GetStats()
@@ -1215,7 +3005,97 @@ void Renderer::ResetStats()
     memset(&s_Data.Stats, 0, sizeof(Statistics));
 }
 
+void Renderer::RecordCulling(uint32_t visible, uint32_t total)
+{
+    s_Data.Stats.VisibleCount += visible;
+    s_Data.Stats.TotalCount += total;
+}
+
 ITextureView* Renderer::GetWhiteTexture()
 {
     return s_Data.WhiteTexture;
 }
+
+const std::vector<Renderer::BatchRecord>& Renderer::GetBatchReport()
+{
+    return s_Data.LastFrameReport;
+}
+
+const char* Renderer::GetBatchBreakName(BatchBreak reason)
+{
+    switch (reason)
+    {
+    case BatchBreak::None: return "None";
+    case BatchBreak::TextureSlots: return "TextureSlots";
+    case BatchBreak::PipelineSwitch: return "PipelineSwitch";
+    case BatchBreak::VertexBufferFull: return "VertexBufferFull";
+    case BatchBreak::EndScene: return "EndScene";
+    case BatchBreak::StaticBatch: return "StaticBatch";
+    case BatchBreak::Tilemap: return "Tilemap";
+    case BatchBreak::Mesh: return "Mesh";
+    case BatchBreak::RenderTarget: return "RenderTarget";
+    case BatchBreak::Particles: return "Particles";
+    default: return "Unknown";
+    }
+}
+
+const char* Renderer::GetBatchPipelineName(BatchPipeline pipeline)
+{
+    switch (pipeline)
+    {
+    case BatchPipeline::Quad: return "Quad";
+    case BatchPipeline::Text: return "Text";
+    case BatchPipeline::Static: return "Static";
+    case BatchPipeline::Tilemap: return "Tilemap";
+    case BatchPipeline::Mesh: return "Mesh";
+    case BatchPipeline::Particles: return "Particles";
+    case BatchPipeline::Opaque: return "Opaque";
+    case BatchPipeline::Translucent: return "Translucent";
+    default: return "Unknown";
+    }
+}
+
+bool Renderer::DumpBatchReportJson(const std::string& path)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+    if (!file.is_open())
+    {
+        Logger::Warn("Renderer: Could not write batch report to " + path);
+        return false;
+    }
+
+    const std::vector<BatchRecord>& report = s_Data.LastFrameReport;
+
+    uint32_t breaks[(size_t)BatchBreak::Count] = {};
+    uint32_t drawCalls = 0;
+    uint32_t quads = 0;
+    for (const BatchRecord& record : report)
+    {
+        breaks[(size_t)record.Reason]++;
+        drawCalls += record.DrawCalls;
+        quads += record.QuadCount;
+    }
+
+    file << "{\n";
+    file << "  \"frame\": " << (s_Data.FrameIndex > 0 ? s_Data.FrameIndex - 1 : 0) << ",\n";
+    file << "  \"batchCount\": " << report.size() << ",\n";
+    file << "  \"drawCalls\": " << drawCalls << ",\n";
+    file << "  \"quadCount\": " << quads << ",\n";
+
+    file << "  \"breaks\": {";
+    for (size_t i = 0; i < (size_t)BatchBreak::Count; ++i)
+        file << (i > 0 ? ", " : " ") << "\"" << GetBatchBreakName((BatchBreak)i) << "\": " << breaks[i];
+    file << " },\n";
+
+    file << "  \"batches\": [";
+    for (size_t i = 0; i < report.size(); ++i)
+    {
+        const BatchRecord& record = report[i];
+        file << (i > 0 ? ",\n" : "\n") << "    { \"pipeline\": \"" << GetBatchPipelineName(record.Pipeline) << "\", \"reason\": \"" << GetBatchBreakName(record.Reason)
+             << "\", \"drawCalls\": " << record.DrawCalls << ", \"quads\": " << record.QuadCount << ", \"textures\": " << record.TextureCount << " }";
+    }
+    file << (report.empty() ? "]\n" : "\n  ]\n");
+    file << "}\n";
+
+    return true;
+}
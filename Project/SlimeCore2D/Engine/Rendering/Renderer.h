@@ -20,6 +20,9 @@ using namespace Diligent;
 // Forward declarations
 class Texture;
 class Font;
+class Tilemap;
+class TextLayout;
+class GpuParticleSystem;
 struct Mesh; // We'll define a simple Mesh struct for 3D
 
 class Renderer
@@ -31,11 +34,59 @@ public:
         uint32_t QuadCount = 0;
         uint32_t VertexCount = 0;
         uint32_t IndexCount = 0;
+
+        // Camera culling: sprites that survived the view query vs. sprites tracked by the scene
+        uint32_t VisibleCount = 0;
+        uint32_t TotalCount = 0;
+
+        // Explicit barriers issued for renderer-owned resources; binds and draws themselves never transition
+        uint32_t StateTransitions = 0;
+    };
+
+    // What closed a batch. Clip rects are per vertex and never break one.
+    enum class BatchBreak : uint32_t
+    {
+        None,             // Prebuilt draw (static range, tilemap, mesh, GPU particles)
+        TextureSlots,     // Every texture slot was taken (the batch's 32, or the whole bindless table)
+        PipelineSwitch,   // Between quad, text and the layered sprite passes
+        VertexBufferFull, // MaxQuads reached
+        EndScene,
+        StaticBatch,      // A static batch was drawn next
+        Tilemap,          // A tilemap was drawn next
+        Mesh,             // A mesh was drawn next
+        RenderTarget,     // Drawing moved to or from an offscreen texture
+        Particles,        // A GPU particle system was drawn next
+        Count
+    };
+
+    enum class BatchPipeline : uint32_t
+    {
+        Quad,
+        Text,
+        Static,
+        Tilemap,
+        Mesh,
+        Particles,
+        Opaque,     // DrawSpritesLayered's depth-writing pass
+        Translucent // DrawSpritesLayered's depth-tested blended pass
+    };
+
+    // One entry per submitted batch, in draw order. Plain data; mirrored by the C# interop struct.
+    struct BatchRecord
+    {
+        BatchBreak Reason = BatchBreak::None;
+        BatchPipeline Pipeline = BatchPipeline::Quad;
+        uint32_t DrawCalls = 0;
+        uint32_t QuadCount = 0;
+        uint32_t TextureCount = 0;
     };
 
     static void Init();
     static void Shutdown();
 
+    // Call once per frame before any scene; the first upload afterwards discards the vertex ring.
+    static void BeginFrame();
+
     static void BeginScene(Camera& camera);
     static void BeginScene(const glm::mat4& viewProj);
     static void EndScene();
@@ -59,12 +110,154 @@ public:
     static void DrawQuad(const glm::mat4& transform, Texture* texture, float tiling = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
     static void DrawQuadUV(const glm::mat4& transform, Texture* texture, const glm::vec2 uvs[4], const glm::vec4& tintColor = glm::vec4(1.0f));
 
+    // Sprite description consumed by DrawSprites. UVRect is (u0, v0, u1, v1) in the texture's own space.
+    // A textured sprite with a non-zero Slice is drawn as a nine-slice: Slice holds the border widths in texels
+    // (left, top, right, bottom; top is the u0/v0 side), drawn SliceScale quad units per texel so the corners keep
+    // their size while the edges and centre stretch. CornerRadius and BorderWidth, in quad units, round the quad
+    // and outline it in BorderColor in the pixel shader; both zero leaves it a plain rectangle.
+    struct SpriteInstance
+    {
+        glm::mat4 Transform = glm::mat4(1.0f);
+        Texture* Texture = nullptr;
+        glm::vec4 UVRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+        glm::vec4 Color = glm::vec4(1.0f);
+        float Tiling = 1.0f;
+
+        glm::vec4 Slice = { 0.0f, 0.0f, 0.0f, 0.0f };
+        float SliceScale = 1.0f;
+        float CornerRadius = 0.0f;
+        float BorderWidth = 0.0f;
+        glm::vec4 BorderColor = glm::vec4(0.0f);
+    };
+
+    // Draws an already sorted list of sprites, batching exactly like repeated DrawQuad calls; a nine-slice takes nine quads.
+    // Texture slots are assigned up front; vertex generation is then split across the JobSystem
+    // workers, each writing its own preassigned slice of the staging buffer.
+    static void DrawSprites(const SpriteInstance* sprites, size_t count);
+
+    // Same result as DrawSprites for a back-to-front list, with less overdraw. Opaque sprites (full alpha, no
+    // rounding or border, untextured or with a Texture::IsCutout texture) go first, front to back with blending off,
+    // an alpha test and depth writes on, so the GPU rejects the pixels they cover; the rest follow in list order,
+    // depth-tested. Depth comes from list position; the buffer is cleared first only if something wrote it since
+    // the last clear, and meshes drawn later clear it again. Falls back to DrawSprites when nothing in the list is
+    // opaque, under a perspective view-projection, or without the depth-tested pipelines.
+    static void DrawSpritesLayered(const SpriteInstance* sprites, size_t count);
+
+    // Sprites (and text) baked once into an immutable vertex buffer, split into one range per texture set.
+    // Rebuild it when any member changes; drawing costs one call per range and no vertex work.
+    struct StaticBatch
+    {
+        struct Range
+        {
+            uint32_t BaseVertex = 0;
+            uint32_t IndexCount = 0;
+            bool IsText = false; // Drawn with the text pipeline
+            std::vector<RefCntAutoPtr<ITextureView>> Textures; // Slot 0 is always the white texture
+        };
+
+        RefCntAutoPtr<IBuffer> VertexBuffer;
+        std::vector<Range> Ranges;
+        uint32_t QuadCount = 0;
+    };
+
+    // A built batch shared with the snapshots that draw it. Rebuilds make a new batch rather than refilling this
+    // one, so a frame in flight keeps drawing the old geometry and recording a draw never copies the ranges.
+    using StaticBatchHandle = std::shared_ptr<const StaticBatch>;
+
+    // Entry of a mixed static batch such as retained UI. With Text set it bakes that layout's glyphs, first baseline
+    // at TextPosition and tinted by Sprite.Color; otherwise the sprite. ClipRect is (x, y, w, h) as PushClipRect
+    // takes it; w or h <= 0 leaves the quads unclipped.
+    struct StaticItem
+    {
+        SpriteInstance Sprite;
+        const TextLayout* Text = nullptr;
+        glm::vec3 TextPosition = { 0.0f, 0.0f, 0.0f };
+        glm::vec4 ClipRect = { 0.0f, 0.0f, 0.0f, 0.0f };
+    };
+
+    static void BuildStaticBatch(const SpriteInstance* sprites, size_t count, StaticBatch& outBatch);
+    static void BuildStaticBatch(const StaticItem* items, size_t count, StaticBatch& outBatch);
+    static void DrawStaticBatch(const StaticBatch& batch);
+
+    // Immediate-mode text. Layouts are cached per distinct (text, font, scale, wrapWidth); text that changes every
+    // frame is reshaped every frame, so hold a TextLayout and use DrawTextLayout for that. Shapes against the font,
+    // so only usable where the main thread owns it (single-threaded mode); recorded frames use RenderSnapshot.
     static void DrawString(const std::string& text, Font* font, const glm::vec3& position, float scale, const glm::vec4& color, float wrapWidth = 0.0f);
 
+    // Copies the pre-shaped glyph quads of 'layout' with its first baseline starting at 'position'.
+    // The layout must have had TextLayout::PrepareDraw called when it was recorded.
+    static void DrawTextLayout(const TextLayout& layout, const glm::vec3& position, const glm::vec4& color);
+
+    // Draws the chunks of 'tilemap' under the view rectangle, one quad each; 'origin' is the world position
+    // of tile (0, 0)'s bottom-left corner and its z the depth. Closes the current batch to keep ordering.
+    // Call tilemap.UploadDirtyChunks() first, on the thread that edits the map.
+    static void DrawTilemap(Tilemap& tilemap, const glm::vec3& origin, const glm::vec2& viewMin, const glm::vec2& viewMax);
+
+    // Draws every live particle of 'system' with one indirect draw sized on the GPU.
+    // Closes the current batch to keep ordering.
+    static void DrawGpuParticles(GpuParticleSystem& system);
+
+    // ==============================================================================================
+    // Render To Texture
+    // ==============================================================================================
+    // Everything drawn between these goes into 'target' (created with renderTarget = true), cleared to transparent,
+    // through 'viewProj'. Pending batches are drawn to the previous target first; End restores the back buffer and
+    // the scene's view-projection and rebuilds the target's mips. Not nestable.
+
+    static void BeginRenderToTexture(Texture* target, const glm::mat4& viewProj);
+    static void EndRenderToTexture();
+
+    // ==============================================================================================
+    // Dynamic Resolution
+    // ==============================================================================================
+    // Everything drawn between BeginWorldPass and EndWorldPass goes into an offscreen target at Scale times the
+    // back buffer's size. EndWorldPass stretches it over the back buffer with bilinear filtering, so whatever is
+    // drawn afterwards (the UI) stays native. While enabled, Scale follows the world pass's GPU time, measured with
+    // duration queries a few frames late: it drops while the pass runs over TargetGpuMs and climbs back when there is
+    // headroom, within [MinScale, MaxScale]. At full scale the pass draws straight into the back buffer.
+    // Clip rects pushed during the pass stay in back-buffer pixels. Render to texture may nest inside it.
+
+    struct DynamicResolutionSettings
+    {
+        bool Enabled = true;       // Off: the world pass renders at MaxScale
+        float MinScale = 0.5f;
+        float MaxScale = 1.0f;     // At most 1
+        float TargetGpuMs = 12.0f; // Budget for the world pass alone
+    };
+
+    struct DynamicResolutionStats
+    {
+        float Scale = 1.0f;             // Of the last world pass
+        uint32_t Width = 0;             // Its size in pixels
+        uint32_t Height = 0;
+        float GpuTimeMs = 0.0f;         // Latest measured world pass
+        float SmoothedGpuTimeMs = 0.0f; // What the scale is steered by
+        bool TimingAvailable = false;   // False when the device has no duration queries; the scale then stays put
+    };
+
+    static void BeginWorldPass();
+    static void EndWorldPass();
+
+    static void SetDynamicResolution(const DynamicResolutionSettings& settings);
+    static DynamicResolutionSettings GetDynamicResolution();
+    static DynamicResolutionStats GetDynamicResolutionStats();
+
+    // Clears the depth of the bound target: the back buffer, the world target or an offscreen texture.
+    // Call between scenes; pending batches are not flushed first.
+    static void ClearDepth();
+
     // ==============================================================================================
     // Scissor / Clipping
     // ==============================================================================================
-    
+    // Rects are in render-target pixels from the top-left. The active rect is written into every
+    // 2D vertex and tested in the pixel shader, so clipping never splits a batch. Static batches
+    // keep the rects of their StaticItems and ignore the active one.
+
+    // Pushes a rect intersected with the current one; PopClipRect restores the previous rect.
+    static void PushClipRect(float x, float y, float w, float h);
+    static void PopClipRect();
+
+    // Replace the whole stack with a single rect / clear it.
     static void EnableScissor(float x, float y, float w, float h);
     static void DisableScissor();
 
@@ -80,6 +273,11 @@ public:
         uint32_t IndexCount = 0;
     };
 
+    // Mesh draws are queued and drawn together when the 2D batches drawn after them are submitted (at the latest
+    // EndScene or a render-target switch), one instanced draw per mesh and texture pair. Draw order with 2D content is
+    // kept: meshes land over what was drawn before them and under what comes after. The mesh buffers and texture
+    // must stay alive until then.
+
     static void DrawMesh(const MeshData& mesh, const glm::mat4& transform, const glm::vec4& color = glm::vec4(1.0f));
     static void DrawMesh(const MeshData& mesh, const glm::mat4& transform, Texture* texture, const glm::vec4& color = glm::vec4(1.0f));
 
@@ -89,11 +287,25 @@ public:
 
     static Statistics GetStats();
     static void ResetStats();
+    static void RecordCulling(uint32_t visible, uint32_t total);
 
     static ITextureView* GetWhiteTexture();
 
+    // Batches of the last completed frame (swapped in by BeginFrame)
+    static const std::vector<BatchRecord>& GetBatchReport();
+    static const char* GetBatchBreakName(BatchBreak reason);
+    static const char* GetBatchPipelineName(BatchPipeline pipeline);
+
+    // Writes the last frame's batches and per-cause totals as JSON. Returns false if the file can't be opened.
+    static bool DumpBatchReportJson(const std::string& path);
+
 private:
-    static void Flush();
+    static void Flush(BatchBreak reason);
+    static void SubmitBatches();
     static void StartBatch();
-    static void NextBatch();
+    static void NextBatch(BatchBreak reason);
+    static void SubmitMeshes();
+
+    // DrawSprites over sprites[order[i]] (sprites[i] without an order), under the pipeline of the layered pass in progress
+    static void DrawSpriteList(const SpriteInstance* sprites, const uint32_t* order, size_t count);
 };
@@ -0,0 +1,73 @@
+#include "ResourceState.h"
+
+#include "Core/RenderThread.h"
+#include "Core/Window.h"
+
+std::vector<ResourceState::Pending> ResourceState::s_Pending;
+std::vector<StateTransitionDesc> ResourceState::s_Barriers;
+
+void ResourceState::Request(ITexture* texture, RESOURCE_STATE state)
+{
+	if (!texture)
+		return;
+
+	// Textures created by scripts mid-update land here while a frame may still be in flight; the request joins
+	// the list once that frame is done, still ahead of the frame being recorded
+	RefCntAutoPtr<ITexture> ref(texture);
+	RenderThread::Post([ref, state]() { Add(ref, nullptr, state); });
+}
+
+void ResourceState::Request(IBuffer* buffer, RESOURCE_STATE state)
+{
+	if (!buffer)
+		return;
+
+	RefCntAutoPtr<IBuffer> ref(buffer);
+	RenderThread::Post([ref, state]() { Add(nullptr, ref, state); });
+}
+
+void ResourceState::Add(ITexture* texture, IBuffer* buffer, RESOURCE_STATE state)
+{
+	// Uploads tend to hit the same resource repeatedly (font pages, minimap blocks), so merge into its entry
+	for (auto& pending: s_Pending)
+	{
+		if (texture ? pending.Texture == texture : pending.Buffer == buffer)
+		{
+			pending.State = state;
+			return;
+		}
+	}
+	s_Pending.push_back({ texture, buffer, state });
+}
+
+uint32_t ResourceState::Flush()
+{
+	if (s_Pending.empty())
+		return 0;
+
+	s_Barriers.clear();
+	for (const auto& pending: s_Pending)
+	{
+		if (pending.Texture)
+		{
+			if (pending.Texture->GetState() != pending.State)
+				s_Barriers.emplace_back(pending.Texture, RESOURCE_STATE_UNKNOWN, pending.State, STATE_TRANSITION_FLAG_UPDATE_STATE);
+		}
+		else if (pending.Buffer->GetState() != pending.State)
+		{
+			s_Barriers.emplace_back(pending.Buffer, RESOURCE_STATE_UNKNOWN, pending.State, STATE_TRANSITION_FLAG_UPDATE_STATE);
+		}
+	}
+
+	if (!s_Barriers.empty())
+		Window::GetContext()->TransitionResourceStates((Uint32) s_Barriers.size(), s_Barriers.data());
+
+	s_Pending.clear();
+	return (uint32_t) s_Barriers.size();
+}
+
+void ResourceState::Clear()
+{
+	s_Pending.clear();
+	s_Barriers.clear();
+}
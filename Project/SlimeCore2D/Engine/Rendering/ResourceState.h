@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "DeviceContext.h"
+#include "RefCntAutoPtr.hpp"
+
+using namespace Diligent;
+
+// Explicit state tracking for the textures and buffers the renderer keeps around.
+// Whatever writes a resource (creation, upload, mip generation) requests the state it is read in next,
+// and the renderer issues every pending request as one barrier batch before it draws. Binds and draws
+// on the hot path then use BindMode/DrawFlags: a state check in debug builds, nothing in release.
+// Dynamic buffers are left out; Diligent keeps them in a readable state across Map calls.
+class ResourceState
+{
+public:
+#ifdef _DEBUG
+	static constexpr RESOURCE_STATE_TRANSITION_MODE BindMode = RESOURCE_STATE_TRANSITION_MODE_VERIFY;
+	static constexpr DRAW_FLAGS DrawFlags = DRAW_FLAG_VERIFY_ALL;
+#else
+	static constexpr RESOURCE_STATE_TRANSITION_MODE BindMode = RESOURCE_STATE_TRANSITION_MODE_NONE;
+	static constexpr DRAW_FLAGS DrawFlags = DRAW_FLAG_NONE;
+#endif
+
+	// The resource is kept alive until the next Flush(). Goes through RenderThread::Post, so it never waits.
+	static void Request(ITexture* texture, RESOURCE_STATE state);
+	static void Request(IBuffer* buffer, RESOURCE_STATE state);
+
+	// Issues the pending transitions, skipping resources already in their requested state.
+	// Returns how many barriers were recorded.
+	static uint32_t Flush();
+
+	static void Clear();
+
+private:
+	struct Pending
+	{
+		RefCntAutoPtr<ITexture> Texture;
+		RefCntAutoPtr<IBuffer> Buffer;
+		RESOURCE_STATE State;
+	};
+
+	static void Add(ITexture* texture, IBuffer* buffer, RESOURCE_STATE state);
+
+	static std::vector<Pending> s_Pending;
+	static std::vector<StateTransitionDesc> s_Barriers;
+};
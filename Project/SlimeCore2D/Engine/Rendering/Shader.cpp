@@ -9,13 +9,13 @@
 #include "Core/Window.h"
 #include "DiligentCore/Graphics/GraphicsTools/interface/MapHelper.hpp"
 #include "EngineFactory.h"
+#include "PipelineCache.h"
 
 using namespace Diligent;
 
 Shader::Shader(const std::string& name, const char* vertexPath, const char* fragmentPath, const char* geometryPath)
       : m_name(name)
 {
-	auto device = Window::GetDevice();
 	auto factory = Window::GetEngineFactory();
 
 	// Extract directory from vertexPath
@@ -69,7 +69,7 @@ Shader::Shader(const std::string& name, const char* vertexPath, const char* frag
 	ShaderCI.Desc.Name = "Vertex Shader";
 	ShaderCI.FilePath = vFileName.c_str();
 	ShaderCI.EntryPoint = "main";
-	device->CreateShader(ShaderCI, &m_VertexShader);
+	PipelineCache::CreateShader(ShaderCI, &m_VertexShader);
 
 	if (!m_VertexShader)
 	{
@@ -81,7 +81,7 @@ Shader::Shader(const std::string& name, const char* vertexPath, const char* frag
 	ShaderCI.Desc.Name = "Pixel Shader";
 	ShaderCI.FilePath = fFileName.c_str();
 	ShaderCI.EntryPoint = "main";
-	device->CreateShader(ShaderCI, &m_PixelShader);
+	PipelineCache::CreateShader(ShaderCI, &m_PixelShader);
 
 	if (!m_PixelShader)
 	{
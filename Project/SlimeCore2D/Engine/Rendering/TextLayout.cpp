@@ -0,0 +1,199 @@
+#include "TextLayout.h"
+
+#include "Font.h"
+
+// Decodes the UTF-8 sequence at text[i] and advances i past it. Malformed bytes decode as U+FFFD.
+static uint32_t DecodeUTF8(const std::string& text, size_t& i)
+{
+	unsigned char lead = (unsigned char) text[i++];
+	if (lead < 0x80)
+		return lead;
+
+	uint32_t codepoint;
+	int extra;
+	if ((lead & 0xE0) == 0xC0)
+	{
+		codepoint = lead & 0x1F;
+		extra = 1;
+	}
+	else if ((lead & 0xF0) == 0xE0)
+	{
+		codepoint = lead & 0x0F;
+		extra = 2;
+	}
+	else if ((lead & 0xF8) == 0xF0)
+	{
+		codepoint = lead & 0x07;
+		extra = 3;
+	}
+	else
+	{
+		return 0xFFFD;
+	}
+
+	for (int n = 0; n < extra; ++n)
+	{
+		if (i >= text.size() || ((unsigned char) text[i] & 0xC0) != 0x80)
+			return 0xFFFD;
+		codepoint = (codepoint << 6) | ((unsigned char) text[i++] & 0x3F);
+	}
+
+	return codepoint;
+}
+
+bool TextLayout::Update(const std::string& text, Font* font, float scale, float wrapWidth)
+{
+	if (IsValidFor(text, font, scale, wrapWidth))
+		return false;
+
+	Build(text, font, scale, wrapWidth);
+	return true;
+}
+
+void TextLayout::Build(const std::string& text, Font* font, float scale, float wrapWidth)
+{
+	m_Text = text;
+	m_Font = font;
+	m_Scale = scale;
+	m_WrapWidth = wrapWidth;
+
+	m_Glyphs.clear();
+	m_Size = { 0.0f, 0.0f };
+	m_MaxY = 0.0f;
+	m_LineCount = 0;
+
+	if (!font)
+		return;
+
+	m_Glyphs.reserve(text.size());
+
+	const Character* space = font->GetGlyph(' ');
+	float spaceWidth = space ? (space->Advance >> 6) * scale : 0.0f;
+	float lineSpacing = font->GetFontSize() * scale;
+
+	float penX = 0.0f;
+	float penY = 0.0f;
+	float maxLineWidth = 0.0f;
+	float lineMaxY = 0.0f;
+	float lineMinY = 0.0f;
+	float firstLineMaxY = 0.0f;
+	bool isFirstLine = true;
+	uint32_t lineCount = 1;
+
+	auto newLine = [&]()
+	{
+		if (penX > maxLineWidth)
+			maxLineWidth = penX;
+		if (isFirstLine)
+		{
+			firstLineMaxY = lineMaxY;
+			isFirstLine = false;
+		}
+
+		lineCount++;
+		penX = 0.0f;
+		penY -= lineSpacing;
+		lineMaxY = 0.0f;
+		lineMinY = 0.0f;
+	};
+
+	size_t i = 0;
+	while (i < text.size())
+	{
+		// Measure the next word so it can move to a new line as a whole
+		size_t wordStart = i;
+		size_t wordEnd = i;
+		float wordWidth = 0.0f;
+		float wordMaxY = 0.0f;
+		float wordMinY = 0.0f;
+
+		while (i < text.size() && text[i] != ' ' && text[i] != '\n')
+		{
+			const Character* ch = font->GetGlyph(DecodeUTF8(text, i));
+			wordEnd = i;
+			if (!ch)
+				continue;
+
+			float h = ch->Size.y * scale;
+			float bearingY = ch->Bearing.y * scale;
+
+			if (bearingY > wordMaxY)
+				wordMaxY = bearingY;
+			if ((h - bearingY) > wordMinY)
+				wordMinY = h - bearingY;
+
+			wordWidth += (ch->Advance >> 6) * scale;
+		}
+
+		if (wrapWidth > 0.0f && penX > 0.0f && (penX + wordWidth > wrapWidth))
+			newLine();
+
+		for (size_t c = wordStart; c < wordEnd;)
+		{
+			const Character* ch = font->GetGlyph(DecodeUTF8(text, c));
+			if (!ch)
+				continue;
+
+			if (ch->Size.x > 0.0f && ch->Size.y > 0.0f)
+			{
+				Glyph glyph;
+				glyph.Min = { penX + ch->Bearing.x * scale, penY - (ch->Size.y - ch->Bearing.y) * scale };
+				glyph.Max = glyph.Min + ch->Size * scale;
+				glyph.UVMin = ch->uvMin;
+				glyph.UVMax = ch->uvMax;
+				glyph.Page = ch->Page;
+				m_Glyphs.push_back(glyph);
+			}
+
+			penX += (ch->Advance >> 6) * scale;
+		}
+
+		if (wordMaxY > lineMaxY)
+			lineMaxY = wordMaxY;
+		if (wordMinY > lineMinY)
+			lineMinY = wordMinY;
+
+		// Separator
+		if (i < text.size())
+		{
+			if (text[i] == '\n')
+				newLine();
+			else
+				penX += spaceWidth;
+			i++;
+		}
+	}
+
+	if (penX > maxLineWidth)
+		maxLineWidth = penX;
+	if (isFirstLine)
+		firstLineMaxY = lineMaxY;
+
+	m_Size.x = maxLineWidth;
+	m_Size.y = firstLineMaxY + (float) (lineCount - 1) * lineSpacing + lineMinY;
+	m_MaxY = firstLineMaxY;
+	m_LineCount = lineCount;
+	m_Generation = font->GetAtlasGeneration();
+}
+
+void TextLayout::PrepareDraw() const
+{
+	if (!m_Font)
+		return;
+
+	uint32_t lastPage = UINT32_MAX;
+	for (const Glyph& glyph: m_Glyphs)
+	{
+		if (glyph.Page == lastPage)
+			continue;
+		lastPage = glyph.Page;
+		m_Font->TouchPage(glyph.Page);
+	}
+
+	m_Font->UploadDirtyPages();
+}
+
+bool TextLayout::IsValidFor(const std::string& text, Font* font, float scale, float wrapWidth) const
+{
+	return m_Font == font && m_Font != nullptr && m_Generation == font->GetAtlasGeneration() && m_Scale == scale && m_WrapWidth == wrapWidth && m_Text == text;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm.hpp>
+
+class Font;
+
+// A UTF-8 string shaped once against a font: word wrapping, line breaks, glyph quads and bounds.
+// Glyph rectangles are relative to the first line's baseline at the left edge, so drawing is a straight copy.
+class TextLayout
+{
+public:
+	struct Glyph
+	{
+		glm::vec2 Min; // Bottom-left, relative to the layout origin
+		glm::vec2 Max; // Top-right
+		glm::vec2 UVMin;
+		glm::vec2 UVMax;
+		uint32_t Page; // Font atlas page
+	};
+
+	// Reshapes only when the text, font, scale or wrap width differ from the last build,
+	// or when the font has recycled an atlas page since.
+	// Returns true if the layout was rebuilt.
+	bool Update(const std::string& text, Font* font, float scale, float wrapWidth = 0.0f);
+	void Build(const std::string& text, Font* font, float scale, float wrapWidth = 0.0f);
+
+	// False once the font's atlas has evicted a page since this layout was built.
+	bool IsValidFor(const std::string& text, Font* font, float scale, float wrapWidth) const;
+
+	// Marks the pages this layout samples as drawn this frame and posts any glyphs not yet uploaded.
+	// Main thread, whenever the layout is recorded for drawing.
+	void PrepareDraw() const;
+
+	const std::vector<Glyph>& GetGlyphs() const
+	{
+		return m_Glyphs;
+	}
+
+	Font* GetFont() const
+	{
+		return m_Font;
+	}
+
+	// Matches Font::CalculateSize
+	glm::vec2 GetSize() const
+	{
+		return m_Size;
+	}
+
+	// How far the first line rises above the baseline
+	float GetMaxY() const
+	{
+		return m_MaxY;
+	}
+
+	uint32_t GetLineCount() const
+	{
+		return m_LineCount;
+	}
+
+private:
+	std::string m_Text;
+	Font* m_Font = nullptr;
+	float m_Scale = 0.0f;
+	float m_WrapWidth = 0.0f;
+	uint32_t m_Generation = 0;
+
+	std::vector<Glyph> m_Glyphs;
+	glm::vec2 m_Size = { 0.0f, 0.0f };
+	float m_MaxY = 0.0f;
+	uint32_t m_LineCount = 0;
+};
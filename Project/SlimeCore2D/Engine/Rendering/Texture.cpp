@@ -1,14 +1,55 @@
 #include "Texture.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <vector>
 
 #include "Core/Logger.h"
+#include "Core/RenderThread.h"
 #include "Core/Window.h"
+#include "ResourceState.h"
 
+#include "DiligentTools/TextureLoader/interface/TextureLoader.h"
 #include "DiligentTools/TextureLoader/interface/TextureUtilities.h"
 
 using namespace Diligent;
 
+namespace
+{
+	// True when mip 0 is RGBA8 with every alpha at 255
+	// Whether every texel has full alpha ('opaque'), and whether every texel has either full or zero alpha ('cutout')
+	void ClassifyAlpha(ITextureLoader* loader, bool& opaque, bool& cutout)
+	{
+		opaque = false;
+		cutout = false;
+
+		const TextureDesc& desc = loader->GetTextureDesc();
+		if (desc.Format != TEX_FORMAT_RGBA8_UNORM && desc.Format != TEX_FORMAT_RGBA8_UNORM_SRGB)
+			return;
+
+		TextureSubResData data = loader->GetSubresourceData(0, 0);
+		const uint8_t* row = static_cast<const uint8_t*>(data.pData);
+		if (!row)
+			return;
+
+		bool anyClear = false;
+		for (uint32_t y = 0; y < desc.Height; ++y, row += data.Stride)
+		{
+			for (uint32_t x = 0; x < desc.Width; ++x)
+			{
+				uint8_t alpha = row[x * 4 + 3];
+				if (alpha == 0)
+					anyClear = true;
+				else if (alpha != 255)
+					return;
+			}
+		}
+		opaque = !anyClear;
+		cutout = true;
+	}
+} // namespace
+
 Texture::Texture(const std::string& path, Filter filter, Wrap wrap)
       : m_FilePath(path)
 {
@@ -18,7 +59,14 @@ Texture::Texture(const std::string& path, Filter filter, Wrap wrap)
 
 	auto device = Window::GetDevice();
 
-	CreateTextureFromFile(path.c_str(), loadInfo, device, &m_Texture);
+	// Through a loader rather than CreateTextureFromFile, so the decoded texels can be checked for alpha
+	RefCntAutoPtr<ITextureLoader> loader;
+	CreateTextureLoaderFromFile(path.c_str(), IMAGE_FILE_FORMAT_UNKNOWN, loadInfo, &loader);
+	if (loader)
+	{
+		loader->CreateTexture(device, &m_Texture);
+		ClassifyAlpha(loader, m_Opaque, m_Cutout);
+	}
 
 	if (m_Texture)
 	{
@@ -28,6 +76,7 @@ Texture::Texture(const std::string& path, Filter filter, Wrap wrap)
 		m_Format = Desc.Format;
 
 		m_View = m_Texture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+		ResourceState::Request(m_Texture, RESOURCE_STATE_SHADER_RESOURCE);
 
 		// Sampler
 		SamplerDesc SampDesc;
@@ -47,22 +96,33 @@ Texture::Texture(const std::string& path, Filter filter, Wrap wrap)
 	}
 }
 
-Texture::Texture(uint32_t width, uint32_t height, TEXTURE_FORMAT format, Filter filter, Wrap wrap)
+Texture::Texture(uint32_t width, uint32_t height, TEXTURE_FORMAT format, Filter filter, Wrap wrap, bool renderTarget, uint32_t mipLevels)
       : m_Width(width), m_Height(height), m_Format(format)
 {
 	TextureDesc TexDesc;
-	TexDesc.Name = "Texture";
+	TexDesc.Name = renderTarget ? "Render Target Texture" : "Texture";
 	TexDesc.Type = RESOURCE_DIM_TEX_2D;
 	TexDesc.Width = width;
 	TexDesc.Height = height;
 	TexDesc.Format = format;
 	TexDesc.Usage = USAGE_DEFAULT;
 	TexDesc.BindFlags = BIND_SHADER_RESOURCE;
-	TexDesc.MipLevels = 1;
+	TexDesc.MipLevels = std::max(mipLevels, 1u);
+
+	if (renderTarget)
+	{
+		// Render targets are usually drawn smaller than their size, so they keep a mip chain
+		TexDesc.BindFlags |= BIND_RENDER_TARGET;
+		TexDesc.MipLevels = 0;
+		TexDesc.MiscFlags = MISC_TEXTURE_FLAG_GENERATE_MIPS;
+	}
 
 	auto device = Window::GetDevice();
 	device->CreateTexture(TexDesc, nullptr, &m_Texture);
 	m_View = m_Texture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE);
+	if (renderTarget)
+		m_RTV = m_Texture->GetDefaultView(TEXTURE_VIEW_RENDER_TARGET);
+	ResourceState::Request(m_Texture, RESOURCE_STATE_SHADER_RESOURCE);
 
 	// Sampler
 	SamplerDesc SampDesc;
@@ -79,17 +139,24 @@ Texture::Texture(uint32_t width, uint32_t height, TEXTURE_FORMAT format, Filter
 
 Texture::~Texture()
 {
+	// A frame in flight may still sample this texture through a raw pointer
+	RenderThread::Wait();
 }
 
 Texture::Texture(Texture&& other) noexcept
 {
 	m_Texture = std::move(other.m_Texture);
 	m_View = std::move(other.m_View);
+	m_RTV = std::move(other.m_RTV);
 	m_Sampler = std::move(other.m_Sampler);
 	m_Width = other.m_Width;
 	m_Height = other.m_Height;
 	m_FilePath = std::move(other.m_FilePath);
 	m_Format = other.m_Format;
+	m_Opaque = other.m_Opaque;
+	m_Cutout = other.m_Cutout;
+	m_AtlasPage = other.m_AtlasPage;
+	m_AtlasUVRect = other.m_AtlasUVRect;
 }
 
 Texture& Texture::operator=(Texture&& other) noexcept
@@ -98,11 +165,16 @@ Texture& Texture::operator=(Texture&& other) noexcept
 	{
 		m_Texture = std::move(other.m_Texture);
 		m_View = std::move(other.m_View);
+		m_RTV = std::move(other.m_RTV);
 		m_Sampler = std::move(other.m_Sampler);
 		m_Width = other.m_Width;
 		m_Height = other.m_Height;
 		m_FilePath = std::move(other.m_FilePath);
 		m_Format = other.m_Format;
+		m_Opaque = other.m_Opaque;
+		m_Cutout = other.m_Cutout;
+		m_AtlasPage = other.m_AtlasPage;
+		m_AtlasUVRect = other.m_AtlasUVRect;
 	}
 	return *this;
 }
@@ -118,17 +190,56 @@ void Texture::Unbind() const
 
 void Texture::SetData(void* data, uint32_t size)
 {
+	uint32_t stride = m_Width * TexelSize();
+	PostUpdate(0, 0, 0, m_Width, m_Height, data, stride);
+}
+
+void Texture::SetData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t stride)
+{
+	PostUpdate(0, x, y, width, height, data, stride);
+}
+
+void Texture::SetMipData(uint32_t mip, const void* data, uint32_t stride)
+{
+	PostUpdate(mip, 0, 0, std::max(m_Width >> mip, 1u), std::max(m_Height >> mip, 1u), data, stride);
+}
+
+void Texture::PostUpdate(uint32_t mip, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t stride)
+{
+	// The caller's buffer is copied, tightly packed, so the upload can wait for the frame in flight instead of the caller
+	uint32_t rowBytes = width * TexelSize();
+	std::vector<uint8_t> pixels((size_t) rowBytes * height);
+	for (uint32_t row = 0; row < height; ++row)
+		memcpy(&pixels[(size_t) row * rowBytes], (const uint8_t*) data + (size_t) row * stride, rowBytes);
+
 	Box UpdateBox;
-	UpdateBox.MinX = 0;
-	UpdateBox.MaxX = m_Width;
-	UpdateBox.MinY = 0;
-	UpdateBox.MaxY = m_Height;
-
-	TextureSubResData SubResData;
-	SubResData.pData = data;
-	SubResData.Stride = m_Width * 4;
-	if (m_Format == TEX_FORMAT_R8_UNORM)
-		SubResData.Stride = m_Width;
-
-	Window::GetContext()->UpdateTexture(m_Texture, 0, 0, UpdateBox, SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+	UpdateBox.MinX = x;
+	UpdateBox.MaxX = x + width;
+	UpdateBox.MinY = y;
+	UpdateBox.MaxY = y + height;
+
+	RefCntAutoPtr<ITexture> texture = m_Texture;
+	RenderThread::Post([texture, mip, UpdateBox, rowBytes, pixels = std::move(pixels)]()
+	{
+		TextureSubResData SubResData;
+		SubResData.pData = pixels.data();
+		SubResData.Stride = rowBytes;
+
+		Window::GetContext()->UpdateTexture(texture, mip, 0, UpdateBox, SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+		ResourceState::Request(texture, RESOURCE_STATE_SHADER_RESOURCE);
+	});
+}
+
+void Texture::GenerateMips()
+{
+	if (!m_RTV)
+		return;
+
+	RefCntAutoPtr<ITexture> texture = m_Texture;
+	RefCntAutoPtr<ITextureView> view = m_View;
+	RenderThread::Post([texture, view]()
+	{
+		Window::GetContext()->GenerateMips(view);
+		ResourceState::Request(texture, RESOURCE_STATE_SHADER_RESOURCE);
+	});
 }
@@ -2,6 +2,8 @@
 
 #include <string>
 
+#include <glm.hpp>
+
 #include "RefCntAutoPtr.hpp"
 #include "RenderDevice.h"
 
@@ -23,7 +25,9 @@ public:
 	};
 
 	Texture(const std::string& path, Filter filter = Filter::Nearest, Wrap wrap = Wrap::Repeat);
-	Texture(uint32_t width, uint32_t height, TEXTURE_FORMAT format = TEX_FORMAT_RGBA8_UNORM, Filter filter = Filter::Nearest, Wrap wrap = Wrap::ClampToEdge);
+	// 'renderTarget' textures can be drawn into (Renderer::BeginRenderToTexture) and carry a full mip chain.
+	// Other textures get 'mipLevels' levels, filled through SetMipData.
+	Texture(uint32_t width, uint32_t height, TEXTURE_FORMAT format = TEX_FORMAT_RGBA8_UNORM, Filter filter = Filter::Nearest, Wrap wrap = Wrap::ClampToEdge, bool renderTarget = false, uint32_t mipLevels = 1);
 	~Texture();
 
 	Texture(const Texture&) = delete;
@@ -35,8 +39,18 @@ public:
 	void Bind(uint32_t slot = 0) const;
 	void Unbind() const;
 
+	// Uploads are copied and handed to RenderThread::Post, so callers never wait for the frame in flight.
 	void SetData(void* data, uint32_t size);
 
+	// Updates the sub-rect (x, y, width, height); 'stride' is the byte pitch between rows of 'data'.
+	void SetData(const void* data, uint32_t x, uint32_t y, uint32_t width, uint32_t height, uint32_t stride);
+
+	// Replaces the whole of mip level 'mip'; 'stride' is the byte pitch between rows of 'data'.
+	void SetMipData(uint32_t mip, const void* data, uint32_t stride);
+
+	// Rebuilds mips 1..N from mip 0. Render targets only.
+	void GenerateMips();
+
 	inline uint32_t GetWidth() const
 	{
 		return m_Width;
@@ -52,6 +66,12 @@ public:
 		return m_View;
 	}
 
+	// Null unless created as a render target
+	ITextureView* GetRTV() const
+	{
+		return m_RTV;
+	}
+
 	ISampler* GetSampler() const
 	{
 		return m_Sampler;
@@ -62,6 +82,64 @@ public:
 		return m_Texture;
 	}
 
+	const std::string& GetFilePath() const
+	{
+		return m_FilePath;
+	}
+
+	// True when every texel has full alpha, so sprites using it may skip blending (Renderer::DrawSpritesLayered).
+	// Detected for RGBA8 image files; set it by hand for textures filled through SetData.
+	bool IsOpaque() const
+	{
+		return m_Opaque;
+	}
+
+	void SetOpaque(bool opaque)
+	{
+		m_Opaque = opaque;
+	}
+
+	// True when every texel has either full or zero alpha (opaque textures included), so DrawSpritesLayered can
+	// draw it blend-off with an alpha test. Detected like IsOpaque.
+	bool IsCutout() const
+	{
+		return m_Cutout || m_Opaque;
+	}
+
+	void SetCutout(bool cutout)
+	{
+		m_Cutout = cutout;
+	}
+
+	// Atlas placement, assigned by TextureAtlas. The renderer samples this sub-rect of the
+	// page instead of the standalone texture. uvRect is (uMin, vMin, uMax, vMax).
+	void SetAtlasRegion(Texture* page, const glm::vec4& uvRect)
+	{
+		m_AtlasPage = page;
+		m_AtlasUVRect = uvRect;
+	}
+
+	void ClearAtlasRegion()
+	{
+		m_AtlasPage = nullptr;
+		m_AtlasUVRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+	}
+
+	bool IsInAtlas() const
+	{
+		return m_AtlasPage != nullptr;
+	}
+
+	Texture* GetAtlasPage() const
+	{
+		return m_AtlasPage;
+	}
+
+	const glm::vec4& GetAtlasUVRect() const
+	{
+		return m_AtlasUVRect;
+	}
+
 	// Legacy ID support (returns 0, use GetSRV)
 	uint32_t GetID() const
 	{
@@ -76,10 +154,23 @@ public:
 private:
 	RefCntAutoPtr<ITexture> m_Texture;
 	RefCntAutoPtr<ITextureView> m_View;
+	RefCntAutoPtr<ITextureView> m_RTV;
 	RefCntAutoPtr<ISampler> m_Sampler;
 
 	std::string m_FilePath;
 	uint32_t m_Width = 0;
 	uint32_t m_Height = 0;
 	TEXTURE_FORMAT m_Format;
+	bool m_Opaque = false;
+	bool m_Cutout = false;
+
+	Texture* m_AtlasPage = nullptr;
+	glm::vec4 m_AtlasUVRect = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f);
+
+	uint32_t TexelSize() const
+	{
+		return m_Format == TEX_FORMAT_R8_UNORM ? 1 : 4;
+	}
+
+	void PostUpdate(uint32_t mip, uint32_t x, uint32_t y, uint32_t width, uint32_t height, const void* data, uint32_t stride);
 };
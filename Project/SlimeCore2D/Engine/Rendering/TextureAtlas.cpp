@@ -0,0 +1,235 @@
+#include "TextureAtlas.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Core/Logger.h"
+#include "Core/RenderThread.h"
+#include "Texture.h"
+
+// Both implementations are kept private to this translation unit so they cannot clash with
+// copies compiled into third-party libraries.
+#define STB_IMAGE_STATIC
+#define STB_IMAGE_IMPLEMENTATION
+#include "stb_image.h"
+
+#define STBRP_STATIC
+#define STB_RECT_PACK_IMPLEMENTATION
+#include "stb_rect_pack.h"
+
+namespace
+{
+	struct SourceImage
+	{
+		Texture* Target = nullptr;
+		stbi_uc* Pixels = nullptr;
+		int Width = 0;
+		int Height = 0;
+	};
+
+	// Copies 'src' into the page at (x, y) and extrudes its edge pixels 'padding' texels outward,
+	// so filtering or rounding at the sprite border never picks up a neighbour.
+	void BlitExtruded(std::vector<uint8_t>& page, uint32_t pageSize, const SourceImage& src, int x, int y, int padding)
+	{
+		int outW = src.Width + padding * 2;
+		int outH = src.Height + padding * 2;
+
+		for (int dy = 0; dy < outH; ++dy)
+		{
+			int sy = std::clamp(dy - padding, 0, src.Height - 1);
+			uint8_t* dstRow = page.data() + ((size_t) (y + dy) * pageSize + x) * 4;
+			const stbi_uc* srcRow = src.Pixels + (size_t) sy * src.Width * 4;
+
+			for (int dx = 0; dx < outW; ++dx)
+			{
+				int sx = std::clamp(dx - padding, 0, src.Width - 1);
+				memcpy(dstRow + dx * 4, srcRow + sx * 4, 4);
+			}
+		}
+	}
+
+	// Box-filters 'src' (size x size RGBA) into 'dst' at half the size
+	void Downsample(const std::vector<uint8_t>& src, uint32_t size, std::vector<uint8_t>& dst)
+	{
+		uint32_t half = std::max(size / 2, 1u);
+		dst.resize((size_t) half * half * 4);
+
+		for (uint32_t y = 0; y < half; ++y)
+		{
+			const uint8_t* row0 = src.data() + (size_t) (y * 2) * size * 4;
+			const uint8_t* row1 = row0 + (size_t) size * 4;
+			uint8_t* out = dst.data() + (size_t) y * half * 4;
+
+			for (uint32_t x = 0; x < half; ++x)
+			{
+				for (int c = 0; c < 4; ++c)
+				{
+					uint32_t sum = row0[x * 8 + c] + row0[x * 8 + 4 + c] + row1[x * 8 + c] + row1[x * 8 + 4 + c];
+					out[x * 4 + c] = (uint8_t) ((sum + 2) / 4);
+				}
+			}
+		}
+	}
+} // namespace
+
+TextureAtlas::TextureAtlas(uint32_t pageSize, uint32_t padding, uint32_t maxSpriteSize)
+      : m_PageSize(pageSize)
+{
+	// Every sprite rect starts and ends on a multiple of the padding, so each texel of mip k (k < m_MipLevels)
+	// averages a block from a single sprite and its extruded border
+	m_Padding = 1;
+	m_MipLevels = 1;
+	while (m_Padding * 2 <= padding)
+	{
+		m_Padding *= 2;
+		m_MipLevels++;
+	}
+	if (padding == 0)
+	{
+		m_Padding = 0;
+		m_MipLevels = 1;
+	}
+
+	m_MaxSpriteSize = std::min(maxSpriteSize, pageSize - m_Padding * 2);
+}
+
+TextureAtlas::~TextureAtlas()
+{
+	Clear();
+}
+
+uint32_t TextureAtlas::Build(const std::vector<Texture*>& textures)
+{
+	// The frame in flight resolves atlas pages and UV rects from the textures while drawing
+	RenderThread::Wait();
+	Clear();
+
+	// 1. Decode the source images (the GPU copies are not readable from the CPU)
+	std::vector<SourceImage> images;
+	images.reserve(textures.size());
+
+	for (Texture* tex: textures)
+	{
+		if (!tex || tex->GetFilePath().empty())
+			continue;
+
+		if (tex->GetWidth() > m_MaxSpriteSize || tex->GetHeight() > m_MaxSpriteSize)
+			continue;
+
+		SourceImage img;
+		img.Target = tex;
+		int channels = 0;
+		img.Pixels = stbi_load(tex->GetFilePath().c_str(), &img.Width, &img.Height, &channels, 4);
+		if (!img.Pixels)
+		{
+			Logger::Warn("TextureAtlas: Could not decode '" + tex->GetFilePath() + "', leaving it standalone.");
+			continue;
+		}
+
+		images.push_back(img);
+	}
+
+	// 2. Pack into as many pages as needed. Rects are packed in blocks of 'padding' texels so they stay aligned for the mips
+	int block = (int) std::max(m_Padding, 1u);
+	int pageBlocks = (int) m_PageSize / block;
+
+	std::vector<stbrp_rect> pending;
+	pending.reserve(images.size());
+	for (size_t i = 0; i < images.size(); ++i)
+	{
+		stbrp_rect r = {};
+		r.id = (int) i;
+		r.w = (images[i].Width + (int) m_Padding * 2 + block - 1) / block;
+		r.h = (images[i].Height + (int) m_Padding * 2 + block - 1) / block;
+		pending.push_back(r);
+	}
+
+	std::vector<stbrp_node> nodes(pageBlocks);
+	std::vector<uint8_t> pixels;
+	std::vector<uint8_t> mipPixels[2];
+
+	while (!pending.empty())
+	{
+		stbrp_context ctx;
+		stbrp_init_target(&ctx, pageBlocks, pageBlocks, nodes.data(), (int) nodes.size());
+		stbrp_pack_rects(&ctx, pending.data(), (int) pending.size());
+
+		pixels.assign((size_t) m_PageSize * m_PageSize * 4, 0);
+
+		std::vector<stbrp_rect> leftover;
+		std::vector<stbrp_rect> placed;
+		for (const auto& r: pending)
+		{
+			if (r.was_packed)
+				placed.push_back(r);
+			else
+				leftover.push_back(r);
+		}
+
+		if (placed.empty())
+			break;
+
+		Texture* page = new Texture(m_PageSize, m_PageSize, TEX_FORMAT_RGBA8_UNORM, Texture::Filter::Nearest, Texture::Wrap::ClampToEdge, false, m_MipLevels);
+
+		float invSize = 1.0f / (float) m_PageSize;
+		for (const auto& r: placed)
+		{
+			const SourceImage& img = images[r.id];
+			int x = r.x * block;
+			int y = r.y * block;
+			BlitExtruded(pixels, m_PageSize, img, x, y, (int) m_Padding);
+
+			float u0 = (float) (x + m_Padding) * invSize;
+			float v0 = (float) (y + m_Padding) * invSize;
+			float u1 = (float) (x + m_Padding + img.Width) * invSize;
+			float v1 = (float) (y + m_Padding + img.Height) * invSize;
+
+			img.Target->SetAtlasRegion(page, { u0, v0, u1, v1 });
+			m_Packed.push_back(img.Target);
+		}
+
+		page->SetData(pixels.data(), (uint32_t) pixels.size());
+
+		// Minified sprites sample these instead of skipping texels of mip 0
+		const std::vector<uint8_t>* level = &pixels;
+		uint32_t levelSize = m_PageSize;
+		for (uint32_t mip = 1; mip < m_MipLevels; ++mip)
+		{
+			std::vector<uint8_t>& next = mipPixels[mip & 1];
+			Downsample(*level, levelSize, next);
+			levelSize = std::max(levelSize / 2, 1u);
+			page->SetMipData(mip, next.data(), levelSize * 4);
+			level = &next;
+		}
+
+		m_Pages.push_back(page);
+
+		pending.swap(leftover);
+	}
+
+	for (auto& img: images)
+		stbi_image_free(img.Pixels);
+
+	s_Generation++;
+
+	Logger::Info("TextureAtlas: Packed " + std::to_string(m_Packed.size()) + " of " + std::to_string(textures.size()) + " textures into " + std::to_string(m_Pages.size()) + " page(s)");
+
+	return (uint32_t) m_Packed.size();
+}
+
+void TextureAtlas::Clear()
+{
+	RenderThread::Wait();
+
+	for (Texture* tex: m_Packed)
+		tex->ClearAtlasRegion();
+	m_Packed.clear();
+
+	if (m_Pages.empty())
+		return;
+
+	for (Texture* page: m_Pages)
+		delete page;
+	m_Pages.clear();
+	s_Generation++;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+class Texture;
+
+// Packs individually loaded sprite textures into a few large RGBA pages at runtime.
+// Packed textures keep their standalone GPU texture (tiling and meshes still use it), but are
+// tagged with a (page, UV rect) region so the 2D renderer batches them against the shared page.
+class TextureAtlas
+{
+public:
+	// 'pageSize': width/height of each page in pixels.
+	// 'padding': border around each sprite, filled by extruding its edge pixels. Rounded down to a power of two;
+	// pages carry log2(padding) + 1 mip levels, as deeper mips would blend neighbouring sprites together.
+	// 'maxSpriteSize': textures larger than this on either axis are left standalone.
+	TextureAtlas(uint32_t pageSize = 2048, uint32_t padding = 8, uint32_t maxSpriteSize = 512);
+	~TextureAtlas();
+
+	TextureAtlas(const TextureAtlas&) = delete;
+	TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+	// Discards the current pages and repacks the given textures from their source files.
+	// Returns the number of textures that were placed in the atlas.
+	uint32_t Build(const std::vector<Texture*>& textures);
+
+	// Releases all pages and restores every packed texture to standalone sampling.
+	void Clear();
+
+	size_t GetPageCount() const
+	{
+		return m_Pages.size();
+	}
+
+	Texture* GetPage(size_t index) const
+	{
+		return m_Pages[index];
+	}
+
+	// Bumped by every Build and Clear of any atlas. Geometry baked with atlas UVs (static chunks,
+	// retained UI layers) compares it against the value it was built with.
+	static uint32_t GetGeneration()
+	{
+		return s_Generation;
+	}
+
+private:
+	uint32_t m_PageSize;
+	uint32_t m_Padding;
+	uint32_t m_MaxSpriteSize;
+	uint32_t m_MipLevels;
+
+	std::vector<Texture*> m_Pages;
+	std::vector<Texture*> m_Packed;
+
+	static inline uint32_t s_Generation = 0;
+};
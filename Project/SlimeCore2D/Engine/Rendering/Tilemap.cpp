@@ -0,0 +1,250 @@
+#include "Tilemap.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Core/Logger.h"
+#include "Core/RenderThread.h"
+#include "Core/Window.h"
+#include "Minimap.h"
+#include "ResourceState.h"
+
+Tilemap::Tilemap(uint32_t width, uint32_t height, float tileSize)
+      : m_Width(width), m_Height(height), m_TileSize(tileSize)
+{
+	m_ChunksX = (width + ChunkSize - 1) / ChunkSize;
+	m_ChunksY = (height + ChunkSize - 1) / ChunkSize;
+
+	m_Tiles.assign((size_t) width * height * 2, 0);
+	for (size_t i = 0; i < m_Tiles.size(); i += 2)
+		m_Tiles[i] = EmptyTile;
+
+	m_Chunks.resize((size_t) m_ChunksX * m_ChunksY);
+}
+
+Tilemap::~Tilemap() = default;
+
+void Tilemap::SetTileType(uint8_t type, Texture* sheet, uint32_t frameCount, float frameRate)
+{
+	if (type >= MaxTileTypes)
+	{
+		Logger::Warn("Tilemap: Tile type " + std::to_string(type) + " is out of range (max " + std::to_string(MaxTileTypes - 1) + ")");
+		return;
+	}
+
+	// The frame in flight reads the tile types while drawing
+	RenderThread::Wait();
+
+	m_Types[type].Sheet = sheet;
+	m_Types[type].FrameCount = std::max<uint32_t>(frameCount, 1);
+	m_Types[type].FrameRate = frameRate;
+	m_TypeRevision++;
+}
+
+void Tilemap::SetTile(uint32_t x, uint32_t y, uint8_t type, uint8_t mask)
+{
+	if (x >= m_Width || y >= m_Height)
+		return;
+
+	uint8_t* tile = &m_Tiles[((size_t) y * m_Width + x) * 2];
+	if (tile[0] == type && tile[1] == mask)
+		return;
+
+	if (m_Minimap && tile[0] != type)
+		m_Minimap->SetTile(x, y, type);
+
+	tile[0] = type;
+	tile[1] = mask;
+	MarkDirty(x, y);
+}
+
+void Tilemap::SetTileMask(uint32_t x, uint32_t y, uint8_t mask)
+{
+	if (x >= m_Width || y >= m_Height)
+		return;
+
+	SetTile(x, y, GetTile(x, y), mask);
+}
+
+uint8_t Tilemap::GetTile(uint32_t x, uint32_t y) const
+{
+	if (x >= m_Width || y >= m_Height)
+		return EmptyTile;
+	return m_Tiles[((size_t) y * m_Width + x) * 2];
+}
+
+uint8_t Tilemap::GetTileMask(uint32_t x, uint32_t y) const
+{
+	if (x >= m_Width || y >= m_Height)
+		return 0;
+	return m_Tiles[((size_t) y * m_Width + x) * 2 + 1];
+}
+
+void Tilemap::Fill(uint8_t type)
+{
+	for (size_t i = 0; i < m_Tiles.size(); i += 2)
+	{
+		m_Tiles[i] = type;
+		m_Tiles[i + 1] = North | East | South | West;
+	}
+
+	for (auto& chunk: m_Chunks)
+	{
+		chunk.Dirty = true;
+		chunk.Revision++;
+	}
+	m_AnyDirty = true;
+
+	if (m_Minimap)
+		m_Minimap->Refresh(m_Tiles.data(), 2);
+}
+
+void Tilemap::RecalculateMasks()
+{
+	for (uint32_t y = 0; y < m_Height; ++y)
+	{
+		for (uint32_t x = 0; x < m_Width; ++x)
+		{
+			uint8_t type = GetTile(x, y);
+			uint8_t mask = 0;
+			if (y + 1 < m_Height && GetTile(x, y + 1) == type)
+				mask |= North;
+			if (x + 1 < m_Width && GetTile(x + 1, y) == type)
+				mask |= East;
+			if (y > 0 && GetTile(x, y - 1) == type)
+				mask |= South;
+			if (x > 0 && GetTile(x - 1, y) == type)
+				mask |= West;
+
+			SetTileMask(x, y, mask);
+		}
+	}
+}
+
+void Tilemap::MarkDirty(uint32_t x, uint32_t y)
+{
+	Chunk& chunk = m_Chunks[(size_t) (y / ChunkSize) * m_ChunksX + (x / ChunkSize)];
+	chunk.Dirty = true;
+	chunk.Revision++;
+	m_AnyDirty = true;
+}
+
+void Tilemap::UploadDirtyChunks()
+{
+	if (!m_AnyDirty)
+		return;
+
+	auto device = Window::GetDevice();
+
+	// Chunks on the right/top edge may be partially outside the map; the rest of their texture stays empty.
+	// Updates are posted with their own copy, so edits never wait for the frame in flight; only a chunk's first
+	// upload does, since the render thread may be reading its (still empty) texture slot.
+	std::vector<uint8_t> scratch((size_t) ChunkSize * ChunkSize * 2);
+
+	for (uint32_t cy = 0; cy < m_ChunksY; ++cy)
+	{
+		for (uint32_t cx = 0; cx < m_ChunksX; ++cx)
+		{
+			Chunk& chunk = m_Chunks[(size_t) cy * m_ChunksX + cx];
+			if (!chunk.Dirty)
+				continue;
+
+			for (size_t i = 0; i < scratch.size(); i += 2)
+			{
+				scratch[i] = EmptyTile;
+				scratch[i + 1] = 0;
+			}
+
+			uint32_t x0 = cx * ChunkSize;
+			uint32_t y0 = cy * ChunkSize;
+			uint32_t w = std::min(ChunkSize, m_Width - x0);
+			uint32_t h = std::min(ChunkSize, m_Height - y0);
+			for (uint32_t row = 0; row < h; ++row)
+			{
+				const uint8_t* src = &m_Tiles[((size_t) (y0 + row) * m_Width + x0) * 2];
+				memcpy(&scratch[(size_t) row * ChunkSize * 2], src, (size_t) w * 2);
+			}
+
+			if (!chunk.Texture)
+			{
+				RenderThread::Wait();
+
+				TextureDesc TexDesc;
+				TexDesc.Name = "Tilemap Chunk";
+				TexDesc.Type = RESOURCE_DIM_TEX_2D;
+				TexDesc.Width = ChunkSize;
+				TexDesc.Height = ChunkSize;
+				TexDesc.Format = TEX_FORMAT_RG8_UINT;
+				TexDesc.Usage = USAGE_DEFAULT;
+				TexDesc.BindFlags = BIND_SHADER_RESOURCE;
+				TexDesc.MipLevels = 1;
+
+				TextureSubResData SubResData;
+				SubResData.pData = scratch.data();
+				SubResData.Stride = ChunkSize * 2;
+
+				TextureData InitData;
+				InitData.pSubResources = &SubResData;
+				InitData.NumSubresources = 1;
+				device->CreateTexture(TexDesc, &InitData, &chunk.Texture);
+				ResourceState::Request(chunk.Texture, RESOURCE_STATE_SHADER_RESOURCE);
+			}
+			else
+			{
+				RefCntAutoPtr<ITexture> texture = chunk.Texture;
+				RenderThread::Post([texture, tiles = scratch]()
+				{
+					Box UpdateBox;
+					UpdateBox.MaxX = ChunkSize;
+					UpdateBox.MaxY = ChunkSize;
+
+					TextureSubResData SubResData;
+					SubResData.pData = tiles.data();
+					SubResData.Stride = ChunkSize * 2;
+
+					Window::GetContext()->UpdateTexture(texture, 0, 0, UpdateBox, SubResData, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+					ResourceState::Request(texture, RESOURCE_STATE_SHADER_RESOURCE);
+				});
+			}
+
+			chunk.Dirty = false;
+		}
+	}
+
+	m_AnyDirty = false;
+}
+
+ITextureView* Tilemap::GetChunkView(uint32_t cx, uint32_t cy) const
+{
+	if (cx >= m_ChunksX || cy >= m_ChunksY)
+		return nullptr;
+
+	const Chunk& chunk = m_Chunks[(size_t) cy * m_ChunksX + cx];
+	return chunk.Texture ? chunk.Texture->GetDefaultView(TEXTURE_VIEW_SHADER_RESOURCE) : nullptr;
+}
+
+uint64_t Tilemap::GetRegionRevision(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) const
+{
+	uint64_t revision = m_TypeRevision;
+	if (x0 >= m_Width || y0 >= m_Height || x1 < x0 || y1 < y0)
+		return revision;
+
+	uint32_t cx1 = std::min(x1, m_Width - 1) / ChunkSize;
+	uint32_t cy1 = std::min(y1, m_Height - 1) / ChunkSize;
+	for (uint32_t cy = y0 / ChunkSize; cy <= cy1; ++cy)
+	{
+		for (uint32_t cx = x0 / ChunkSize; cx <= cx1; ++cx)
+			revision += m_Chunks[(size_t) cy * m_ChunksX + cx].Revision;
+	}
+	return revision;
+}
+
+Minimap* Tilemap::EnableMinimap()
+{
+	if (!m_Minimap)
+	{
+		m_Minimap = std::make_unique<Minimap>(m_Width, m_Height);
+		m_Minimap->Refresh(m_Tiles.data(), 2);
+	}
+	return m_Minimap.get();
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm.hpp>
+
+#include "RefCntAutoPtr.hpp"
+#include "RenderDevice.h"
+
+using namespace Diligent;
+
+class Minimap;
+class Texture;
+
+// Chunked tile grid drawn almost entirely on the GPU.
+// Every chunk keeps its tiles in a small RG8_UINT texture (R = tile type, G = 4-bit autotile mask) and is
+// drawn as a single quad; the pixel shader picks the autotile cell and animation frame per pixel.
+// Drawing cost follows the number of visible chunks, not the size of the map.
+class Tilemap
+{
+public:
+	static constexpr uint32_t ChunkSize = 64;    // Tiles per chunk side
+	static constexpr uint32_t MaxTileTypes = 31; // Texture slot 0 stays reserved for white
+	static constexpr uint8_t EmptyTile = 255;
+
+	// Autotile masks use the same bits as the managed ConnectivityMask
+	enum Neighbour : uint8_t
+	{
+		North = 1 << 0,
+		East = 1 << 1,
+		South = 1 << 2,
+		West = 1 << 3
+	};
+
+	// A tile type samples one 3x3 autotile sheet. Animated types lay 'FrameCount' sheets side by side.
+	struct TileType
+	{
+		Texture* Sheet = nullptr;
+		uint32_t FrameCount = 1;
+		float FrameRate = 0.0f;
+	};
+
+	Tilemap(uint32_t width, uint32_t height, float tileSize = 1.0f);
+	~Tilemap();
+
+	Tilemap(const Tilemap&) = delete;
+	Tilemap& operator=(const Tilemap&) = delete;
+
+	void SetTileType(uint8_t type, Texture* sheet, uint32_t frameCount = 1, float frameRate = 0.0f);
+	const TileType& GetTileType(uint8_t type) const
+	{
+		return m_Types[type];
+	}
+
+	void SetTile(uint32_t x, uint32_t y, uint8_t type, uint8_t mask);
+	void SetTileMask(uint32_t x, uint32_t y, uint8_t mask);
+	uint8_t GetTile(uint32_t x, uint32_t y) const;
+	uint8_t GetTileMask(uint32_t x, uint32_t y) const;
+	void Fill(uint8_t type);
+
+	// Rebuilds every mask from which orthogonal neighbours share the tile's type.
+	void RecalculateMasks();
+
+	// Pushes the tiles of every chunk edited since the last call to its GPU texture.
+	void UploadDirtyChunks();
+
+	uint32_t GetWidth() const
+	{
+		return m_Width;
+	}
+
+	uint32_t GetHeight() const
+	{
+		return m_Height;
+	}
+
+	float GetTileSize() const
+	{
+		return m_TileSize;
+	}
+
+	uint32_t GetChunksX() const
+	{
+		return m_ChunksX;
+	}
+
+	uint32_t GetChunksY() const
+	{
+		return m_ChunksY;
+	}
+
+	// Null until the chunk has been uploaded at least once.
+	ITextureView* GetChunkView(uint32_t cx, uint32_t cy) const;
+
+	// Sum of the edit counters of every chunk overlapping the tile rect [x0, x1] x [y0, y1], plus one for tile type
+	// changes. Counters only grow, so the value changes whenever anything drawn in that rect may have changed.
+	uint64_t GetRegionRevision(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1) const;
+
+	// Creates the overview texture on first call; from then on every tile edit is mirrored into it.
+	Minimap* EnableMinimap();
+	Minimap* GetMinimap() const
+	{
+		return m_Minimap.get();
+	}
+
+private:
+	struct Chunk
+	{
+		RefCntAutoPtr<ITexture> Texture;
+		uint32_t Revision = 1;
+		bool Dirty = true;
+	};
+
+	void MarkDirty(uint32_t x, uint32_t y);
+
+	uint32_t m_Width = 0;
+	uint32_t m_Height = 0;
+	float m_TileSize = 1.0f;
+	uint32_t m_ChunksX = 0;
+	uint32_t m_ChunksY = 0;
+
+	std::vector<uint8_t> m_Tiles; // Two bytes per tile (type, mask), row-major from the bottom-left
+	std::vector<Chunk> m_Chunks;
+	bool m_AnyDirty = true;
+
+	TileType m_Types[MaxTileTypes];
+	uint32_t m_TypeRevision = 0;
+	std::unique_ptr<Minimap> m_Minimap;
+};
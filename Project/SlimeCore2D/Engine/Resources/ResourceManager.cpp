@@ -4,6 +4,7 @@
 #include "Rendering/Shader.h"
 #include "Rendering/Font.h"
 #include "Rendering/Texture.h"
+#include "Rendering/TextureAtlas.h"
 //#include "Core/Memory.h"
 
 #if defined(_WIN32)
@@ -161,6 +162,7 @@ bool ResourceManager::LoadShadersFromDir(const std::string& dir)
 	}
 
 	Logger::Info("ResourceManager: using shader directory: " + chosen);
+	m_shaderDir = chosen;
 
 	std::unordered_map<std::string, std::string> vmap;
 	std::unordered_map<std::string, std::string> fmap;
@@ -382,6 +384,24 @@ Texture* ResourceManager::GetTexture(const std::string& name)
 	return nullptr;
 }
 
+uint32_t ResourceManager::BuildTextureAtlas()
+{
+	if (!m_textureAtlas)
+		m_textureAtlas = new TextureAtlas();
+
+	std::vector<Texture*> textures;
+	textures.reserve(m_textures.size());
+	for (auto& kv: m_textures)
+		textures.push_back(kv.second);
+
+	return m_textureAtlas->Build(textures);
+}
+
+size_t ResourceManager::GetTextureAtlasPageCount() const
+{
+	return m_textureAtlas ? m_textureAtlas->GetPageCount() : 0;
+}
+
 // -----------------------------------------------------------------------------
 // FONTS (SDF)
 // -----------------------------------------------------------------------------
@@ -408,8 +428,8 @@ Font* ResourceManager::LoadFont(const std::string& name, const std::string& rela
 	}
 
 	// 3. Load Font
-	// This generates the SDF atlas
-	Font* font = new Font(fullPath, fontSize);
+	// Reuses the SDF atlas cached next to the executable when the font file and size match
+	Font* font = new Font(fullPath, fontSize, GetCacheDir("FontCache"));
 
 	// 4. Store
 	m_fonts[key] = font;
@@ -528,6 +548,12 @@ std::string ResourceManager::GetResourcePath(const std::string& relativePath)
 	return std::string();
 }
 
+std::string ResourceManager::GetCacheDir(const std::string& folder)
+{
+	std::string exeDir = GetExecutableDir();
+	return exeDir.empty() ? std::string() : exeDir + PATH_SEP + folder;
+}
+
 std::string ResourceManager::GetManagedRuntimeConfigPath()
 {
 #if defined(_DEBUG)
@@ -597,7 +623,10 @@ void ResourceManager::Clear()
 	}
 	m_shaders.clear();
 
-	// 2. Textures
+	// 2. Textures (atlas first, it points back into the textures)
+	delete m_textureAtlas;
+	m_textureAtlas = nullptr;
+
 	for (auto& kv: m_textures)
 	{
 		delete kv.second;
@@ -607,6 +636,8 @@ void ResourceManager::Clear()
 	// 3. Fonts
 	for (auto& kv: m_fonts)
 	{
+		// Keep glyphs rasterized during the session for the next run
+		kv.second->SaveCache();
 		delete kv.second;
 	}
 	m_fonts.clear();
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 
@@ -7,6 +8,7 @@
 class Shader;
 class Texture;
 class Font;
+class TextureAtlas;
 
 class ResourceManager
 {
@@ -28,6 +30,13 @@ public:
 	// Add a shader explicitly
 	void AddShader(const std::string& name, const std::string& vertexPath, const std::string& fragmentPath);
 
+	// Directory the last LoadShadersFromDir() call loaded from, for shaders outside the vertex/pixel pairs
+	// (compute kernels). Empty if no directory was found.
+	const std::string& GetShaderDirectory() const
+	{
+		return m_shaderDir;
+	}
+
 	// -------------------------------------------------------------------------
 	// TEXTURE MANAGEMENT
 	// -------------------------------------------------------------------------
@@ -41,6 +50,14 @@ public:
 	// Retrieve a loaded texture by name. Returns nullptr if not found.
 	Texture* GetTexture(const std::string& name);
 
+	// Packs every loaded texture into shared atlas pages so sprites batch against a few views.
+	// Textures keep their handles; loading more textures later requires another build to pack them.
+	// Returns the number of textures placed in the atlas.
+	uint32_t BuildTextureAtlas();
+
+	// Number of atlas pages produced by the last BuildTextureAtlas() call.
+	size_t GetTextureAtlasPageCount() const;
+
 	// -------------------------------------------------------------------------
 	// FONT MANAGEMENT (SDF)
 	// -------------------------------------------------------------------------
@@ -77,6 +94,10 @@ public:
 	// Return a path relative to the .NET publish directory (where runtimeconfig.json lives).
 	std::string GetScriptingPath(const std::string& relativeToPublishRoot);
 
+	// Return the folder next to the executable used for a disk cache (e.g. "FontCache").
+	// The folder is not created here. Returns empty string if the executable directory is unknown.
+	std::string GetCacheDir(const std::string& folder);
+
 	// Unload all resources (Shaders, Textures, Fonts) and free memory.
 	void Clear();
 
@@ -93,4 +114,7 @@ private:
 	std::unordered_map<std::string, Texture*> m_textures;
 	std::unordered_map<std::string, Font*> m_fonts;
 	std::unordered_map<std::string, std::string> m_textFiles;
+
+	TextureAtlas* m_textureAtlas = nullptr;
+	std::string m_shaderDir;
 };
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <glm.hpp>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include "Rendering/Texture.h"
 
+class Tilemap;
+
 // Entity ID type
 using Entity = std::uint64_t;
 static constexpr Entity NullEntity = 0;
@@ -33,6 +36,20 @@ struct SpriteComponent
 	float TilingFactor = 1.0f;
 	bool IsVisible = true;
 	int Layer = 0; // Helper for Z-sorting if needed, though Z in Transform handles it too
+	// Baked into a cached chunk. Static sprites draw beneath every dynamic sprite whatever their Z,
+	// and animated ones (AnimationComponent with a frame rate) are drawn as dynamic regardless.
+	bool IsStatic = false;
+
+	// Nine-slice border widths in texels (left, top, right, bottom); zero draws the texture stretched
+	glm::vec4 Slice = { 0.0f, 0.0f, 0.0f, 0.0f };
+	float SliceScale = 0.0625f; // World units per texel of the borders
+};
+
+// Tile grid drawn from the entity's transform position (bottom-left of tile 0,0) at its z
+struct TilemapComponent
+{
+	std::shared_ptr<Tilemap> Map;
+	bool IsVisible = true;
 };
 
 struct AnimationComponent
@@ -1,18 +1,110 @@
 #include "Scene.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <string>
 
+#include <gtc/matrix_transform.hpp>
+
+#include "Core/JobSystem.h"
 #include "Core/Logger.h"
 #include "Core/Input.h"
+#include "Core/Window.h"
 #include "Physics/RigidBody.h"
+#include "Rendering/Minimap.h"
 #include "Rendering/ParticleSystem.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Renderer.h"
+#include "Rendering/TextureAtlas.h"
+#include "Rendering/Tilemap.h"
 
 #define ENABLE_SCENE_LOGGING 0
 
 Scene* Scene::s_ActiveScene = nullptr;
 
+// Components of one drawable entity, gathered serially so the parallel pass never touches the registry
+struct RenderItem
+{
+	const TransformComponent* Transform;
+	const SpriteComponent* Sprite;
+	const AnimationComponent* Animation;
+};
+
+// Scratch list reused by Render() every frame to avoid reallocating
+static std::vector<RenderItem> s_RenderItems;
+
+// World units covered by one static geometry chunk
+static constexpr float StaticChunkSize = 32.0f;
+
+// World units covered by one impostor cell
+static constexpr float ImpostorCellSize = 64.0f;
+
+// Caps how many cells are baked per frame. Stale cells keep showing their previous bake meanwhile,
+// and while any visible cell has never been baked the view is drawn live instead.
+static constexpr uint32_t MaxImpostorBakesPerFrame = 8;
+
+// A tilemap as the impostor pass sees it, gathered once per frame
+struct ImpostorSource
+{
+	std::shared_ptr<Tilemap> Map;
+	glm::vec3 Origin;
+	glm::vec2 Max;
+};
+
+static std::vector<ImpostorSource> s_ImpostorSources;
+static std::vector<std::pair<glm::vec2, Texture*>> s_ImpostorDraws;
+
+static int64_t CellKey(int32_t cx, int32_t cy)
+{
+	return ((int64_t) cx << 32) | (uint32_t) cy;
+}
+
+// Animated sprites change UVs every few frames, so baking them would rebuild their chunk that often
+static bool IsAnimated(const AnimationComponent* anim)
+{
+	return anim && anim->HasAnimation && anim->SpriteWidth > 0 && anim->FrameRate > 0.0f;
+}
+
+// World-space AABB of a (possibly rotated) sprite quad
+static void ComputeSpriteBounds(const TransformComponent& transform, glm::vec2& outMin, glm::vec2& outMax)
+{
+	glm::mat4 mat = transform.GetTransform();
+	outMin = glm::vec2(std::numeric_limits<float>::max());
+	outMax = glm::vec2(std::numeric_limits<float>::lowest());
+	for (const glm::vec2& corner: { glm::vec2(-0.5f, -0.5f), glm::vec2(0.5f, -0.5f), glm::vec2(0.5f, 0.5f), glm::vec2(-0.5f, 0.5f) })
+	{
+		glm::vec4 p = mat * glm::vec4(corner, 0.0f, 1.0f);
+		outMin = glm::min(outMin, glm::vec2(p));
+		outMax = glm::max(outMax, glm::vec2(p));
+	}
+}
+
+static void FillSpriteInstance(const TransformComponent& transform, const SpriteComponent& sprite, const AnimationComponent* anim, Renderer::SpriteInstance& instance)
+{
+	instance.Transform = transform.GetTransform();
+	instance.Texture = sprite.Texture;
+	instance.Color = sprite.Color;
+	instance.Tiling = sprite.Texture ? sprite.TilingFactor : 1.0f;
+	instance.UVRect = { 0.0f, 0.0f, 1.0f, 1.0f };
+	instance.Slice = sprite.Slice;
+	instance.SliceScale = sprite.SliceScale;
+
+	if (sprite.Texture && anim && anim->SpriteWidth > 0)
+	{
+		int texWidth = sprite.Texture->GetWidth();
+		int framesPerRow = texWidth / anim->SpriteWidth;
+		if (framesPerRow == 0)
+			framesPerRow = 1;
+		int column = anim->Frame % framesPerRow;
+
+		float u0 = (float) (column * anim->SpriteWidth) / texWidth;
+		float u1 = (float) ((column + 1) * anim->SpriteWidth) / texWidth;
+		instance.UVRect = { u0, 0.0f, u1, 1.0f };
+		instance.Tiling = 1.0f;
+	}
+}
+
 // Helper function to convert screen-space coordinates (pixels, top-left origin) to UI space (world units, center origin)
 static glm::vec2 ScreenSpaceToUISpace(float screenX, float screenY, float uiHeight)
 {
@@ -29,6 +121,72 @@ static glm::vec2 ScreenSpaceToUISpace(float screenX, float screenY, float uiHeig
 	return glm::vec2(uiX, uiY);
 }
 
+// Height of one screen pixel in UI units
+static float UIPixelSize(float uiHeight)
+{
+	auto viewport = Input::GetInstance()->GetViewportRect();
+	float vpH = viewport.w > 0 ? (float) viewport.w : 1080.0f;
+	return uiHeight / vpH;
+}
+
+// Where an element is drawn in UI space: the first baseline for text, the quad centre otherwise, with 'outSize'
+// the quad size. Text is reshaped here if its content or atlas changed.
+static glm::vec3 PlaceUIElement(PersistentUIElement& element, float uiHeight, glm::vec2& outSize)
+{
+	glm::vec2 position = element.Position;
+	glm::vec2 size = element.Scale;
+
+	if (element.UseScreenSpace)
+	{
+		position = ScreenSpaceToUISpace(element.Position.x, element.Position.y, uiHeight);
+
+		if (!element.IsText)
+			size = size * UIPixelSize(uiHeight);
+	}
+
+	outSize = size;
+
+	// Z is irrelevant now that Depth Test is disabled, but keep it 0.0f
+	glm::vec3 drawPos = glm::vec3(position.x, position.y, 0.0f);
+
+	if (element.IsText && element.Font)
+	{
+		element.Layout.Update(element.TextContent, element.Font, element.Scale.x, element.WrapWidth);
+		float textWidth = element.Layout.GetSize().x;
+		float textHeight = element.Layout.GetSize().y;
+		float maxY = element.Layout.GetMaxY();
+		float minY = textHeight - maxY;
+
+		glm::vec3 finalPos = drawPos;
+		finalPos.x += (0.0f - element.Anchor.x) * textWidth;
+
+		float baselineForBottom = drawPos.y + minY;
+		float baselineForCenter = drawPos.y - (maxY - minY) * 0.5f;
+		float baselineForTop = drawPos.y - maxY;
+
+		if (element.Anchor.y <= 0.5f)
+		{
+			float t = element.Anchor.y * 2.0f;
+			finalPos.y = baselineForBottom * (1.0f - t) + baselineForCenter * t;
+		}
+		else
+		{
+			float t = (element.Anchor.y - 0.5f) * 2.0f;
+			finalPos.y = baselineForCenter * (1.0f - t) + baselineForTop * t;
+		}
+
+		return finalPos;
+	}
+
+	float offX = (0.5f - element.Anchor.x) * size.x;
+	float offY = (0.5f - element.Anchor.y) * size.y;
+
+	glm::vec3 finalPos = drawPos;
+	finalPos.x += offX;
+	finalPos.y += offY;
+	return finalPos;
+}
+
 Scene::Scene()
 {
 	s_ActiveScene = this;
@@ -64,6 +222,7 @@ Scene::~Scene()
 	// Registry cleans up itself, but we should clear active entities
 	m_ActiveEntities.clear();
 	m_UIElements.clear();
+	m_UILayers.clear();
 }
 
 Entity Scene::GetPrimaryCameraEntity()
@@ -107,6 +266,7 @@ ObjectId Scene::CreateGameObject(glm::vec3 pos, glm::vec2 size, glm::vec3 color)
 	m_Registry.AddComponent(entity, anim);
 
 	m_ActiveEntities.push_back(entity);
+	m_DirtyTransforms.push_back(entity);
 	return entity;
 }
 
@@ -133,6 +293,7 @@ ObjectId Scene::CreateQuad(glm::vec3 pos, glm::vec2 size, Texture* tex)
 	m_Registry.AddComponent(entity, anim);
 
 	m_ActiveEntities.push_back(entity);
+	m_DirtyTransforms.push_back(entity);
 	return entity;
 }
 
@@ -140,6 +301,7 @@ void Scene::DestroyObject(ObjectId id)
 {
 	if (id >= 100000) // UI ID range check
 	{
+		MarkUIDirty(id);
 		m_UIElements.erase(id);
 		return;
 	}
@@ -160,6 +322,8 @@ void Scene::DestroyObject(ObjectId id)
 		}
 
 		m_ActiveEntities.erase(it);
+		m_SpatialGrid.Remove(id);
+		RemoveStaticMember(id);
 		m_Registry.DestroyEntity(id);
 	}
 }
@@ -182,6 +346,7 @@ ObjectId Scene::CreateUIElement(bool isText)
 	PersistentUIElement el;
 	el.IsText = isText;
 	m_UIElements[id] = el;
+	MarkUIDirty(id);
 	return id;
 }
 
@@ -193,101 +358,208 @@ PersistentUIElement* Scene::GetUIElement(ObjectId id)
 	return nullptr;
 }
 
-void Scene::RenderUI(float uiHeight)
+void Scene::MarkUIDirty(ObjectId id)
 {
-	// Sort UI elements by Layer (Ascending) so higher layers draw last (Painter's Algorithm)
-	// Since we disabled Depth Testing in Renderer2D, draw order is critical.
-	std::vector<PersistentUIElement*> sortedUI;
-	for (auto& [id, element] : m_UIElements)
+	auto it = m_UIElements.find(id);
+	if (it == m_UIElements.end())
+		return;
+
+	m_UILayers[it->second.Layer].Dirty = true;
+	m_UILayers[it->second.BakedLayer].Dirty = true;
+}
+
+void Scene::RenderUI(RenderSnapshot& snapshot, float uiHeight)
+{
+	// Screen-space placement follows the viewport, and everything follows the UI height
+	auto viewport = Input::GetInstance()->GetViewportRect();
+	glm::vec2 viewportSize = { viewport.z, viewport.w };
+	if (viewportSize != m_UIViewportSize || uiHeight != m_UIHeight)
 	{
-		if (element.IsVisible)
-			sortedUI.push_back(&element);
+		m_UIViewportSize = viewportSize;
+		m_UIHeight = uiHeight;
+		for (auto& [layer, ui]: m_UILayers)
+			ui.Dirty = true;
 	}
-	std::sort(sortedUI.begin(), sortedUI.end(), [](PersistentUIElement* a, PersistentUIElement* b) {
-		return a->Layer < b->Layer;
-	});
 
-	for (auto* elementPtr : sortedUI)
+	// Image UVs are baked against the sprite atlas too
+	if (m_UIAtlasGeneration != TextureAtlas::GetGeneration())
 	{
-		auto& element = *elementPtr;
+		m_UIAtlasGeneration = TextureAtlas::GetGeneration();
+		for (auto& [layer, ui]: m_UILayers)
+			ui.Dirty = true;
+	}
+
+	// Every layer's pages are touched before anything is rebuilt, so shaping a dirty layer can't evict a page a
+	// clean layer still samples. An evicted atlas page leaves the glyph UVs baked against it stale.
+	for (auto& [layer, ui]: m_UILayers)
+	{
+		for (const auto& [font, page]: ui.Pages)
+			font->TouchPage(page);
 
-		bool clipped = false;
-		if (element.ClipRect.z > 0.0f && element.ClipRect.w > 0.0f)
+		for (const auto& [font, generation]: ui.Generations)
 		{
-			Renderer::EnableScissor(element.ClipRect.x, element.ClipRect.y, element.ClipRect.z, element.ClipRect.w);
-			clipped = true;
+			if (font->GetAtlasGeneration() != generation)
+				ui.Dirty = true;
 		}
+	}
 
-		glm::vec2 position = element.Position;
-		glm::vec2 size = element.Scale;
+	RebuildUILayers(uiHeight);
 
-		if (element.UseScreenSpace)
-		{
-			position = ScreenSpaceToUISpace(element.Position.x, element.Position.y, uiHeight);
+	// Markers are per frame, but a minimap may be shown by several elements; cleared once everything is recorded
+	static std::vector<Minimap*> drawnMinimaps;
+	drawnMinimaps.clear();
 
-			if (!element.IsText)
-			{
-				auto viewport = Input::GetInstance()->GetViewportRect();
-				float vpH = viewport.w > 0 ? (float) viewport.w : 1080.0f;
-				float scaleFactor = uiHeight / vpH;
-				size = size * scaleFactor;
-			}
-		}
-
-		// Z is irrelevant now that Depth Test is disabled, but keep it 0.0f
-		glm::vec3 drawPos = glm::vec3(position.x, position.y, 0.0f);
+	// Layers draw in ascending order so higher layers land on top (Painter's Algorithm).
+	// Since we disabled Depth Testing in Renderer2D, draw order is critical.
+	for (auto& [layer, ui]: m_UILayers)
+	{
+		snapshot.DrawStaticBatch(ui.Batch);
 
-		if (element.IsText && element.Font)
+		for (ObjectId id: ui.LiveElements)
 		{
-			glm::vec3 textInfo = element.Font->CalculateSizeWithBaseline(element.TextContent, element.Scale.x, element.WrapWidth);
-			float textWidth = textInfo.x;
-			float textHeight = textInfo.y;
-			float maxY = textInfo.z;
-			float minY = textHeight - maxY;
+			PersistentUIElement& element = m_UIElements.at(id);
 
-			glm::vec3 finalPos = drawPos;
-			finalPos.x += (0.0f - element.Anchor.x) * textWidth;
+			bool clipped = false;
+			if (element.ClipRect.z > 0.0f && element.ClipRect.w > 0.0f)
+			{
+				snapshot.PushClipRect(element.ClipRect.x, element.ClipRect.y, element.ClipRect.z, element.ClipRect.w);
+				clipped = true;
+			}
 
-			float baselineForBottom = drawPos.y + minY;
-			float baselineForCenter = drawPos.y - (maxY - minY) * 0.5f;
-			float baselineForTop = drawPos.y - maxY;
+			glm::vec2 size;
+			glm::vec3 finalPos = PlaceUIElement(element, uiHeight, size);
 
-			if (element.Anchor.y <= 0.5f)
+			std::shared_ptr<Tilemap> minimapSource = element.MinimapSource.lock();
+			if (minimapSource && minimapSource->GetMinimap())
 			{
-				float t = element.Anchor.y * 2.0f;
-				finalPos.y = baselineForBottom * (1.0f - t) + baselineForCenter * t;
+				Minimap* minimap = minimapSource->GetMinimap();
+				minimap->Draw(snapshot, finalPos, size, element.Color);
+				if (std::find(drawnMinimaps.begin(), drawnMinimaps.end(), minimap) == drawnMinimaps.end())
+					drawnMinimaps.push_back(minimap);
+			}
+			else if (element.Image)
+			{
+				snapshot.DrawQuad(finalPos, { size.x, -size.y }, element.Image, 1.0f, element.Color);
 			}
 			else
 			{
-				float t = (element.Anchor.y - 0.5f) * 2.0f;
-				finalPos.y = baselineForCenter * (1.0f - t) + baselineForTop * t;
+				snapshot.DrawQuad(finalPos, size, element.Color);
 			}
 
-			Renderer::DrawString(element.TextContent, element.Font, finalPos, element.Scale.x, element.Color, element.WrapWidth);
+			// The tilemap is gone; bake the element like any other quad from the next frame
+			if (!minimapSource)
+				ui.Dirty = true;
+
+			if (clipped)
+			{
+				snapshot.PopClipRect();
+			}
+		}
+	}
+
+	for (Minimap* minimap: drawnMinimaps)
+		minimap->ClearMarkers();
+}
+
+void Scene::RebuildUILayers(float uiHeight)
+{
+	std::vector<ObjectId> members;
+	std::vector<Renderer::StaticItem> items;
+
+	for (auto it = m_UILayers.begin(); it != m_UILayers.end();)
+	{
+		UILayer& ui = it->second;
+		if (!ui.Dirty)
+		{
+			++it;
+			continue;
 		}
-		else if (!element.IsText)
+
+		// Creation order within a layer
+		members.clear();
+		for (auto& [id, element]: m_UIElements)
 		{
-			float offX = (0.5f - element.Anchor.x) * size.x;
-			float offY = (0.5f - element.Anchor.y) * size.y;
+			if (element.Layer == it->first)
+			{
+				element.BakedLayer = it->first;
+				if (element.IsVisible)
+					members.push_back(id);
+			}
+		}
+		std::sort(members.begin(), members.end());
 
-			glm::vec3 finalPos = drawPos;
-			finalPos.x += offX;
-			finalPos.y += offY;
+		items.clear();
+		ui.LiveElements.clear();
+		ui.Pages.clear();
+		ui.Generations.clear();
 
-			if (element.Image)
+		for (ObjectId id: members)
+		{
+			PersistentUIElement& element = m_UIElements[id];
+			if (element.IsText && !element.Font)
+				continue;
+
+			if (!element.IsText && !element.MinimapSource.expired())
+			{
+				ui.LiveElements.push_back(id);
+				continue;
+			}
+
+			glm::vec2 size;
+			glm::vec3 finalPos = PlaceUIElement(element, uiHeight, size);
+
+			Renderer::StaticItem& item = items.emplace_back();
+			item.Sprite.Color = element.Color;
+			item.ClipRect = element.ClipRect;
+
+			if (element.IsText)
 			{
-				Renderer::DrawQuad(finalPos, { size.x, -size.y }, element.Image, 1.0f, element.Color);
+				item.Text = &element.Layout;
+				item.TextPosition = finalPos;
+
+				Font* font = element.Font;
+				if (std::find_if(ui.Generations.begin(), ui.Generations.end(), [font](const auto& g) { return g.first == font; }) == ui.Generations.end())
+					ui.Generations.push_back({ font, font->GetAtlasGeneration() });
+
+				for (const auto& glyph: element.Layout.GetGlyphs())
+				{
+					std::pair<Font*, uint32_t> page = { font, glyph.Page };
+					if (std::find(ui.Pages.begin(), ui.Pages.end(), page) == ui.Pages.end())
+					{
+						font->TouchPage(glyph.Page);
+						ui.Pages.push_back(page);
+					}
+				}
 			}
 			else
 			{
-				Renderer::DrawQuad(finalPos, size, element.Color);
+				// Images are flipped vertically, as DrawQuad with a negative height does
+				glm::vec2 quadSize = element.Image ? glm::vec2(size.x, -size.y) : size;
+				item.Sprite.Transform = glm::translate(glm::mat4(1.0f), finalPos) * glm::scale(glm::mat4(1.0f), glm::vec3(quadSize, 1.0f));
+				item.Sprite.Texture = element.Image;
+
+				// Styling is given in the element's own units; screen-space ones are pixels
+				float unitScale = element.UseScreenSpace ? UIPixelSize(uiHeight) : 1.0f;
+				item.Sprite.Slice = element.Slice;
+				item.Sprite.SliceScale = UIPixelSize(uiHeight);
+				item.Sprite.CornerRadius = element.CornerRadius * unitScale;
+				item.Sprite.BorderWidth = element.BorderWidth * unitScale;
+				item.Sprite.BorderColor = element.BorderColor;
 			}
 		}
 
-		if (clipped)
+		if (items.empty() && ui.LiveElements.empty())
 		{
-			Renderer::DisableScissor();
+			it = m_UILayers.erase(it);
+			continue;
 		}
+
+		// A fresh batch: the frame in flight may still be drawing the old one
+		auto batch = std::make_shared<Renderer::StaticBatch>();
+		Renderer::BuildStaticBatch(items.data(), items.size(), *batch);
+		ui.Batch = std::move(batch);
+		ui.Dirty = false;
+		++it;
 	}
 }
 
@@ -369,7 +641,12 @@ void Scene::Update(float deltaTime)
 
 			if (body && !rb.IsKinematic)
 			{
-				transform.Position = body->GetPos();
+				glm::vec3 pos = body->GetPos();
+				if (pos != transform.Position)
+				{
+					transform.Position = pos;
+					m_DirtyTransforms.push_back(entity);
+				}
 				rb.Velocity = body->GetVelocity();
 			}
 		}
@@ -433,12 +710,370 @@ void Scene::SetGravity(glm::vec2 gravity)
 		m_PhysicsScene->setGravity(glm::vec3(gravity, 0.0f));
 }
 
-void Scene::Render(Camera& camera)
+void Scene::UpdateSpatialGrid()
+{
+	for (Entity entity: m_DirtyTransforms)
+	{
+		auto* transform = m_Registry.TryGetComponent<TransformComponent>(entity);
+		auto* sprite = m_Registry.TryGetComponent<SpriteComponent>(entity);
+		if (!transform || !sprite)
+		{
+			m_SpatialGrid.Remove(entity);
+			RemoveStaticMember(entity);
+			continue;
+		}
+
+		if (sprite->IsStatic && !IsAnimated(m_Registry.TryGetComponent<AnimationComponent>(entity)))
+		{
+			m_SpatialGrid.Remove(entity);
+			AssignStaticChunk(entity, transform->Position);
+			continue;
+		}
+
+		RemoveStaticMember(entity);
+
+		glm::vec2 bMin, bMax;
+		ComputeSpriteBounds(*transform, bMin, bMax);
+		m_SpatialGrid.Update(entity, bMin, bMax);
+	}
+	m_DirtyTransforms.clear();
+}
+
+void Scene::AssignStaticChunk(Entity entity, const glm::vec3& position)
+{
+	int32_t cx = (int32_t) std::floor(position.x / StaticChunkSize);
+	int32_t cy = (int32_t) std::floor(position.y / StaticChunkSize);
+	int64_t key = CellKey(cx, cy);
+
+	auto it = m_StaticChunkOf.find(entity);
+	if (it != m_StaticChunkOf.end())
+	{
+		if (it->second == key)
+		{
+			m_StaticChunks[key].Dirty = true;
+			return;
+		}
+		RemoveStaticMember(entity);
+	}
+
+	StaticChunk& chunk = m_StaticChunks[key];
+	chunk.Key = key;
+	chunk.Members.push_back(entity);
+	chunk.Dirty = true;
+	m_StaticChunkOf[entity] = key;
+	m_StaticSpriteCount++;
+}
+
+void Scene::RemoveStaticMember(Entity entity)
+{
+	auto it = m_StaticChunkOf.find(entity);
+	if (it == m_StaticChunkOf.end())
+		return;
+
+	auto chunkIt = m_StaticChunks.find(it->second);
+	if (chunkIt != m_StaticChunks.end())
+	{
+		auto& members = chunkIt->second.Members;
+		members.erase(std::remove(members.begin(), members.end(), entity), members.end());
+		chunkIt->second.Dirty = true;
+	}
+
+	m_StaticChunkOf.erase(it);
+	m_StaticSpriteCount--;
+}
+
+void Scene::RebuildStaticChunks()
 {
+	std::vector<Renderer::SpriteInstance> instances;
+
+	// A repacked atlas moves every sprite to a new page and UV rect
+	if (m_StaticAtlasGeneration != TextureAtlas::GetGeneration())
+	{
+		m_StaticAtlasGeneration = TextureAtlas::GetGeneration();
+		for (auto& kv: m_StaticChunks)
+			kv.second.Dirty = true;
+	}
+
+	bool rebuilt = false;
+	for (auto it = m_StaticChunks.begin(); it != m_StaticChunks.end();)
+	{
+		StaticChunk& chunk = it->second;
+		if (!chunk.Dirty)
+		{
+			++it;
+			continue;
+		}
+		rebuilt = true;
+
+		// Impostors under both the old and the new footprint go stale
+		if (chunk.Batch && chunk.Batch->QuadCount > 0)
+			MarkImpostorsDirty(chunk.BoundsMin, chunk.BoundsMax);
+
+		if (chunk.Members.empty())
+		{
+			it = m_StaticChunks.erase(it);
+			continue;
+		}
+
+		// Back-to-front inside the chunk, same ordering as the dynamic pass
+		std::sort(chunk.Members.begin(),
+		        chunk.Members.end(),
+		        [&](Entity a, Entity b) { return m_Registry.GetComponent<TransformComponent>(a).Position.z < m_Registry.GetComponent<TransformComponent>(b).Position.z; });
+
+		instances.clear();
+		chunk.BoundsMin = glm::vec2(std::numeric_limits<float>::max());
+		chunk.BoundsMax = glm::vec2(std::numeric_limits<float>::lowest());
+		chunk.MinZ = m_Registry.GetComponent<TransformComponent>(chunk.Members.front()).Position.z;
+
+		for (Entity entity: chunk.Members)
+		{
+			const auto& transform = m_Registry.GetComponent<TransformComponent>(entity);
+			const auto& sprite = m_Registry.GetComponent<SpriteComponent>(entity);
+			if (!sprite.IsVisible)
+				continue;
+
+			glm::vec2 bMin, bMax;
+			ComputeSpriteBounds(transform, bMin, bMax);
+			chunk.BoundsMin = glm::min(chunk.BoundsMin, bMin);
+			chunk.BoundsMax = glm::max(chunk.BoundsMax, bMax);
+
+			FillSpriteInstance(transform, sprite, m_Registry.TryGetComponent<AnimationComponent>(entity), instances.emplace_back());
+		}
+
+		auto batch = std::make_shared<Renderer::StaticBatch>();
+		Renderer::BuildStaticBatch(instances.data(), instances.size(), *batch);
+		chunk.Batch = std::move(batch);
+		if (chunk.Batch->QuadCount > 0)
+			MarkImpostorsDirty(chunk.BoundsMin, chunk.BoundsMax);
+		chunk.Dirty = false;
+		++it;
+	}
+
+	// Recomputed rather than grown, so impostor cells behind removed sprites can be evicted
+	if (rebuilt)
+	{
+		m_ImpostorCellMin = glm::ivec2(std::numeric_limits<int32_t>::max());
+		m_ImpostorCellMax = glm::ivec2(std::numeric_limits<int32_t>::min());
+		for (const auto& kv: m_StaticChunks)
+		{
+			const StaticChunk& chunk = kv.second;
+			if (!chunk.Batch || chunk.Batch->QuadCount == 0)
+				continue;
+			m_ImpostorCellMin = glm::min(m_ImpostorCellMin, glm::ivec2(glm::floor(chunk.BoundsMin / ImpostorCellSize)));
+			m_ImpostorCellMax = glm::max(m_ImpostorCellMax, glm::ivec2(glm::floor(chunk.BoundsMax / ImpostorCellSize)));
+		}
+	}
+}
+
+void Scene::CollectStaticChunks(const glm::vec2& viewMin, const glm::vec2& viewMax, std::vector<const StaticChunk*>& outChunks) const
+{
+	outChunks.clear();
+	for (const auto& kv: m_StaticChunks)
+	{
+		const StaticChunk& chunk = kv.second;
+		if (chunk.BoundsMax.x < viewMin.x || chunk.BoundsMin.x > viewMax.x || chunk.BoundsMax.y < viewMin.y || chunk.BoundsMin.y > viewMax.y)
+			continue;
+		outChunks.push_back(&chunk);
+	}
+
+	// Chunks blend without a depth test, and the map iterates in hash order; back-to-front by their
+	// lowest Z keeps overlaps at chunk borders in the same order every frame
+	std::sort(outChunks.begin(),
+	        outChunks.end(),
+	        [](const StaticChunk* a, const StaticChunk* b)
+	        {
+		        if (a->MinZ != b->MinZ)
+			        return a->MinZ < b->MinZ;
+		        return a->Key < b->Key;
+	        });
+}
+
+void Scene::SetImpostorThreshold(float pixelsPerUnit)
+{
+	// Impostors get as many texels per unit as the threshold allows pixels, so switching to them loses no detail
+	uint32_t resolution = (uint32_t) std::clamp(std::ceil(ImpostorCellSize * pixelsPerUnit), 32.0f, 1024.0f);
+	if (resolution != m_ImpostorResolution)
+	{
+		for (auto& kv: m_ImpostorCells)
+			kv.second.Image.reset();
+		m_ImpostorResolution = resolution;
+	}
+
+	// Turning impostors off releases every baked texture
+	if (pixelsPerUnit <= 0.0f)
+		m_ImpostorCells.clear();
+	m_ImpostorThreshold = pixelsPerUnit;
+}
+
+void Scene::MarkImpostorsDirty(const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+{
+	if (boundsMin.x > boundsMax.x || boundsMin.y > boundsMax.y)
+		return;
+
+	glm::ivec2 c0 = glm::ivec2(glm::floor(boundsMin / ImpostorCellSize));
+	glm::ivec2 c1 = glm::ivec2(glm::floor(boundsMax / ImpostorCellSize));
+	for (int32_t cy = c0.y; cy <= c1.y; ++cy)
+	{
+		for (int32_t cx = c0.x; cx <= c1.x; ++cx)
+			m_ImpostorCells[CellKey(cx, cy)].Dirty = true;
+	}
+}
+
+bool Scene::RenderImpostors(RenderSnapshot& snapshot, const glm::vec2& viewMin, const glm::vec2& viewMax)
+{
+	// Cells worth visiting: those holding static sprites plus every cell under a tilemap
+	glm::ivec2 contentMin = m_ImpostorCellMin;
+	glm::ivec2 contentMax = m_ImpostorCellMax;
+
+	s_ImpostorSources.clear();
+	for (Entity entity: m_Registry.View<TilemapComponent>())
+	{
+		const auto& tilemap = m_Registry.GetComponent<TilemapComponent>(entity);
+		const auto* transform = m_Registry.TryGetComponent<TransformComponent>(entity);
+		if (!tilemap.Map || !tilemap.IsVisible || !transform)
+			continue;
+
+		glm::vec2 size = glm::vec2((float) tilemap.Map->GetWidth(), (float) tilemap.Map->GetHeight()) * tilemap.Map->GetTileSize();
+		const ImpostorSource& source = s_ImpostorSources.emplace_back(ImpostorSource { tilemap.Map, transform->Position, glm::vec2(transform->Position) + size });
+
+		contentMin = glm::min(contentMin, glm::ivec2(glm::floor(glm::vec2(source.Origin) / ImpostorCellSize)));
+		contentMax = glm::max(contentMax, glm::ivec2(glm::floor(source.Max / ImpostorCellSize)));
+	}
+
+	// Cells outside the content hold nothing any more; drop them and their textures
+	if (contentMin != m_ImpostorSweepMin || contentMax != m_ImpostorSweepMax)
+	{
+		m_ImpostorSweepMin = contentMin;
+		m_ImpostorSweepMax = contentMax;
+		for (auto it = m_ImpostorCells.begin(); it != m_ImpostorCells.end();)
+		{
+			int32_t cx = (int32_t) (it->first >> 32);
+			int32_t cy = (int32_t) (uint32_t) it->first;
+			if (cx < contentMin.x || cx > contentMax.x || cy < contentMin.y || cy > contentMax.y)
+				it = m_ImpostorCells.erase(it);
+			else
+				++it;
+		}
+	}
+
+	int32_t cx0 = std::max(contentMin.x, (int32_t) std::floor(viewMin.x / ImpostorCellSize));
+	int32_t cy0 = std::max(contentMin.y, (int32_t) std::floor(viewMin.y / ImpostorCellSize));
+	int32_t cx1 = std::min(contentMax.x, (int32_t) std::floor(viewMax.x / ImpostorCellSize));
+	int32_t cy1 = std::min(contentMax.y, (int32_t) std::floor(viewMax.y / ImpostorCellSize));
+
+	uint32_t bakes = 0;
+	bool complete = true;
+	s_ImpostorDraws.clear();
+	for (int32_t cy = cy0; cy <= cy1; ++cy)
+	{
+		for (int32_t cx = cx0; cx <= cx1; ++cx)
+		{
+			glm::vec2 cellMin = glm::vec2((float) cx, (float) cy) * ImpostorCellSize;
+			glm::vec2 cellMax = cellMin + ImpostorCellSize;
+
+			// Tile edits are picked up through the chunk revisions under the cell
+			uint64_t tileRevision = 0;
+			bool hasTiles = false;
+			for (const ImpostorSource& source: s_ImpostorSources)
+			{
+				if (source.Max.x <= cellMin.x || source.Origin.x >= cellMax.x || source.Max.y <= cellMin.y || source.Origin.y >= cellMax.y)
+					continue;
+
+				float tileSize = source.Map->GetTileSize();
+				glm::vec2 t0 = glm::max((cellMin - glm::vec2(source.Origin)) / tileSize, 0.0f);
+				glm::vec2 t1 = (cellMax - glm::vec2(source.Origin)) / tileSize;
+				tileRevision += source.Map->GetRegionRevision((uint32_t) t0.x, (uint32_t) t0.y, (uint32_t) t1.x, (uint32_t) t1.y);
+				hasTiles = true;
+			}
+
+			auto it = m_ImpostorCells.find(CellKey(cx, cy));
+			if (it == m_ImpostorCells.end())
+			{
+				if (!hasTiles)
+					continue;
+				it = m_ImpostorCells.emplace(CellKey(cx, cy), ImpostorCell()).first;
+			}
+
+			// First bakes share the per-frame budget with re-bakes; stale cells show their old image until their turn
+			ImpostorCell& cell = it->second;
+			bool stale = !cell.Image || cell.Dirty || cell.TileRevision != tileRevision;
+			if (stale && bakes < MaxImpostorBakesPerFrame)
+			{
+				BakeImpostor(snapshot, cx, cy, cell);
+				cell.TileRevision = tileRevision;
+				bakes++;
+			}
+
+			if (!cell.Image)
+			{
+				complete = false;
+				continue;
+			}
+
+			s_ImpostorDraws.emplace_back(cellMin + ImpostorCellSize * 0.5f, cell.Image.get());
+		}
+	}
+
+	// Mixing live chunks with impostors would overlap at chunk edges, so the caller draws the view live until
+	// every visible cell has an image
+	if (!complete)
+		return false;
+
+	// Every cell is one quad in the ordinary batch, so the ground costs a handful of draws at any zoom
+	for (const auto& draw: s_ImpostorDraws)
+		snapshot.DrawQuad(glm::vec3(draw.first, 0.0f), glm::vec2(ImpostorCellSize), draw.second);
+	return true;
+}
+
+void Scene::BakeImpostor(RenderSnapshot& snapshot, int32_t cx, int32_t cy, ImpostorCell& cell)
+{
+	if (!cell.Image)
+		cell.Image = std::make_unique<Texture>(m_ImpostorResolution, m_ImpostorResolution, TEX_FORMAT_RGBA8_UNORM, Texture::Filter::Linear, Texture::Wrap::ClampToEdge, true);
+
+	glm::vec2 cellMin = glm::vec2((float) cx, (float) cy) * ImpostorCellSize;
+	glm::vec2 cellMax = cellMin + ImpostorCellSize;
+
+	// Bottom and top are swapped so texel row 0 holds the bottom of the cell, where DrawQuad samples v = 0.
+	// The bake is recorded like any other draw and runs ahead of the quads that show it.
+	snapshot.BeginRenderToTexture(cell.Image.get(), glm::orthoLH_ZO(cellMin.x, cellMax.x, cellMax.y, cellMin.y, -100.0f, 100.0f));
+
+	for (const ImpostorSource& source: s_ImpostorSources)
+		snapshot.DrawTilemap(source.Map, source.Origin, cellMin, cellMax);
+
+	static std::vector<const StaticChunk*> chunks;
+	CollectStaticChunks(cellMin, cellMax, chunks);
+	for (const StaticChunk* chunk: chunks)
+		snapshot.DrawStaticBatch(chunk->Batch);
+
+	snapshot.EndRenderToTexture();
+	cell.Dirty = false;
+}
+
+void Scene::Render(Camera& camera, RenderSnapshot& snapshot)
+{
+	// Bring the culling grid and static chunks up to date with everything that changed since last frame
+	UpdateSpatialGrid();
+	RebuildStaticChunks();
+
+	// Camera view rectangle in world space (unproject the NDC corners)
+	glm::mat4 invViewProj = glm::inverse(camera.GetViewProjectionMatrix());
+	glm::vec2 viewMin(std::numeric_limits<float>::max());
+	glm::vec2 viewMax(std::numeric_limits<float>::lowest());
+	for (const glm::vec2& ndc: { glm::vec2(-1.0f, -1.0f), glm::vec2(1.0f, -1.0f), glm::vec2(1.0f, 1.0f), glm::vec2(-1.0f, 1.0f) })
+	{
+		glm::vec4 p = invViewProj * glm::vec4(ndc, 0.0f, 1.0f);
+		glm::vec2 world = glm::vec2(p) / p.w;
+		viewMin = glm::min(viewMin, world);
+		viewMax = glm::max(viewMax, world);
+	}
+
+	static std::vector<Entity> sortedEntities;
+	sortedEntities.clear();
+	m_SpatialGrid.Query(viewMin, viewMax, sortedEntities);
+
 	// Sort entities by Z-order (Back-to-Front) to handle transparency correctly
 	// In our LH_ZO projection (Near=10, Far=-10), smaller Z is "farther" (Depth 1)
 	// So we sort Ascending: -10 (Far) -> 10 (Near)
-	std::vector<Entity> sortedEntities = m_ActiveEntities;
 	std::sort(sortedEntities.begin(),
 	        sortedEntities.end(),
 	        [&](Entity a, Entity b)
@@ -452,7 +1087,39 @@ void Scene::Render(Camera& camera)
 		        return zA < zB;
 	        });
 
-	Renderer::BeginScene(camera);
+	snapshot.BeginScene(camera.GetViewProjectionMatrix());
+
+	// Zoomed out until an impostor has at least as many texels as its cell covers pixels
+	float pixelsPerUnit = 0.0f;
+	if (ISwapChain* swapChain = Window::GetSwapChain())
+		pixelsPerUnit = (float) swapChain->GetDesc().Width / std::max(viewMax.x - viewMin.x, 0.001f);
+	bool useImpostors = m_ImpostorThreshold > 0.0f && pixelsPerUnit > 0.0f && pixelsPerUnit <= m_ImpostorThreshold;
+
+	uint32_t staticVisible = 0;
+	if (!useImpostors || !RenderImpostors(snapshot, viewMin, viewMax))
+	{
+		// Tilemaps are the ground layer: one quad per visible chunk
+		for (Entity entity: m_Registry.View<TilemapComponent>())
+		{
+			const auto& tilemap = m_Registry.GetComponent<TilemapComponent>(entity);
+			const auto* transform = m_Registry.TryGetComponent<TransformComponent>(entity);
+			if (!tilemap.Map || !tilemap.IsVisible || !transform)
+				continue;
+
+			snapshot.DrawTilemap(tilemap.Map, transform->Position, viewMin, viewMax);
+		}
+
+		// Static chunks next: they are baked, so this is one draw per chunk per texture set
+		static std::vector<const StaticChunk*> chunks;
+		CollectStaticChunks(viewMin, viewMax, chunks);
+		for (const StaticChunk* chunk: chunks)
+		{
+			snapshot.DrawStaticBatch(chunk->Batch);
+			staticVisible += chunk->Batch ? chunk->Batch->QuadCount : 0;
+		}
+	}
+
+	snapshot.RecordCulling((uint32_t) sortedEntities.size() + staticVisible, (uint32_t) m_SpatialGrid.GetEntityCount() + m_StaticSpriteCount);
 
 	static int frameCount = 0;
 	frameCount++;
@@ -488,6 +1155,7 @@ void Scene::Render(Camera& camera)
 	}
 
 	int failures = 0;
+	s_RenderItems.clear();
 	for (Entity entity: sortedEntities)
 	{
 		countTotal++;
@@ -522,55 +1190,27 @@ void Scene::Render(Camera& camera)
 		countVisible++;
 		countDraw++;
 
-		glm::mat4 transformMat = transform.GetTransform();
-
-			if (sprite.Texture)
-			{
-				bool hasAnim = false;
-				if (m_Registry.HasComponent<AnimationComponent>(entity))
-				{
-					auto& anim = m_Registry.GetComponent<AnimationComponent>(entity);
-					if (anim.SpriteWidth > 0)
-					{
-						hasAnim = true;
-						int texWidth = sprite.Texture->GetWidth();
-						int framesPerRow = texWidth / anim.SpriteWidth;
-						if (framesPerRow == 0)
-							framesPerRow = 1;
-						int column = anim.Frame % framesPerRow;
-
-						float u0 = (float) (column * anim.SpriteWidth) / texWidth;
-						float v0 = 0.0f;
-						float u1 = (float) ((column + 1) * anim.SpriteWidth) / texWidth;
-						float v1 = 1.0f;
-
-						glm::vec2 uvs[4] = {
-							{ u0, v0 }, // BL
-							{ u1, v0 }, // BR
-							{ u1, v1 }, // TR
-							{ u0, v1 }  // TL
-						};
-
-						Renderer::DrawQuadUV(transformMat, sprite.Texture, uvs, sprite.Color);
-					}
-				}
-
-				if (!hasAnim)
-				{
-					// Logger::Info("Drawing Entity " + std::to_string(entity));
-					Renderer::DrawQuad(transformMat, sprite.Texture, sprite.TilingFactor, sprite.Color);
-				}
-			}
-			else
-			{
-				Renderer::DrawQuad(transformMat, sprite.Color);
-			}
+		s_RenderItems.push_back({ &transform, &sprite, m_Registry.TryGetComponent<AnimationComponent>(entity) });
 	}
 
+	// Build sprite instances in parallel, straight into the snapshot. They are in painter order, so opaque ones can
+	// go through the depth-tested front-to-back pass.
+	Renderer::SpriteInstance* renderList = snapshot.AddLayeredSprites(s_RenderItems.size());
+	JobSystem::ParallelFor(s_RenderItems.size(),
+	        256,
+	        [renderList](size_t begin, size_t end)
+	        {
+		        for (size_t i = begin; i < end; ++i)
+		        {
+			        const RenderItem& item = s_RenderItems[i];
+			        FillSpriteInstance(*item.Transform, *item.Sprite, item.Animation, renderList[i]);
+		        }
+	        });
+
 	for (auto ps: m_ParticleSystems)
-		ps->OnRender();
+		ps->OnRender(snapshot);
 
-	Renderer::EndScene();
+	snapshot.EndScene();
 
 	if (doLog)
 	{
@@ -582,5 +1222,6 @@ void Scene::Render(Camera& camera)
 
 		auto stats = Renderer::GetStats();
 		Logger::Info("  Renderer Stats - Quads: " + std::to_string(stats.QuadCount) + " DrawCalls: " + std::to_string(stats.DrawCalls));
+		Logger::Info("  Culling - Visible: " + std::to_string(stats.VisibleCount) + " / " + std::to_string(stats.TotalCount));
 	}
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <limits>
+#include <map>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -7,9 +10,14 @@
 #include "Core/Camera.h"
 #include "Physics/PhysicsScene.h"
 #include "Registry.h"
+#include "SpatialGrid.h"
 #include "Rendering/Font.h"
+#include "Rendering/Renderer.h"
+#include "Rendering/TextLayout.h"
 
 class ParticleSystem;
+class RenderSnapshot;
+class Tilemap;
 
 // Stable handle type for scripting/interop
 using ObjectId = Entity;
@@ -30,10 +38,24 @@ struct PersistentUIElement
 	float WrapWidth = 0.0f;
     glm::vec4 ClipRect = { 0.0f, 0.0f, 0.0f, 0.0f }; // x,y,w,h. If w<=0 or h<=0, no clip.
 
+	// Panel styling for images. Slice is the nine-slice border in texels (left, top, right, bottom), drawn one
+	// screen pixel per texel. CornerRadius and BorderWidth are in the same units as Scale.
+	glm::vec4 Slice = { 0.0f, 0.0f, 0.0f, 0.0f };
+	float CornerRadius = 0.0f;
+	float BorderWidth = 0.0f;
+	glm::vec4 BorderColor = { 0.0f, 0.0f, 0.0f, 1.0f };
+
 	// Content
 	std::string TextContent;
 	Font* Font = nullptr;     // Pointer to SDF Atlas
 	Texture* Image = nullptr; // Pointer to standard Texture
+	std::weak_ptr<Tilemap> MinimapSource; // Draws this tilemap's minimap and markers instead of Image
+
+	// Shaped text, rebuilt only when TextContent, Font, Scale.x or WrapWidth change
+	TextLayout Layout;
+
+	// Layer whose retained geometry holds this element, so a layer change rebuilds both
+	int BakedLayer = 0;
 };
 
 class Scene
@@ -58,14 +80,26 @@ public:
 		return m_Registry;
 	}
 
+	// Flags an entity whose transform or sprite changed so the culling grid picks it up before the next Render.
+	void MarkTransformDirty(Entity entity)
+	{
+		m_DirtyTransforms.push_back(entity);
+	}
+
 	// --- UI Management ---
 	ObjectId CreateUIElement(bool isText);
 	PersistentUIElement* GetUIElement(ObjectId id);
-	void RenderUI(float uiHeight = 18.0f);
+
+	// Call after changing anything RenderUI draws from an element; its layer is rebuilt on the next RenderUI
+	void MarkUIDirty(ObjectId id);
+
+	void RenderUI(RenderSnapshot& snapshot, float uiHeight = 18.0f);
 
 	// --- Core Loop ---
 	void Update(float deltaTime);
-	void Render(Camera& camera);
+
+	// Records the visible world into 'snapshot'; nothing here touches the device context
+	void Render(Camera& camera, RenderSnapshot& snapshot);
 
 	Entity GetPrimaryCameraEntity();
 
@@ -74,6 +108,11 @@ public:
 
 	void SetGravity(glm::vec2 gravity);
 
+	// At this many screen pixels per world unit or fewer, tilemaps and static sprites are drawn from
+	// per-cell impostor textures instead. 0 (the default) turns impostors off. Only tilemaps and IsStatic
+	// sprites are baked; every dynamic sprite (actors, and structures not flagged static) still draws live.
+	void SetImpostorThreshold(float pixelsPerUnit);
+
 	// --- Stats ---
 	int GetObjectCount() const
 	{
@@ -92,6 +131,75 @@ private:
 	ObjectId m_NextUIId = 100000; // Start UI IDs high to avoid collision with Entity IDs for now
 	std::unordered_map<ObjectId, PersistentUIElement> m_UIElements;
 
+	// Retained UI: each layer's quads and glyphs baked into one static batch, rebuilt only when an element in it
+	// changes. Minimaps redraw their markers every frame so they stay live, drawn after the layer's batch.
+	struct UILayer
+	{
+		Renderer::StaticBatchHandle Batch;
+		std::vector<ObjectId> LiveElements;
+		std::vector<std::pair<Font*, uint32_t>> Pages;       // Atlas pages the batch samples, kept warm for the LRU
+		std::vector<std::pair<Font*, uint32_t>> Generations; // Atlas generation each font was baked against
+		bool Dirty = true;
+	};
+
+	void RebuildUILayers(float uiHeight);
+
+	std::map<int, UILayer> m_UILayers; // Drawn in ascending layer order
+	glm::vec2 m_UIViewportSize = { 0.0f, 0.0f };
+	float m_UIHeight = 0.0f;
+	uint32_t m_UIAtlasGeneration = 0; // TextureAtlas::GetGeneration() the layers were baked against
+
 	std::vector<ParticleSystem*> m_ParticleSystems;
 	PhysicsScene* m_PhysicsScene = nullptr;
+
+	// Camera culling
+	void UpdateSpatialGrid();
+	SpatialGrid m_SpatialGrid;
+	std::vector<Entity> m_DirtyTransforms;
+
+	// Static geometry: IsStatic sprites are baked per world chunk and only rebuilt when a member changes
+	struct StaticChunk
+	{
+		std::vector<Entity> Members; // Sorted back-to-front on rebuild
+		Renderer::StaticBatchHandle Batch;
+		glm::vec2 BoundsMin = { 0.0f, 0.0f };
+		glm::vec2 BoundsMax = { 0.0f, 0.0f };
+		float MinZ = 0.0f;
+		int64_t Key = 0;
+		bool Dirty = true;
+	};
+
+	void AssignStaticChunk(Entity entity, const glm::vec3& position);
+	void RemoveStaticMember(Entity entity);
+	void RebuildStaticChunks();
+
+	// Chunks overlapping the rectangle, in draw order
+	void CollectStaticChunks(const glm::vec2& viewMin, const glm::vec2& viewMax, std::vector<const StaticChunk*>& outChunks) const;
+
+	std::unordered_map<int64_t, StaticChunk> m_StaticChunks;
+	std::unordered_map<Entity, int64_t> m_StaticChunkOf;
+	uint32_t m_StaticSpriteCount = 0;
+	uint32_t m_StaticAtlasGeneration = 0;
+
+	// Zoomed-out ground: tilemaps and static chunks baked per world cell into a small mipmapped texture,
+	// re-baked only when a tile or static sprite inside the cell changed
+	struct ImpostorCell
+	{
+		std::unique_ptr<Texture> Image;
+		uint64_t TileRevision = 0;
+		bool Dirty = true;
+	};
+
+	void MarkImpostorsDirty(const glm::vec2& boundsMin, const glm::vec2& boundsMax);
+	// False, with nothing drawn, while a visible cell has not been baked yet; the caller then draws the view live
+	bool RenderImpostors(RenderSnapshot& snapshot, const glm::vec2& viewMin, const glm::vec2& viewMax);
+	void BakeImpostor(RenderSnapshot& snapshot, int32_t cx, int32_t cy, ImpostorCell& cell);
+
+	std::unordered_map<int64_t, ImpostorCell> m_ImpostorCells;
+	glm::ivec2 m_ImpostorCellMin = glm::ivec2(std::numeric_limits<int32_t>::max()); // Cells holding static sprites
+	glm::ivec2 m_ImpostorCellMax = glm::ivec2(std::numeric_limits<int32_t>::min());
+	glm::ivec2 m_ImpostorSweepMin = glm::ivec2(0); // Content bounds cells were last evicted against
+	glm::ivec2 m_ImpostorSweepMax = glm::ivec2(-1);
+	float m_ImpostorThreshold = 0.0f;
+	uint32_t m_ImpostorResolution = 128; // Texels per cell side, matching the threshold's pixels per unit
 };
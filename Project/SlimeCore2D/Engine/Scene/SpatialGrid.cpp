@@ -0,0 +1,127 @@
+#include "SpatialGrid.h"
+
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float cellSize)
+      : m_CellSize(cellSize), m_InvCellSize(1.0f / cellSize)
+{
+}
+
+int32_t SpatialGrid::CellCoord(float v) const
+{
+	return (int32_t) std::floor(v * m_InvCellSize);
+}
+
+void SpatialGrid::Update(Entity entity, const glm::vec2& boundsMin, const glm::vec2& boundsMax)
+{
+	glm::vec2 center = (boundsMin + boundsMax) * 0.5f;
+	glm::vec2 halfExtent = (boundsMax - boundsMin) * 0.5f;
+	bool large = halfExtent.x > m_CellSize || halfExtent.y > m_CellSize;
+
+	int64_t cell = large ? 0 : CellKey(CellCoord(center.x), CellCoord(center.y));
+
+	auto it = m_Entries.find(entity);
+	if (it != m_Entries.end())
+	{
+		// Same cell, only the bounds change
+		if (it->second.Large == large && it->second.Cell == cell)
+		{
+			Item& item = large ? m_Large[it->second.Index] : m_Cells[cell][it->second.Index];
+			item.Min = boundsMin;
+			item.Max = boundsMax;
+			return;
+		}
+		Remove(entity);
+	}
+
+	auto& list = large ? m_Large : m_Cells[cell];
+	m_Entries[entity] = { cell, (uint32_t) list.size(), large };
+	list.push_back({ entity, boundsMin, boundsMax });
+}
+
+void SpatialGrid::Remove(Entity entity)
+{
+	auto it = m_Entries.find(entity);
+	if (it == m_Entries.end())
+		return;
+
+	// Swap-remove, patching the index of the entity that moved into the hole
+	auto swapRemove = [&](std::vector<Item>& list, uint32_t index)
+	{
+		list[index] = list.back();
+		m_Entries[list[index].Id].Index = index;
+		list.pop_back();
+	};
+
+	if (it->second.Large)
+	{
+		swapRemove(m_Large, it->second.Index);
+	}
+	else
+	{
+		auto cellIt = m_Cells.find(it->second.Cell);
+		if (cellIt != m_Cells.end())
+		{
+			swapRemove(cellIt->second, it->second.Index);
+			if (cellIt->second.empty())
+				m_Cells.erase(cellIt);
+		}
+	}
+
+	m_Entries.erase(entity);
+}
+
+void SpatialGrid::Clear()
+{
+	m_Cells.clear();
+	m_Entries.clear();
+	m_Large.clear();
+}
+
+void SpatialGrid::Collect(const std::vector<Item>& items, const glm::vec2& rectMin, const glm::vec2& rectMax, std::vector<Entity>& outEntities)
+{
+	for (const Item& item: items)
+	{
+		if (item.Max.x < rectMin.x || item.Min.x > rectMax.x || item.Max.y < rectMin.y || item.Min.y > rectMax.y)
+			continue;
+		outEntities.push_back(item.Id);
+	}
+}
+
+void SpatialGrid::Query(const glm::vec2& rectMin, const glm::vec2& rectMax, std::vector<Entity>& outEntities) const
+{
+	auto collect = [&](const std::vector<Item>& items) { Collect(items, rectMin, rectMax, outEntities); };
+
+	collect(m_Large);
+
+	// Widen by the largest half-extent a cell member can have, so anything centred just outside the rect is still considered
+	int32_t x0 = CellCoord(rectMin.x - m_CellSize);
+	int32_t y0 = CellCoord(rectMin.y - m_CellSize);
+	int32_t x1 = CellCoord(rectMax.x + m_CellSize);
+	int32_t y1 = CellCoord(rectMax.y + m_CellSize);
+
+	// A huge view (zoomed far out) visits more empty keys than there are cells; walk the cells instead
+	int64_t span = (int64_t) (x1 - x0 + 1) * (int64_t) (y1 - y0 + 1);
+	if (span > (int64_t) m_Cells.size())
+	{
+		for (const auto& kv: m_Cells)
+		{
+			int32_t cx = (int32_t) (kv.first >> 32);
+			int32_t cy = (int32_t) (uint32_t) kv.first;
+			if (cx < x0 || cx > x1 || cy < y0 || cy > y1)
+				continue;
+			collect(kv.second);
+		}
+		return;
+	}
+
+	for (int32_t y = y0; y <= y1; ++y)
+	{
+		for (int32_t x = x0; x <= x1; ++x)
+		{
+			auto it = m_Cells.find(CellKey(x, y));
+			if (it != m_Cells.end())
+				collect(it->second);
+		}
+	}
+}
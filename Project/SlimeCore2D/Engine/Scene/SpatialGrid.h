@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm.hpp>
+#include "Registry.h"
+
+// Loose uniform grid over sprite bounds, used for camera culling.
+// Each entity lives in exactly one cell (the one containing its bounds centre); queries are
+// widened by one cell, so a cell never needs to know its neighbours. Entities more than a cell
+// across would need a wider margin for every query, so they sit in a separate list tested directly.
+class SpatialGrid
+{
+public:
+	explicit SpatialGrid(float cellSize = 8.0f);
+
+	// Inserts the entity or moves it to the cell for its new bounds.
+	void Update(Entity entity, const glm::vec2& boundsMin, const glm::vec2& boundsMax);
+	void Remove(Entity entity);
+	void Clear();
+
+	// Appends every entity whose bounds overlap the given rectangle.
+	void Query(const glm::vec2& rectMin, const glm::vec2& rectMax, std::vector<Entity>& outEntities) const;
+
+	size_t GetEntityCount() const
+	{
+		return m_Entries.size();
+	}
+
+private:
+	struct Item
+	{
+		Entity Id;
+		glm::vec2 Min;
+		glm::vec2 Max;
+	};
+
+	struct Entry
+	{
+		int64_t Cell;
+		uint32_t Index; // Position inside the cell's item list, or m_Large when Large is set
+		bool Large;
+	};
+
+	int64_t CellKey(int32_t x, int32_t y) const
+	{
+		return ((int64_t) x << 32) | (uint32_t) y;
+	}
+
+	int32_t CellCoord(float v) const;
+	static void Collect(const std::vector<Item>& items, const glm::vec2& rectMin, const glm::vec2& rectMax, std::vector<Entity>& outEntities);
+
+	float m_CellSize;
+	float m_InvCellSize;
+
+	std::unordered_map<int64_t, std::vector<Item>> m_Cells;
+	std::vector<Item> m_Large;
+	std::unordered_map<Entity, Entry> m_Entries;
+};
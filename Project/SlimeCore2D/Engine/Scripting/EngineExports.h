@@ -15,10 +15,12 @@ using EntityId = std::uint64_t;
 // =================================================================================
 
 #include "Scripting/ExportCore.h"
+#include "Scripting/ExportDebug.h"
 #include "Scripting/ExportEntity.h"
 #include "Scripting/ExportInput.h"
 #include "Scripting/ExportParticles.h"
 #include "Scripting/ExportResource.h"
 #include "Scripting/ExportScene.h"
+#include "Scripting/ExportTilemap.h"
 #include "Scripting/ExportText.h"
 #include "Scripting/ExportUI.h"
@@ -0,0 +1,89 @@
+#include "ExportDebug.h"
+
+#include "Rendering/DebugDraw.h"
+
+SLIME_EXPORT void __cdecl DebugDraw_Line(float x0, float y0, float x1, float y1, float r, float g, float b, float a, float duration)
+{
+	DebugDraw::Line({ x0, y0 }, { x1, y1 }, { r, g, b, a }, duration);
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_Arrow(float x0, float y0, float x1, float y1, float headSize, float r, float g, float b, float a, float duration)
+{
+	DebugDraw::Arrow({ x0, y0 }, { x1, y1 }, { r, g, b, a }, headSize, duration);
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_Text(float x, float y, const char* text, float height, float r, float g, float b, float a, float duration)
+{
+	if (!text)
+		return;
+	DebugDraw::Text({ x, y }, text, { r, g, b, a }, height, duration);
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_Lines(const DebugLine_Interop* lines, int count, float duration)
+{
+	if (!lines || !DebugDraw::IsEnabled())
+		return;
+
+	for (int i = 0; i < count; i++)
+	{
+		const DebugLine_Interop& l = lines[i];
+		DebugDraw::Line({ l.FromX, l.FromY }, { l.ToX, l.ToY }, { l.R, l.G, l.B, l.A }, duration);
+	}
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_Arrows(const DebugLine_Interop* arrows, int count, float headSize, float duration)
+{
+	if (!arrows || !DebugDraw::IsEnabled())
+		return;
+
+	for (int i = 0; i < count; i++)
+	{
+		const DebugLine_Interop& l = arrows[i];
+		DebugDraw::Arrow({ l.FromX, l.FromY }, { l.ToX, l.ToY }, { l.R, l.G, l.B, l.A }, headSize, duration);
+	}
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_Rects(const DebugRect_Interop* rects, int count, bool filled, float duration)
+{
+	if (!rects || !DebugDraw::IsEnabled())
+		return;
+
+	for (int i = 0; i < count; i++)
+	{
+		const DebugRect_Interop& q = rects[i];
+		if (filled)
+			DebugDraw::FilledRect({ q.X, q.Y }, { q.W, q.H }, { q.R, q.G, q.B, q.A }, duration);
+		else
+			DebugDraw::Rect({ q.X, q.Y }, { q.W, q.H }, { q.R, q.G, q.B, q.A }, duration);
+	}
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_Circles(const DebugCircle_Interop* circles, int count, bool filled, float duration)
+{
+	if (!circles || !DebugDraw::IsEnabled())
+		return;
+
+	for (int i = 0; i < count; i++)
+	{
+		const DebugCircle_Interop& c = circles[i];
+		if (filled)
+			DebugDraw::FilledCircle({ c.X, c.Y }, c.Radius, { c.R, c.G, c.B, c.A }, duration);
+		else
+			DebugDraw::Circle({ c.X, c.Y }, c.Radius, { c.R, c.G, c.B, c.A }, duration);
+	}
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_Clear()
+{
+	DebugDraw::Clear();
+}
+
+SLIME_EXPORT void __cdecl DebugDraw_SetEnabled(bool enabled)
+{
+	DebugDraw::SetEnabled(enabled);
+}
+
+SLIME_EXPORT bool __cdecl DebugDraw_IsEnabled()
+{
+	return DebugDraw::IsEnabled();
+}
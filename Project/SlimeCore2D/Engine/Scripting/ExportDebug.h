@@ -0,0 +1,38 @@
+#pragma once
+#include "Scripting/EngineExports.h"
+
+// Bulk records for debug draw; colors are RGBA 0-1
+struct DebugLine_Interop
+{
+	float FromX, FromY;
+	float ToX, ToY;
+	float R, G, B, A;
+};
+
+struct DebugRect_Interop
+{
+	float X, Y; // Center
+	float W, H;
+	float R, G, B, A;
+};
+
+struct DebugCircle_Interop
+{
+	float X, Y;
+	float Radius;
+	float R, G, B, A;
+};
+
+SLIME_EXPORT void __cdecl DebugDraw_Line(float x0, float y0, float x1, float y1, float r, float g, float b, float a, float duration);
+SLIME_EXPORT void __cdecl DebugDraw_Arrow(float x0, float y0, float x1, float y1, float headSize, float r, float g, float b, float a, float duration);
+SLIME_EXPORT void __cdecl DebugDraw_Text(float x, float y, const char* text, float height, float r, float g, float b, float a, float duration);
+
+// Span submission: 'count' records in one call
+SLIME_EXPORT void __cdecl DebugDraw_Lines(const DebugLine_Interop* lines, int count, float duration);
+SLIME_EXPORT void __cdecl DebugDraw_Arrows(const DebugLine_Interop* arrows, int count, float headSize, float duration);
+SLIME_EXPORT void __cdecl DebugDraw_Rects(const DebugRect_Interop* rects, int count, bool filled, float duration);
+SLIME_EXPORT void __cdecl DebugDraw_Circles(const DebugCircle_Interop* circles, int count, bool filled, float duration);
+
+SLIME_EXPORT void __cdecl DebugDraw_Clear();
+SLIME_EXPORT void __cdecl DebugDraw_SetEnabled(bool enabled);
+SLIME_EXPORT bool __cdecl DebugDraw_IsEnabled();
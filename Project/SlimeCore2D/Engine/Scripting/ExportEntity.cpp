@@ -1,8 +1,17 @@
 #include "Scripting/ExportEntity.h"
 
 #include "Rendering/Texture.h"
+#include "Rendering/Tilemap.h"
 #include "Scene/Scene.h"
 
+// Static sprites are baked into cached chunks; any visual change has to requeue them for a rebuild
+static void MarkStaticSpriteDirty(EntityId id)
+{
+	auto* s = Scene::GetActiveScene()->GetRegistry().TryGetComponent<SpriteComponent>((Entity) id);
+	if (s && s->IsStatic)
+		Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
+}
+
 // -------------------------------------------------------------------------
 // ENTITY LIFECYCLE
 // -------------------------------------------------------------------------
@@ -46,6 +55,7 @@ SLIME_EXPORT void __cdecl Entity_SetPosition(EntityId id, float x, float y)
 	{
 		t->Position.x = x;
 		t->Position.y = y;
+		Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 	}
 }
 
@@ -71,6 +81,7 @@ SLIME_EXPORT void __cdecl Entity_SetSize(EntityId id, float sx, float sy)
 	if (auto* t = reg.TryGetComponent<TransformComponent>((Entity) id))
 	{
 		t->Scale = { sx, sy };
+		Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 	}
 }
 
@@ -96,6 +107,7 @@ SLIME_EXPORT void __cdecl Entity_SetColor(EntityId id, float r, float g, float b
 	if (auto* s = reg.TryGetComponent<SpriteComponent>((Entity) id))
 	{
 		s->Color = { r, g, b, 1.0f };
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -123,6 +135,7 @@ SLIME_EXPORT void __cdecl Entity_SetAlpha(EntityId id, float a)
 	if (auto* s = reg.TryGetComponent<SpriteComponent>((Entity) id))
 	{
 		s->Color.a = a;
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -148,6 +161,7 @@ SLIME_EXPORT void __cdecl Entity_SetLayer(EntityId id, int layer)
 		// Use very small step to keep within [-10, 10] range easily
 		// Layer 100 -> Z=0.01f.
 		t->Position.z = layer * 0.0001f;
+		Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 	}
 	if (auto* s = reg.TryGetComponent<SpriteComponent>((Entity) id))
 	{
@@ -175,6 +189,7 @@ SLIME_EXPORT void __cdecl Entity_SetRotation(EntityId id, float degrees)
 	if (auto* t = reg.TryGetComponent<TransformComponent>((Entity) id))
 	{
 		t->Rotation = degrees;
+		Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 	}
 }
 
@@ -198,6 +213,7 @@ SLIME_EXPORT void __cdecl Entity_SetAnchor(EntityId id, float ax, float ay)
 	if (auto* t = reg.TryGetComponent<TransformComponent>((Entity) id))
 	{
 		t->Anchor = { ax, ay };
+		Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 	}
 }
 
@@ -235,6 +251,8 @@ SLIME_EXPORT void __cdecl Entity_SetTexture(EntityId id, unsigned int texId, int
 			a->SpriteWidth = width;
 		}
 	}
+
+	MarkStaticSpriteDirty(id);
 }
 
 SLIME_EXPORT void __cdecl Entity_SetTexturePtr(EntityId id, void* texPtr)
@@ -258,6 +276,8 @@ SLIME_EXPORT void __cdecl Entity_SetTexturePtr(EntityId id, void* texPtr)
 			s->Texture = nullptr;
 		}
 	}
+
+	MarkStaticSpriteDirty(id);
 }
 
 SLIME_EXPORT void* __cdecl Entity_GetTexturePtr(EntityId id)
@@ -280,6 +300,7 @@ SLIME_EXPORT void __cdecl Entity_SetRender(EntityId id, bool value)
 	if (auto* s = reg.TryGetComponent<SpriteComponent>((Entity) id))
 	{
 		s->IsVisible = value;
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -295,6 +316,46 @@ SLIME_EXPORT bool __cdecl Entity_GetRender(EntityId id)
 	return false;
 }
 
+SLIME_EXPORT void __cdecl Entity_SetStatic(EntityId id, bool value)
+{
+	if (!Scene::GetActiveScene())
+		return;
+	auto& reg = Scene::GetActiveScene()->GetRegistry();
+	if (auto* s = reg.TryGetComponent<SpriteComponent>((Entity) id))
+	{
+		if (s->IsStatic == value)
+			return;
+		s->IsStatic = value;
+		Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
+	}
+}
+
+SLIME_EXPORT bool __cdecl Entity_GetStatic(EntityId id)
+{
+	if (!Scene::GetActiveScene())
+		return false;
+	auto& reg = Scene::GetActiveScene()->GetRegistry();
+	if (auto* s = reg.TryGetComponent<SpriteComponent>((Entity) id))
+	{
+		return s->IsStatic;
+	}
+	return false;
+}
+
+// Border widths in texels of the sprite's texture, drawn 'unitsPerTexel' world units wide; all zero stretches it
+SLIME_EXPORT void __cdecl Entity_SetNineSlice(EntityId id, float left, float top, float right, float bottom, float unitsPerTexel)
+{
+	if (!Scene::GetActiveScene())
+		return;
+	auto& reg = Scene::GetActiveScene()->GetRegistry();
+	if (auto* s = reg.TryGetComponent<SpriteComponent>((Entity) id))
+	{
+		s->Slice = { left, top, right, bottom };
+		s->SliceScale = unitsPerTexel;
+		MarkStaticSpriteDirty(id);
+	}
+}
+
 SLIME_EXPORT void __cdecl Entity_SetFrame(EntityId id, int frame)
 {
 	if (!Scene::GetActiveScene())
@@ -303,6 +364,7 @@ SLIME_EXPORT void __cdecl Entity_SetFrame(EntityId id, int frame)
 	if (auto* a = reg.TryGetComponent<AnimationComponent>((Entity) id))
 	{
 		a->Frame = frame;
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -326,6 +388,7 @@ SLIME_EXPORT void __cdecl Entity_AdvanceFrame(EntityId id)
 	if (auto* a = reg.TryGetComponent<AnimationComponent>((Entity) id))
 	{
 		a->Frame++;
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -337,6 +400,7 @@ SLIME_EXPORT void __cdecl Entity_SetSpriteWidth(EntityId id, int width)
 	if (auto* a = reg.TryGetComponent<AnimationComponent>((Entity) id))
 	{
 		a->SpriteWidth = width;
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -360,6 +424,7 @@ SLIME_EXPORT void __cdecl Entity_SetHasAnimation(EntityId id, bool value)
 	if (auto* a = reg.TryGetComponent<AnimationComponent>((Entity) id))
 	{
 		a->HasAnimation = value;
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -371,6 +436,7 @@ SLIME_EXPORT void __cdecl Entity_SetFrameRate(EntityId id, float rate)
 	if (auto* a = reg.TryGetComponent<AnimationComponent>((Entity) id))
 	{
 		a->FrameRate = rate;
+		MarkStaticSpriteDirty(id);
 	}
 }
 
@@ -396,6 +462,7 @@ SLIME_EXPORT void __cdecl Entity_AddComponent_Transform(EntityId id)
 	auto& reg = Scene::GetActiveScene()->GetRegistry();
 	if (!reg.HasComponent<TransformComponent>((Entity) id))
 		reg.AddComponent<TransformComponent>((Entity) id, TransformComponent());
+	Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 }
 
 SLIME_EXPORT bool __cdecl Entity_HasComponent_Transform(EntityId id)
@@ -413,6 +480,7 @@ SLIME_EXPORT void __cdecl Entity_RemoveComponent_Transform(EntityId id)
 	auto& reg = Scene::GetActiveScene()->GetRegistry();
 	if (reg.HasComponent<TransformComponent>((Entity) id))
 		reg.RemoveComponent<TransformComponent>((Entity) id);
+	Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 }
 
 SLIME_EXPORT void __cdecl Entity_AddComponent_Sprite(EntityId id)
@@ -422,6 +490,7 @@ SLIME_EXPORT void __cdecl Entity_AddComponent_Sprite(EntityId id)
 	auto& reg = Scene::GetActiveScene()->GetRegistry();
 	if (!reg.HasComponent<SpriteComponent>((Entity) id))
 		reg.AddComponent<SpriteComponent>((Entity) id, SpriteComponent());
+	Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 }
 
 SLIME_EXPORT bool __cdecl Entity_HasComponent_Sprite(EntityId id)
@@ -439,6 +508,7 @@ SLIME_EXPORT void __cdecl Entity_RemoveComponent_Sprite(EntityId id)
 	auto& reg = Scene::GetActiveScene()->GetRegistry();
 	if (reg.HasComponent<SpriteComponent>((Entity) id))
 		reg.RemoveComponent<SpriteComponent>((Entity) id);
+	Scene::GetActiveScene()->MarkTransformDirty((Entity) id);
 }
 
 SLIME_EXPORT void __cdecl Entity_AddComponent_Animation(EntityId id)
@@ -649,6 +719,36 @@ SLIME_EXPORT void __cdecl Entity_RemoveComponent_AudioSource(EntityId id)
 		reg.RemoveComponent<AudioSourceComponent>((Entity) id);
 }
 
+SLIME_EXPORT void __cdecl Entity_AddComponent_Tilemap(EntityId id, int width, int height, float tileSize)
+{
+	if (!Scene::GetActiveScene() || width <= 0 || height <= 0)
+		return;
+	auto& reg = Scene::GetActiveScene()->GetRegistry();
+	if (!reg.HasComponent<TilemapComponent>((Entity) id))
+	{
+		TilemapComponent tilemap;
+		tilemap.Map = std::make_shared<Tilemap>((uint32_t) width, (uint32_t) height, tileSize);
+		reg.AddComponent<TilemapComponent>((Entity) id, tilemap);
+	}
+}
+
+SLIME_EXPORT bool __cdecl Entity_HasComponent_Tilemap(EntityId id)
+{
+	if (!Scene::GetActiveScene())
+		return false;
+	auto& reg = Scene::GetActiveScene()->GetRegistry();
+	return reg.HasComponent<TilemapComponent>((Entity) id);
+}
+
+SLIME_EXPORT void __cdecl Entity_RemoveComponent_Tilemap(EntityId id)
+{
+	if (!Scene::GetActiveScene())
+		return;
+	auto& reg = Scene::GetActiveScene()->GetRegistry();
+	if (reg.HasComponent<TilemapComponent>((Entity) id))
+		reg.RemoveComponent<TilemapComponent>((Entity) id);
+}
+
 // -------------------------------------------------------------------------
 // PHYSICS ACCESSORS
 // -------------------------------------------------------------------------
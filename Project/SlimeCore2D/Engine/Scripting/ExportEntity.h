@@ -35,6 +35,9 @@ SLIME_EXPORT void __cdecl Entity_SetTexturePtr(EntityId id, void* texPtr);
 SLIME_EXPORT void* __cdecl Entity_GetTexturePtr(EntityId id);
 SLIME_EXPORT void __cdecl Entity_SetRender(EntityId id, bool value);
 SLIME_EXPORT bool __cdecl Entity_GetRender(EntityId id);
+SLIME_EXPORT void __cdecl Entity_SetStatic(EntityId id, bool value);
+SLIME_EXPORT bool __cdecl Entity_GetStatic(EntityId id);
+SLIME_EXPORT void __cdecl Entity_SetNineSlice(EntityId id, float left, float top, float right, float bottom, float unitsPerTexel);
 SLIME_EXPORT void __cdecl Entity_SetFrame(EntityId id, int frame);
 SLIME_EXPORT int __cdecl Entity_GetFrame(EntityId id);
 SLIME_EXPORT void __cdecl Entity_AdvanceFrame(EntityId id);
@@ -87,6 +90,10 @@ SLIME_EXPORT void __cdecl Entity_AddComponent_AudioSource(EntityId id);
 SLIME_EXPORT bool __cdecl Entity_HasComponent_AudioSource(EntityId id);
 SLIME_EXPORT void __cdecl Entity_RemoveComponent_AudioSource(EntityId id);
 
+SLIME_EXPORT void __cdecl Entity_AddComponent_Tilemap(EntityId id, int width, int height, float tileSize);
+SLIME_EXPORT bool __cdecl Entity_HasComponent_Tilemap(EntityId id);
+SLIME_EXPORT void __cdecl Entity_RemoveComponent_Tilemap(EntityId id);
+
 // -----------------------------
 // Physics Accessors
 // -----------------------------
@@ -1,12 +1,23 @@
 #include "ExportParticles.h"
 
 #include "Rendering/ParticleSystem.h"
+#include "Rendering/RenderSnapshot.h"
 
 SLIME_EXPORT void* __cdecl ParticleSystem_Create(uint32_t maxParticles)
 {
 	return new ParticleSystem(maxParticles);
 }
 
+SLIME_EXPORT void* __cdecl ParticleSystem_CreateWithBackend(uint32_t maxParticles, bool gpu)
+{
+	return new ParticleSystem(maxParticles, gpu ? ParticleBackend::GPU : ParticleBackend::CPU);
+}
+
+SLIME_EXPORT bool __cdecl ParticleSystem_IsGpu(void* system)
+{
+	return system && ((ParticleSystem*) system)->GetBackend() == ParticleBackend::GPU;
+}
+
 SLIME_EXPORT void __cdecl ParticleSystem_Destroy(void* system)
 {
 	delete (ParticleSystem*) system;
@@ -19,7 +30,9 @@ SLIME_EXPORT void __cdecl ParticleSystem_OnUpdate(void* system, float ts)
 
 SLIME_EXPORT void __cdecl ParticleSystem_OnRender(void* system)
 {
-	((ParticleSystem*) system)->OnRender();
+	// Only meaningful while Game2D records a frame
+	if (RenderSnapshot* snapshot = RenderSnapshot::GetRecording())
+		((ParticleSystem*) system)->OnRender(*snapshot);
 }
 
 SLIME_EXPORT void __cdecl ParticleSystem_Emit(void* system, ParticleProps_Interop* props)
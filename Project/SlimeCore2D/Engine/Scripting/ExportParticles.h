@@ -15,6 +15,8 @@ struct ParticleProps_Interop
 };
 
 SLIME_EXPORT void* __cdecl ParticleSystem_Create(uint32_t maxParticles);
+SLIME_EXPORT void* __cdecl ParticleSystem_CreateWithBackend(uint32_t maxParticles, bool gpu);
+SLIME_EXPORT bool __cdecl ParticleSystem_IsGpu(void* system);
 SLIME_EXPORT void __cdecl ParticleSystem_Destroy(void* system);
 SLIME_EXPORT void __cdecl ParticleSystem_OnUpdate(void* system, float ts);
 SLIME_EXPORT void __cdecl ParticleSystem_OnRender(void* system);
@@ -1,6 +1,10 @@
 #include "ExportRenderer.h"
 
+#include <algorithm>
+
 #include "Core/Input.h"
+#include "Core/RenderThread.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Renderer.h"
 #include "Rendering/Texture.h"
 #include "Scene/Scene.h"
@@ -9,30 +13,30 @@
 #define GLM_FORCE_LEFT_HANDED
 #include <gtc/matrix_transform.hpp>
 
+// Draw calls record into the frame being built by Game2D::Draw and are dropped outside it
+
 SLIME_EXPORT void __cdecl Renderer_DrawBatch(BatchQuad* quads, int count)
 {
+	RenderSnapshot* snapshot = RenderSnapshot::GetRecording();
+	if (!snapshot || !quads || count <= 0)
+		return;
+
+	Renderer::SpriteInstance* sprites = snapshot->AddSprites((size_t) count);
 	for (int i = 0; i < count; i++)
 	{
-		BatchQuad& q = quads[i];
-		glm::vec2 pos = { q.x, q.y };
-		glm::vec2 size = { q.w, q.h };
-		glm::vec4 color = { q.r, q.g, q.b, q.a };
-
-		if (q.texture)
-		{
-			Renderer::DrawQuad(pos, size, (Texture*) q.texture, 1.0f, color);
-		}
-		else
-		{
-			Renderer::DrawQuad(pos, size, color);
-		}
+		const BatchQuad& q = quads[i];
+		Renderer::SpriteInstance& sprite = sprites[i];
+		sprite.Transform = glm::translate(glm::mat4(1.0f), glm::vec3(q.x, q.y, 0.0f)) * glm::scale(glm::mat4(1.0f), glm::vec3(q.w, q.h, 1.0f));
+		sprite.Texture = (Texture*) q.texture;
+		sprite.Color = { q.r, q.g, q.b, q.a };
 	}
 }
 
 SLIME_EXPORT void __cdecl Renderer_BeginScenePrimary()
 {
+	RenderSnapshot* snapshot = RenderSnapshot::GetRecording();
 	Scene* scene = Scene::GetActiveScene();
-	if (scene)
+	if (snapshot && scene)
 	{
 		Entity camEntity = scene->GetPrimaryCameraEntity();
 		if (camEntity != NullEntity)
@@ -63,22 +67,93 @@ SLIME_EXPORT void __cdecl Renderer_BeginScenePrimary()
 
 			glm::mat4 viewProj = proj * view;
 
-			Renderer::BeginScene(viewProj);
+			snapshot->BeginScene(viewProj);
 		}
 	}
 }
 
 SLIME_EXPORT void __cdecl Renderer_EndScene()
 {
-	Renderer::EndScene();
+	if (RenderSnapshot* snapshot = RenderSnapshot::GetRecording())
+		snapshot->EndScene();
 }
 
 SLIME_EXPORT void __cdecl Renderer_EnableScissor(float x, float y, float w, float h)
 {
-    Renderer::EnableScissor(x, y, w, h);
+    if (RenderSnapshot* snapshot = RenderSnapshot::GetRecording())
+        snapshot->EnableScissor(x, y, w, h);
 }
 
 SLIME_EXPORT void __cdecl Renderer_DisableScissor()
 {
-    Renderer::DisableScissor();
+    if (RenderSnapshot* snapshot = RenderSnapshot::GetRecording())
+        snapshot->DisableScissor();
+}
+
+SLIME_EXPORT void __cdecl Renderer_PushClipRect(float x, float y, float w, float h)
+{
+    if (RenderSnapshot* snapshot = RenderSnapshot::GetRecording())
+        snapshot->PushClipRect(x, y, w, h);
+}
+
+SLIME_EXPORT void __cdecl Renderer_PopClipRect()
+{
+    if (RenderSnapshot* snapshot = RenderSnapshot::GetRecording())
+        snapshot->PopClipRect();
+}
+
+// The report is swapped in on the render thread, so reads wait for the frame in flight
+
+SLIME_EXPORT int __cdecl Renderer_GetBatchReportCount()
+{
+	RenderThread::Wait();
+	return (int) Renderer::GetBatchReport().size();
+}
+
+SLIME_EXPORT int __cdecl Renderer_GetBatchReport(Renderer_BatchRecord* outRecords, int maxCount)
+{
+	if (!outRecords || maxCount <= 0)
+		return 0;
+
+	RenderThread::Wait();
+	const auto& report = Renderer::GetBatchReport();
+	int count = std::min(maxCount, (int) report.size());
+	for (int i = 0; i < count; i++)
+	{
+		const Renderer::BatchRecord& record = report[i];
+		outRecords[i] = { (uint32_t) record.Reason, (uint32_t) record.Pipeline, record.DrawCalls, record.QuadCount, record.TextureCount };
+	}
+	return count;
+}
+
+SLIME_EXPORT bool __cdecl Renderer_DumpBatchReportJson(const char* path)
+{
+	if (!path)
+		return false;
+	RenderThread::Wait();
+	return Renderer::DumpBatchReportJson(path);
+}
+
+// Settings and stats are used by the render thread's world pass, so both sides wait for the frame in flight
+
+SLIME_EXPORT void __cdecl Renderer_SetDynamicResolution(bool enabled, float minScale, float maxScale, float targetGpuMs)
+{
+	Renderer::DynamicResolutionSettings settings;
+	settings.Enabled = enabled;
+	settings.MinScale = minScale;
+	settings.MaxScale = maxScale;
+	settings.TargetGpuMs = targetGpuMs;
+
+	RenderThread::Wait();
+	Renderer::SetDynamicResolution(settings);
+}
+
+SLIME_EXPORT void __cdecl Renderer_GetDynamicResolutionStats(Renderer_DynamicResolutionStats* outStats)
+{
+	if (!outStats)
+		return;
+
+	RenderThread::Wait();
+	Renderer::DynamicResolutionStats stats = Renderer::GetDynamicResolutionStats();
+	*outStats = { stats.Scale, stats.Width, stats.Height, stats.GpuTimeMs, stats.SmoothedGpuTimeMs, stats.TimingAvailable };
 }
@@ -11,7 +11,37 @@ extern "C"
 		void* texture;
 	};
 
+	struct Renderer_BatchRecord
+	{
+		uint32_t reason;
+		uint32_t pipeline;
+		uint32_t drawCalls;
+		uint32_t quadCount;
+		uint32_t textureCount;
+	};
+
+	struct Renderer_DynamicResolutionStats
+	{
+		float scale;
+		uint32_t width;
+		uint32_t height;
+		float gpuTimeMs;
+		float smoothedGpuTimeMs;
+		bool timingAvailable;
+	};
+
 	SLIME_EXPORT void __cdecl Renderer_DrawBatch(BatchQuad* quads, int count);
 	SLIME_EXPORT void __cdecl Renderer_BeginScenePrimary();
 	SLIME_EXPORT void __cdecl Renderer_EndScene();
+	SLIME_EXPORT void __cdecl Renderer_PushClipRect(float x, float y, float w, float h);
+	SLIME_EXPORT void __cdecl Renderer_PopClipRect();
+
+	// Batch diagnostics for the last completed frame; records match Renderer::BatchRecord
+	SLIME_EXPORT int __cdecl Renderer_GetBatchReportCount();
+	SLIME_EXPORT int __cdecl Renderer_GetBatchReport(Renderer_BatchRecord* outRecords, int maxCount);
+	SLIME_EXPORT bool __cdecl Renderer_DumpBatchReportJson(const char* path);
+
+	// Dynamic resolution of the world pass; see Renderer::SetDynamicResolution
+	SLIME_EXPORT void __cdecl Renderer_SetDynamicResolution(bool enabled, float minScale, float maxScale, float targetGpuMs);
+	SLIME_EXPORT void __cdecl Renderer_GetDynamicResolutionStats(Renderer_DynamicResolutionStats* outStats);
 }
@@ -20,6 +20,11 @@ SLIME_EXPORT void* __cdecl Resources_GetTexture(const char* name)
 	return (void*) ResourceManager::GetInstance().GetTexture(name);
 }
 
+SLIME_EXPORT uint32_t __cdecl Resources_BuildTextureAtlas()
+{
+	return ResourceManager::GetInstance().BuildTextureAtlas();
+}
+
 SLIME_EXPORT void* __cdecl Resources_LoadFont(const char* name, const char* path, int fontSize)
 {
 	if (!name)
@@ -62,3 +62,9 @@ SLIME_EXPORT void __cdecl Scene_SetGravity(float x, float y)
 	if (Scene::GetActiveScene())
 		Scene::GetActiveScene()->SetGravity(glm::vec2(x, y));
 }
+
+SLIME_EXPORT void __cdecl Scene_SetImpostorThreshold(float pixelsPerUnit)
+{
+	if (Scene::GetActiveScene())
+		Scene::GetActiveScene()->SetImpostorThreshold(pixelsPerUnit);
+}
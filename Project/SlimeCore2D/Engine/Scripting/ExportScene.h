@@ -16,3 +16,6 @@ SLIME_EXPORT void __cdecl Scene_RegisterParticleSystem(void* system);
 SLIME_EXPORT void __cdecl Scene_UnregisterParticleSystem(void* system);
 
 SLIME_EXPORT void __cdecl Scene_SetGravity(float x, float y);
+
+// Screen pixels per world unit at or below which the ground is drawn from cached chunk impostors; 0 disables
+SLIME_EXPORT void __cdecl Scene_SetImpostorThreshold(float pixelsPerUnit);
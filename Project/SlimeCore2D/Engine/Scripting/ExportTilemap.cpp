@@ -0,0 +1,115 @@
+#include "Scripting/ExportTilemap.h"
+
+#include "Rendering/Minimap.h"
+#include "Rendering/Texture.h"
+#include "Rendering/Tilemap.h"
+#include "Scene/Scene.h"
+
+static Tilemap* GetTilemap(EntityId id)
+{
+	if (!Scene::GetActiveScene() || id == 0)
+		return nullptr;
+	auto* component = Scene::GetActiveScene()->GetRegistry().TryGetComponent<TilemapComponent>((Entity) id);
+	return component ? component->Map.get() : nullptr;
+}
+
+SLIME_EXPORT void __cdecl Tilemap_SetTileType(EntityId id, int type, void* texPtr, int frameCount, float frameRate)
+{
+	if (auto* map = GetTilemap(id))
+	{
+		if (type < 0)
+			return;
+		map->SetTileType((uint8_t) type, (Texture*) texPtr, frameCount > 0 ? (uint32_t) frameCount : 1u, frameRate);
+	}
+}
+
+SLIME_EXPORT void __cdecl Tilemap_SetTile(EntityId id, int x, int y, int type, int mask)
+{
+	if (auto* map = GetTilemap(id))
+	{
+		if (x < 0 || y < 0)
+			return;
+		// Negative types clear the tile
+		uint8_t tileType = type < 0 ? Tilemap::EmptyTile : (uint8_t) type;
+		map->SetTile((uint32_t) x, (uint32_t) y, tileType, (uint8_t) (mask & 0xF));
+	}
+}
+
+SLIME_EXPORT int __cdecl Tilemap_GetTile(EntityId id, int x, int y)
+{
+	if (auto* map = GetTilemap(id))
+	{
+		if (x < 0 || y < 0)
+			return -1;
+		uint8_t type = map->GetTile((uint32_t) x, (uint32_t) y);
+		return type == Tilemap::EmptyTile ? -1 : (int) type;
+	}
+	return -1;
+}
+
+SLIME_EXPORT void __cdecl Tilemap_SetTiles(EntityId id, int x, int y, int width, int height, const uint8_t* types, const uint8_t* masks)
+{
+	auto* map = GetTilemap(id);
+	if (!map || !types || x < 0 || y < 0 || width <= 0 || height <= 0)
+		return;
+
+	// Bulk upload of a row-major block, so a whole world costs one interop call
+	for (int row = 0; row < height; ++row)
+	{
+		for (int col = 0; col < width; ++col)
+		{
+			size_t i = (size_t) row * width + col;
+			map->SetTile((uint32_t) (x + col), (uint32_t) (y + row), types[i], masks ? (uint8_t) (masks[i] & 0xF) : 0);
+		}
+	}
+}
+
+SLIME_EXPORT void __cdecl Tilemap_Fill(EntityId id, int type)
+{
+	if (auto* map = GetTilemap(id))
+		map->Fill(type < 0 ? Tilemap::EmptyTile : (uint8_t) type);
+}
+
+SLIME_EXPORT void __cdecl Tilemap_RecalculateMasks(EntityId id)
+{
+	if (auto* map = GetTilemap(id))
+		map->RecalculateMasks();
+}
+
+SLIME_EXPORT void __cdecl Tilemap_SetVisible(EntityId id, bool value)
+{
+	if (!Scene::GetActiveScene() || id == 0)
+		return;
+	if (auto* component = Scene::GetActiveScene()->GetRegistry().TryGetComponent<TilemapComponent>((Entity) id))
+		component->IsVisible = value;
+}
+
+SLIME_EXPORT void* __cdecl Tilemap_EnableMinimap(EntityId id)
+{
+	if (auto* map = GetTilemap(id))
+		return (void*) map->EnableMinimap()->GetTexture();
+	return nullptr;
+}
+
+SLIME_EXPORT void __cdecl Tilemap_SetMinimapColor(EntityId id, int type, float r, float g, float b, float a)
+{
+	if (type < 0 || type > 255)
+		return;
+	if (auto* map = GetTilemap(id))
+		map->EnableMinimap()->SetTypeColor((uint8_t) type, { r, g, b, a });
+}
+
+SLIME_EXPORT void __cdecl Tilemap_SetMinimapMarkers(EntityId id, const MinimapMarker_Interop* markers, int count)
+{
+	auto* map = GetTilemap(id);
+	if (!map || !map->GetMinimap())
+		return;
+
+	Minimap* minimap = map->GetMinimap();
+	minimap->ClearMarkers();
+	for (int i = 0; markers && i < count; ++i)
+	{
+		const MinimapMarker_Interop& m = markers[i];
+		minimap->AddMarker({ { m.X, m.Y }, { m.R, m.G, m.B, m.A }, m.Size });
+	}
+}
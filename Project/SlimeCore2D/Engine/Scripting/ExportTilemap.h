@@ -0,0 +1,29 @@
+#pragma once
+#include "Scripting/EngineExports.h"
+
+// -----------------------------
+// Tilemap (entity must have a Tilemap component)
+// -----------------------------
+SLIME_EXPORT void __cdecl Tilemap_SetTileType(EntityId id, int type, void* texPtr, int frameCount, float frameRate);
+SLIME_EXPORT void __cdecl Tilemap_SetTile(EntityId id, int x, int y, int type, int mask);
+SLIME_EXPORT int __cdecl Tilemap_GetTile(EntityId id, int x, int y);
+SLIME_EXPORT void __cdecl Tilemap_SetTiles(EntityId id, int x, int y, int width, int height, const uint8_t* types, const uint8_t* masks);
+SLIME_EXPORT void __cdecl Tilemap_Fill(EntityId id, int type);
+SLIME_EXPORT void __cdecl Tilemap_RecalculateMasks(EntityId id);
+SLIME_EXPORT void __cdecl Tilemap_SetVisible(EntityId id, bool value);
+
+// -----------------------------
+// Minimap (one texel per tile, updated from tile edits)
+// -----------------------------
+struct MinimapMarker_Interop
+{
+	float X, Y; // In tiles
+	float R, G, B, A;
+	float Size; // In tiles
+};
+
+// Creates the minimap on first use; returns its Texture*
+SLIME_EXPORT void* __cdecl Tilemap_EnableMinimap(EntityId id);
+SLIME_EXPORT void __cdecl Tilemap_SetMinimapColor(EntityId id, int type, float r, float g, float b, float a);
+// Replaces the marker batch drawn with the minimap this frame
+SLIME_EXPORT void __cdecl Tilemap_SetMinimapMarkers(EntityId id, const MinimapMarker_Interop* markers, int count);
@@ -6,6 +6,20 @@
 #include "Resources/ResourceManager.h"
 #include "Scene/Scene.h"
 
+namespace
+{
+	// UI geometry is retained per layer, so every setter that changes what is drawn flags the element's layer
+	template <typename T>
+	void SetUIField(Scene* scene, ObjectId id, T& field, const T& value)
+	{
+		if (field == value)
+			return;
+
+		field = value;
+		scene->MarkUIDirty(id);
+	}
+} // namespace
+
 SLIME_EXPORT EntityId __cdecl UI_CreateText(const char* text, int fontSize, float x, float y)
 {
 	if (!Scene::GetActiveScene())
@@ -62,7 +76,7 @@ SLIME_EXPORT void __cdecl UI_SetText(EntityId id, const char* text)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->TextContent = text;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->TextContent, std::string(text));
 	}
 }
 
@@ -72,7 +86,7 @@ SLIME_EXPORT void __cdecl UI_SetPosition(EntityId id, float x, float y)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->Position = { x, y };
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Position, glm::vec2(x, y));
 	}
 }
 
@@ -95,7 +109,7 @@ SLIME_EXPORT void __cdecl UI_SetSize(EntityId id, float w, float h)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->Scale = { w, h };
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Scale, glm::vec2(w, h));
 	}
 }
 
@@ -118,9 +132,7 @@ SLIME_EXPORT void __cdecl UI_SetColor(EntityId id, float r, float g, float b)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->Color.r = r;
-		el->Color.g = g;
-		el->Color.b = b;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Color, glm::vec4(r, g, b, el->Color.a));
 	}
 }
 
@@ -130,7 +142,7 @@ SLIME_EXPORT void __cdecl UI_SetAlpha(EntityId id, float a)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->Color.a = a;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Color.a, a);
 	}
 }
 
@@ -140,7 +152,7 @@ SLIME_EXPORT void __cdecl UI_SetVisible(EntityId id, bool visible)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->IsVisible = visible;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->IsVisible, visible);
 	}
 }
 
@@ -150,7 +162,7 @@ SLIME_EXPORT void __cdecl UI_SetLayer(EntityId id, int layer)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->Layer = layer;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Layer, layer);
 	}
 }
 
@@ -160,7 +172,21 @@ SLIME_EXPORT void __cdecl UI_SetTexture(EntityId id, void* texturePtr)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->Image = (Texture*) texturePtr;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Image, (Texture*) texturePtr);
+	}
+}
+
+SLIME_EXPORT void __cdecl UI_SetMinimap(EntityId id, EntityId tilemapEntity)
+{
+	Scene* scene = Scene::GetActiveScene();
+	if (!scene || id == 0)
+		return;
+	if (PersistentUIElement* el = scene->GetUIElement((ObjectId) id))
+	{
+		// Zero detaches
+		auto* component = tilemapEntity != 0 ? scene->GetRegistry().TryGetComponent<TilemapComponent>((Entity) tilemapEntity) : nullptr;
+		el->MinimapSource = component ? component->Map : nullptr;
+		scene->MarkUIDirty((ObjectId) id);
 	}
 }
 
@@ -170,7 +196,7 @@ SLIME_EXPORT void __cdecl UI_SetAnchor(EntityId id, float ax, float ay)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->Anchor = { ax, ay };
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Anchor, glm::vec2(ax, ay));
 	}
 }
 
@@ -180,7 +206,7 @@ SLIME_EXPORT void __cdecl UI_SetUseScreenSpace(EntityId id, bool useScreenSpace)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->UseScreenSpace = useScreenSpace;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->UseScreenSpace, useScreenSpace);
 	}
 }
 
@@ -190,7 +216,7 @@ SLIME_EXPORT void __cdecl UI_SetWrapWidth(EntityId id, float wrapWidth)
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->WrapWidth = wrapWidth;
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->WrapWidth, wrapWidth);
 	}
 }
 
@@ -200,7 +226,40 @@ SLIME_EXPORT void __cdecl UI_SetClipRect(EntityId id, float x, float y, float w,
 		return;
 	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
 	{
-		el->ClipRect = { x, y, w, h };
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->ClipRect, glm::vec4(x, y, w, h));
+	}
+}
+
+// Border widths in texels of the element's texture; all zero stretches it as one quad
+SLIME_EXPORT void __cdecl UI_SetNineSlice(EntityId id, float left, float top, float right, float bottom)
+{
+	if (!Scene::GetActiveScene() || id == 0)
+		return;
+	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
+	{
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->Slice, glm::vec4(left, top, right, bottom));
+	}
+}
+
+SLIME_EXPORT void __cdecl UI_SetCornerRadius(EntityId id, float radius)
+{
+	if (!Scene::GetActiveScene() || id == 0)
+		return;
+	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
+	{
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->CornerRadius, radius);
+	}
+}
+
+// Outline drawn inside the element's edge, following its corner radius; zero width removes it
+SLIME_EXPORT void __cdecl UI_SetBorder(EntityId id, float width, float r, float g, float b, float a)
+{
+	if (!Scene::GetActiveScene() || id == 0)
+		return;
+	if (PersistentUIElement* el = Scene::GetActiveScene()->GetUIElement((ObjectId) id))
+	{
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->BorderWidth, width);
+		SetUIField(Scene::GetActiveScene(), (ObjectId) id, el->BorderColor, glm::vec4(r, g, b, a));
 	}
 }
 
@@ -212,7 +271,8 @@ SLIME_EXPORT void __cdecl UI_GetTextSize(EntityId id, float* outWidth, float* ou
 	{
 		if (el->IsText && el->Font)
 		{
-			glm::vec2 size = el->Font->CalculateSize(el->TextContent, el->Scale.x, el->WrapWidth);
+			el->Layout.Update(el->TextContent, el->Font, el->Scale.x, el->WrapWidth);
+			glm::vec2 size = el->Layout.GetSize();
 			if (outWidth)
 				*outWidth = size.x;
 			if (outHeight)
@@ -229,7 +289,8 @@ SLIME_EXPORT float __cdecl UI_GetTextWidth(EntityId id)
 	{
 		if (el->IsText && el->Font)
 		{
-			return el->Font->CalculateSize(el->TextContent, el->Scale.x, el->WrapWidth).x;
+			el->Layout.Update(el->TextContent, el->Font, el->Scale.x, el->WrapWidth);
+			return el->Layout.GetSize().x;
 		}
 	}
 	return 0.0f;
@@ -243,7 +304,8 @@ SLIME_EXPORT float __cdecl UI_GetTextHeight(EntityId id)
 	{
 		if (el->IsText && el->Font)
 		{
-			return el->Font->CalculateSize(el->TextContent, el->Scale.x, el->WrapWidth).y;
+			el->Layout.Update(el->TextContent, el->Font, el->Scale.x, el->WrapWidth);
+			return el->Layout.GetSize().y;
 		}
 	}
 	return 0.0f;
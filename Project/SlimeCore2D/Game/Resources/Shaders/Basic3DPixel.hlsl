@@ -1,13 +1,6 @@
 Texture2D    u_Texture;
 SamplerState u_Sampler;
 
-cbuffer MeshConstants
-{
-    float4x4 World;
-    float4 Color;
-    float4 UseTexture; // x = UseTexture, yzw = Padding
-};
-
 struct PSInput
 {
     float4 Pos      : SV_POSITION;
@@ -24,12 +17,8 @@ struct PSOutput
 
 void main(in PSInput PSIn, out PSOutput PSOut)
 {
-    float4 texColor = float4(1.0, 1.0, 1.0, 1.0);
-    
-    if (UseTexture.x > 0.5)
-    {
-        texColor = u_Texture.Sample(u_Sampler, PSIn.UV);
-    }
+    // Untextured meshes are bound to the white texture
+    float4 texColor = u_Texture.Sample(u_Sampler, PSIn.UV);
 
     // Simple directional light (hardcoded for "basic" 3D)
     float3 lightDir = normalize(float3(-0.5, -1.0, -0.5));
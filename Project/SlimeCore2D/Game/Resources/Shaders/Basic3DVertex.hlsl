@@ -3,18 +3,18 @@ cbuffer GlobalConstants
     float4x4 ViewProjection;
 };
 
-cbuffer MeshConstants
-{
-    float4x4 World;
-    float4 Color;
-    float4 UseTexture; // x = UseTexture, yzw = Padding
-};
-
 struct VSInput
 {
     float3 Pos    : ATTRIB0;
     float3 Normal : ATTRIB1;
     float2 UV     : ATTRIB2;
+
+    // Per instance: world matrix columns and color
+    float4 World0 : ATTRIB3;
+    float4 World1 : ATTRIB4;
+    float4 World2 : ATTRIB5;
+    float4 World3 : ATTRIB6;
+    float4 Color  : ATTRIB7;
 };
 
 struct PSInput
@@ -28,8 +28,8 @@ struct PSInput
 
 void main(in VSInput VSIn, out PSInput PSOut)
 {
-    // Calculate World Position
-    float4 worldPos = mul(World, float4(VSIn.Pos, 1.0));
+    // Calculate World Position (the columns arrive as separate attributes)
+    float4 worldPos = VSIn.World0 * VSIn.Pos.x + VSIn.World1 * VSIn.Pos.y + VSIn.World2 * VSIn.Pos.z + VSIn.World3;
     PSOut.WorldPos = worldPos.xyz;
 
     // Calculate Clip Space Position
@@ -39,7 +39,7 @@ void main(in VSInput VSIn, out PSInput PSOut)
     PSOut.UV = VSIn.UV;
     
     // Transform Normal to World Space (assuming uniform scaling for now)
-    PSOut.Normal = normalize(mul((float3x3)World, VSIn.Normal));
+    PSOut.Normal = normalize(VSIn.World0.xyz * VSIn.Normal.x + VSIn.World1.xyz * VSIn.Normal.y + VSIn.World2.xyz * VSIn.Normal.z);
     
-    PSOut.Color = Color;
+    PSOut.Color = VSIn.Color;
 }
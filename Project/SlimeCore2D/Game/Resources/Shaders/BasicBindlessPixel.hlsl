@@ -0,0 +1,5 @@
+// BasicPixel over the renderer's bindless texture table, built when the device supports bindless resources.
+// Must match RendererData::BindlessTableSlots.
+#define TEXTURE_SLOTS 1024
+
+#include "BasicPixel.hlsl"
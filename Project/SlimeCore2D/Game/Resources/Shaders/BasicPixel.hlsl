@@ -9,10 +9,18 @@ struct PS_INPUT
     nointerpolation float TexIndex : TEXCOORD1;
     nointerpolation float Tiling : TILING;
     nointerpolation float IsText : ISTEXT;
+    nointerpolation float4 ClipRect : CLIPRECT;
+    float2 ShapeCoord : SHAPECOORD;
+    nointerpolation float4 Shape : SHAPE;
+    nointerpolation float4 BorderColor : BORDERCOLOR;
 };
 
 float4 main(PS_INPUT input) : SV_TARGET
 {
+    // Clip rect in render-target pixels (left, top, right, bottom)
+    if (input.Pos.x < input.ClipRect.x || input.Pos.y < input.ClipRect.y || input.Pos.x >= input.ClipRect.z || input.Pos.y >= input.ClipRect.w)
+        discard;
+
     float4 texColor = input.Color;
     int index = (int)(input.TexIndex + 0.5);
     
@@ -21,7 +29,7 @@ float4 main(PS_INPUT input) : SV_TARGET
     float2 dx = ddx(uv);
     float2 dy = ddy(uv);
     
-    if (input.IsText > 0.5)
+    if (input.IsText > 0.5 && input.IsText < 1.5)
     {
         // Text (SDF) - Linear Sampling
         sampled = SampleTexture(index, u_SamplerLinear, uv, dx, dy);
@@ -36,6 +44,34 @@ float4 main(PS_INPUT input) : SV_TARGET
         // Sprites - Point Sampling
         sampled = SampleTexture(index, u_Sampler, uv, dx, dy);
         texColor *= sampled;
+
+        if (input.IsText > 2.5)
+        {
+            // Cutout drawn by the layered opaque pass: blending is off, so coverage is all or nothing
+            if (texColor.a < 0.5) discard;
+            texColor.a = 1.0;
+        }
+        else if (input.IsText > 1.5)
+        {
+            // Rounded rect: signed distance to the edge, in quad units (negative inside)
+            float2 halfSize = input.Shape.xy;
+            float radius = min(input.Shape.z, min(halfSize.x, halfSize.y));
+            float2 q = abs(input.ShapeCoord) - (halfSize - radius);
+            float distance = length(max(q, 0.0)) + min(max(q.x, q.y), 0.0) - radius;
+
+            float smoothing = fwidth(distance);
+            float coverage = 1.0 - smoothstep(-smoothing, smoothing, distance);
+
+            // Outline band along the inside of the edge
+            float border = input.Shape.w;
+            if (border > 0.0)
+            {
+                float inner = smoothstep(-smoothing, smoothing, distance + border);
+                texColor = lerp(texColor, input.BorderColor, inner);
+            }
+
+            texColor.a *= coverage;
+        }
     }
     
     if (texColor.a < 0.01) discard;
@@ -8,6 +8,10 @@ struct VS_INPUT
     float TexIndex : ATTRIB3;
     float Tiling : ATTRIB4;
     float IsText : ATTRIB5;
+    uint4 ClipRect : ATTRIB6; // Pixels, 16 bits each
+    float2 ShapeCoord : ATTRIB7;
+    float4 Shape : ATTRIB8;
+    float4 BorderColor : ATTRIB9;
 };
 
 struct PS_INPUT
@@ -18,6 +22,10 @@ struct PS_INPUT
     nointerpolation float TexIndex : TEXCOORD1;
     nointerpolation float Tiling : TILING;
     nointerpolation float IsText : ISTEXT;
+    nointerpolation float4 ClipRect : CLIPRECT;
+    float2 ShapeCoord : SHAPECOORD;
+    nointerpolation float4 Shape : SHAPE;
+    nointerpolation float4 BorderColor : BORDERCOLOR;
 };
 
 PS_INPUT main(VS_INPUT vsInput)
@@ -30,6 +38,10 @@ PS_INPUT main(VS_INPUT vsInput)
     output.TexIndex = vsInput.TexIndex;
     output.Tiling = vsInput.Tiling;
     output.IsText = vsInput.IsText;
+    output.ClipRect = (float4)vsInput.ClipRect;
+    output.ShapeCoord = vsInput.ShapeCoord;
+    output.Shape = vsInput.Shape;
+    output.BorderColor = vsInput.BorderColor;
     
     return output;
 }
@@ -0,0 +1,10 @@
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float4 Color : COLOR;
+};
+
+float4 main(PS_INPUT input) : SV_TARGET
+{
+    return input.Color;
+}
@@ -0,0 +1,21 @@
+#include "Structures.fxh"
+
+struct VS_INPUT
+{
+    float2 Pos : ATTRIB0;
+    float4 Color : ATTRIB1;
+};
+
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float4 Color : COLOR;
+};
+
+PS_INPUT main(VS_INPUT vsInput)
+{
+    PS_INPUT output;
+    output.Pos = mul(u_ViewProjection, float4(vsInput.Pos, 0.0, 1.0));
+    output.Color = vsInput.Color;
+    return output;
+}
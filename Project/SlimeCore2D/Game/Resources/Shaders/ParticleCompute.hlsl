@@ -0,0 +1,126 @@
+#include "Particles.fxh"
+
+// GPU particle kernels, one entry point per pass: Prepare -> Emit -> Simulate -> Finish.
+// Free slots live in a dead list; live ones in two alive lists that swap every frame, so
+// Simulate compacts survivors as it goes and nothing ever walks the whole pool.
+
+cbuffer ParticleConstants
+{
+    float u_DeltaTime;
+    uint u_EmitCount;
+    uint u_MaxParticles;
+    uint u_Seed;
+};
+
+RWStructuredBuffer<GpuParticle> Particles;
+RWStructuredBuffer<uint> DeadList;
+RWStructuredBuffer<uint> AliveIn;
+RWStructuredBuffer<uint> AliveOut;
+RWStructuredBuffer<uint> Counters;
+RWByteAddressBuffer IndirectArgs;
+StructuredBuffer<GpuEmit> Emits;
+
+uint Hash(uint x)
+{
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    x *= 0x846ca68b;
+    x ^= x >> 16;
+    return x;
+}
+
+// [-0.5, 0.5), matching the CPU path's Random::Float() - 0.5f
+float Variation(inout uint state)
+{
+    state = Hash(state);
+    return (float)(state >> 8) / 16777216.0 - 0.5;
+}
+
+// Takes this frame's emissions out of the dead list and sizes the Simulate dispatch
+[numthreads(1, 1, 1)]
+void Prepare()
+{
+    uint dead = Counters[COUNTER_DEAD];
+    uint alive = Counters[COUNTER_ALIVE];
+    uint emit = min(u_EmitCount, dead);
+
+    Counters[COUNTER_EMIT] = emit;
+    Counters[COUNTER_DEAD_BASE] = dead;
+    Counters[COUNTER_DEAD] = dead - emit;
+    Counters[COUNTER_ALIVE_BASE] = alive;
+    Counters[COUNTER_ALIVE] = alive + emit;
+    Counters[COUNTER_ALIVE_NEXT] = 0;
+
+    IndirectArgs.Store3(ARGS_DISPATCH, uint3((alive + emit + PARTICLE_GROUP_SIZE - 1) / PARTICLE_GROUP_SIZE, 1, 1));
+}
+
+[numthreads(EMIT_GROUP_SIZE, 1, 1)]
+void Emit(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= Counters[COUNTER_EMIT])
+        return;
+
+    uint index = DeadList[Counters[COUNTER_DEAD_BASE] - 1 - id.x];
+    GpuEmit e = Emits[id.x];
+    uint rng = u_Seed ^ (id.x * 0x9e3779b9);
+
+    GpuParticle p;
+    p.Position = e.Position;
+    p.Velocity = e.Velocity + e.VelocityVariation * float2(Variation(rng), Variation(rng));
+    p.ColorBegin = e.ColorBegin;
+    p.ColorEnd = e.ColorEnd;
+    p.Color = e.ColorBegin;
+    p.Rotation = (Variation(rng) + 0.5) * 2.0 * 3.14159;
+    p.SizeBegin = e.SizeBegin + e.SizeVariation * Variation(rng);
+    p.SizeEnd = e.SizeEnd;
+    p.Size = p.SizeBegin;
+    p.LifeTime = e.LifeTime;
+    p.LifeRemaining = e.LifeTime;
+    p.Padding = float2(0.0, 0.0);
+
+    Particles[index] = p;
+    AliveIn[Counters[COUNTER_ALIVE_BASE] + id.x] = index;
+}
+
+// Ages every live particle; survivors are appended to AliveOut, the rest go back to the dead list
+[numthreads(PARTICLE_GROUP_SIZE, 1, 1)]
+void Simulate(uint3 id : SV_DispatchThreadID)
+{
+    if (id.x >= Counters[COUNTER_ALIVE])
+        return;
+
+    uint index = AliveIn[id.x];
+    GpuParticle p = Particles[index];
+
+    p.LifeRemaining -= u_DeltaTime;
+    if (p.LifeRemaining <= 0.0)
+    {
+        uint deadSlot;
+        InterlockedAdd(Counters[COUNTER_DEAD], 1, deadSlot);
+        DeadList[deadSlot] = index;
+        return;
+    }
+
+    p.Position += p.Velocity * u_DeltaTime;
+    p.Rotation += 0.01 * u_DeltaTime;
+
+    float life = p.LifeRemaining / p.LifeTime;
+    p.Color = lerp(p.ColorEnd, p.ColorBegin, life);
+    p.Size = lerp(p.SizeEnd, p.SizeBegin, life);
+    Particles[index] = p;
+
+    uint aliveSlot;
+    InterlockedAdd(Counters[COUNTER_ALIVE_NEXT], 1, aliveSlot);
+    AliveOut[aliveSlot] = index;
+}
+
+// Makes the compacted list current and writes the instance count for the indirect draw
+[numthreads(1, 1, 1)]
+void Finish()
+{
+    uint alive = Counters[COUNTER_ALIVE_NEXT];
+    Counters[COUNTER_ALIVE] = alive;
+
+    IndirectArgs.Store4(ARGS_DRAW, uint4(6, alive, 0, 0));
+}
@@ -0,0 +1,34 @@
+#include "Structures.fxh"
+#include "Particles.fxh"
+
+StructuredBuffer<GpuParticle> Particles;
+StructuredBuffer<uint> AliveList;
+
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float4 Color : COLOR;
+};
+
+static const float2 Corners[6] = {
+    float2(-0.5, -0.5), float2(0.5, -0.5), float2(0.5, 0.5),
+    float2(0.5, 0.5), float2(-0.5, 0.5), float2(-0.5, -0.5)
+};
+
+// One instance per live particle, two triangles from the vertex id (no vertex buffer)
+PS_INPUT main(uint vertexId : SV_VertexID, uint instanceId : SV_InstanceID)
+{
+    PS_INPUT output;
+
+    GpuParticle p = Particles[AliveList[instanceId]];
+
+    float s, c;
+    sincos(p.Rotation, s, c);
+    float2 corner = Corners[vertexId] * p.Size;
+    float2 world = p.Position + float2(corner.x * c - corner.y * s, corner.x * s + corner.y * c);
+
+    output.Pos = mul(u_ViewProjection, float4(world, -0.01, 1.0));
+    output.Color = p.Color;
+
+    return output;
+}
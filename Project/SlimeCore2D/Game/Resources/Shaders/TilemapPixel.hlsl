@@ -0,0 +1,47 @@
+#include "Structures.fxh"
+#include "TextureSampler.fxh"
+#include "Tilemap.fxh"
+
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float2 TileCoord : TEXCOORD0;
+};
+
+// R = tile type (255 = empty), G = autotile mask (N = 1, E = 2, S = 4, W = 8)
+Texture2D<uint2> u_TileData;
+
+// 3x3 sheet cell for each mask, same table as FactoryTile.GetTerrainUVs
+static const float2 AutotileCells[16] = {
+    float2(1, 1), float2(1, 2), float2(0, 1), float2(0, 2),
+    float2(1, 0), float2(1, 1), float2(0, 0), float2(0, 1),
+    float2(2, 1), float2(2, 2), float2(1, 1), float2(1, 2),
+    float2(2, 0), float2(2, 1), float2(1, 0), float2(1, 1)
+};
+
+float4 main(PS_INPUT input) : SV_TARGET
+{
+    int2 tile = int2(floor(input.TileCoord));
+    uint2 data = u_TileData.Load(int3(tile, 0));
+    if (data.x == 255)
+        discard;
+
+    float4 anim = u_TypeAnim[data.x];
+    float frames = max(anim.x, 1.0);
+    float frame = fmod(floor(u_Time * anim.y), frames);
+
+    // Animated types keep their frames side by side, each a full 3x3 sheet
+    float2 sheetSize = float2(frames * 3.0, 3.0);
+    float2 cell = AutotileCells[data.y & 15] + float2(frame * 3.0, 0.0);
+    float2 uv = (cell + frac(input.TileCoord)) / sheetSize;
+
+    // Gradients of the continuous coordinate so the jump between cells does not select a tiny mip
+    float2 dx = ddx(input.TileCoord) / sheetSize;
+    float2 dy = ddy(input.TileCoord) / sheetSize;
+
+    // Slot 0 is the white texture; type N samples slot N + 1
+    float4 color = SampleTexture((int)data.x + 1, u_Sampler, uv, dx, dy);
+    if (color.a < 0.01) discard;
+
+    return color;
+}
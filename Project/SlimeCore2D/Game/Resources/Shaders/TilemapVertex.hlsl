@@ -0,0 +1,22 @@
+#include "Structures.fxh"
+#include "Tilemap.fxh"
+
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float2 TileCoord : TEXCOORD0;
+};
+
+// One quad per chunk, generated from the vertex id (triangle strip, no vertex buffer)
+PS_INPUT main(uint vertexId : SV_VertexID)
+{
+    PS_INPUT output;
+
+    float2 corner = float2(vertexId & 1, vertexId >> 1);
+    float2 world = u_ChunkRect.xy + corner * u_ChunkRect.zw;
+
+    output.Pos = mul(u_ViewProjection, float4(world, u_ChunkInfo.y, 1.0));
+    output.TileCoord = corner * u_ChunkInfo.x;
+
+    return output;
+}
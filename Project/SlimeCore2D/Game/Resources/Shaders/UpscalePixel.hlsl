@@ -0,0 +1,20 @@
+cbuffer UpscaleConstants : register(b0)
+{
+    float2 u_SourceScale; // Rendered region over the whole target
+    float2 u_SourceMax;   // UV of the region's last texel centres; keeps the filter off stale texels beyond it
+};
+
+Texture2D u_Source : register(t0);
+SamplerState u_SourceSampler : register(s0);
+
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float2 UV : TEXCOORD0;
+};
+
+float4 main(PS_INPUT input) : SV_TARGET
+{
+    float2 uv = min(input.UV * u_SourceScale, u_SourceMax);
+    return float4(u_Source.Sample(u_SourceSampler, uv).rgb, 1.0);
+}
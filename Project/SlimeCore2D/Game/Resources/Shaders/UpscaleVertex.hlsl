@@ -0,0 +1,15 @@
+// Full-screen triangle from the vertex index alone, for stretching the scaled world target over the back buffer
+struct PS_INPUT
+{
+    float4 Pos : SV_POSITION;
+    float2 UV : TEXCOORD0;
+};
+
+PS_INPUT main(uint vertexID : SV_VertexID)
+{
+    PS_INPUT output;
+    float2 uv = float2((vertexID << 1) & 2, vertexID & 2);
+    output.Pos = float4(uv.x * 2.0 - 1.0, 1.0 - uv.y * 2.0, 0.0, 1.0);
+    output.UV = uv;
+    return output;
+}
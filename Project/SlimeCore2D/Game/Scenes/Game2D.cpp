@@ -3,6 +3,7 @@
 #include <iostream>
 
 #include "Core/Window.h"
+#include "Rendering/DebugDraw.h"
 #include "gtc/matrix_transform.hpp"
 #include "Scripting/DotNetHost.h"
 
@@ -29,6 +30,7 @@ Game2D::~Game2D()
 	m_scene = nullptr;
 
 	// Cleanup Singletons
+	DebugDraw::Shutdown();
 	Renderer::Shutdown();
 }
 
@@ -36,6 +38,7 @@ void Game2D::Init()
 {
 	// 1. Initialize Static Renderer
 	Renderer::Init();
+	DebugDraw::Init();
 
 	// 2. Setup Camera
 	// Adjust these values based on your desired aspect ratio / zoom
@@ -64,16 +67,19 @@ void Game2D::Update(float deltaTime)
 	}
 }
 
-void Game2D::Draw()
+void Game2D::Draw(RenderSnapshot& snapshot)
 {
 	// -----------------------------------------------------------
 	// PASS 1: WORLD RENDERING
 	// -----------------------------------------------------------
-	// Reset stats for the new frame
-	Renderer::ResetStats();
 
-	// Draw Managed World (TileMap, etc)
+	// Drawn at the dynamic resolution scale and upscaled to the back buffer
+	snapshot.BeginWorldPass();
+
+	// Draw Managed World (TileMap, etc); script draw calls record into this snapshot
+	RenderSnapshot::SetRecording(&snapshot);
 	DotNetHost::GetInstance()->CallDraw();
+	RenderSnapshot::SetRecording(nullptr);
 
 	// Render Scene Graph
 	if (m_scene)
@@ -96,9 +102,14 @@ void Game2D::Draw()
 			m_camera->SetProjection(cc.OrthographicSize, aspect);
 		}
 
-		m_scene->Render(*m_camera);
+		m_scene->Render(*m_camera, snapshot);
 	}
 
+	// Debug shapes over the world, beneath the UI
+	snapshot.DrawDebugShapes(m_camera->GetViewProjectionMatrix());
+
+	snapshot.EndWorldPass();
+
 	// -----------------------------------------------------------
 	// PASS 2: UI RENDERING
 	// -----------------------------------------------------------
@@ -111,10 +122,10 @@ void Game2D::Draw()
 		Camera uiCamera(m_camera->GetOrthographicSize(), m_camera->GetAspectRatio());
 
 		// Clear Depth Buffer for UI overlay
-		Window::GetContext()->ClearDepthStencil(Window::GetDepthStencilView(), CLEAR_DEPTH_FLAG | CLEAR_STENCIL_FLAG, 1.0f, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+		snapshot.ClearDepth();
 
-		Renderer::BeginScene(uiCamera);
-		m_scene->RenderUI(m_camera->GetOrthographicSize());
-		Renderer::EndScene();
+		snapshot.BeginScene(uiCamera.GetViewProjectionMatrix());
+		m_scene->RenderUI(snapshot, m_camera->GetOrthographicSize());
+		snapshot.EndScene();
 	}
 }
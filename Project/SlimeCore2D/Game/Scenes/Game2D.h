@@ -2,6 +2,7 @@
 #include "Core/Camera.h"
 #include "Core/Input.h"
 #include "Physics/PhysicsScene.h"
+#include "Rendering/RenderSnapshot.h"
 #include "Rendering/Renderer.h"
 #include "Scene/Scene.h"
 
@@ -14,7 +15,9 @@ public:
 	void Init();
 
 	void Update(float deltaTime);
-	void Draw();
+
+	// Records the frame into 'snapshot'; the render thread replays it
+	void Draw(RenderSnapshot& snapshot);
 
 private:
 	Input* m_inputManager = Input::GetInstance();
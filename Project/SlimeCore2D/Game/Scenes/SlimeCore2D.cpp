@@ -1,9 +1,12 @@
 #include <string>
 
 #include "Core/EngineSettings.h"
+#include "Core/JobSystem.h"
 #include "Core/Logger.h"
+#include "Core/RenderThread.h"
 #include "Core/Window.h"
 #include "Game2D.h"
+#include "Rendering/Font.h"
 #include "Resources/ResourceManager.h"
 #include "Scripting/DotNetHost.h"
 #include "Core/Memory.h"
@@ -21,11 +24,16 @@ int main(int argc, char** argv)
 		{
 			g_RendererType = RendererType::D3D12;
 		}
+		else if (arg == "--single-thread")
+		{
+			g_RenderThread = false;
+		}
 	}
 
 	MemoryAllocator::Init();
 	Logger::Init();
 	Logger::Info("Engine Initializing...");
+	JobSystem::Init();
 
 	Window* app = new Window(1536, 852, (char*) "SlimeCore2D");
 	Game2D* game = new Game2D();
@@ -40,27 +48,61 @@ int main(int argc, char** argv)
 
 	dotnet.CallInit();
 
+	// Frame N is replayed from one snapshot while frame N+1 is recorded into the other
+	RenderThread::Init(g_RenderThread);
+	RenderSnapshot snapshots[2];
+	uint32_t snapshotIndex = 0;
+
 	while (!app->Window_shouldClose())
 	{
 		inputManager->Update();
-		app->BeginFrame();
+
+		// Text shaped from here on belongs to this frame's snapshot for the font page LRU
+		Font::BeginFrame();
 
 		float dt = app->GetDeltaTime();
 
 		dotnet.CallUpdate(dt);
 
 		game->Update(dt);
-		game->Draw();
 
-		app->Update_Window();
+		RenderSnapshot* snapshot = &snapshots[snapshotIndex];
+		snapshotIndex ^= 1;
+		snapshot->Clear();
+		game->Draw(*snapshot);
+
+		// Window events may resize the swap chain, so they wait for the frame in flight
+		RenderThread::Wait();
+		app->PollEvents();
+
+		RenderThread::Submit([app, snapshot]()
+		{
+			app->BeginFrame();
+
+			// Reset stats and the vertex ring for the new frame
+			Renderer::ResetStats();
+			Renderer::BeginFrame();
+
+			snapshot->Replay();
+
+			app->Present();
+		});
 	}
 
+	RenderThread::Shutdown();
+
+	// Snapshots hold GPU buffers, which must go before the device
+	snapshots[0].Clear();
+	snapshots[1].Clear();
+
 	delete app;
 	delete game;
 
 	dotnet.CallForceGC();
 	dotnet.Shutdown();
 
+	JobSystem::Shutdown();
+
 	// Call the resource manager clean up
 	ResourceManager::GetInstance().Clear();
 	MemoryAllocator::PrintLeaks();